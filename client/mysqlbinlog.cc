@@ -248,6 +248,9 @@ bool print_annotate_event(PRINT_EVENT_INFO *print_event_info)
 static Exit_status dump_local_log_entries(PRINT_EVENT_INFO *, const char*);
 static Exit_status dump_remote_log_entries(PRINT_EVENT_INFO *, const char*);
 static Exit_status dump_log_entries(const char* logname);
+static Exit_status process_transaction_payload(PRINT_EVENT_INFO *,
+                                               Log_event *, my_off_t,
+                                               const char *);
 static Exit_status safe_connect();
 
 
@@ -1506,6 +1509,11 @@ Exit_status process_event(PRINT_EVENT_INFO *print_event_info, Log_event *ev,
         destroy_evt= FALSE;
       break;
     }
+    case TRANSACTION_PAYLOAD_EVENT:
+      if (ev->print(result_file, print_event_info))
+        goto err;
+      retval= process_transaction_payload(print_event_info, ev, pos, logname);
+      break;
     case START_ENCRYPTION_EVENT:
       glob_description_event->start_decryption((Start_encryption_log_event*)ev);
       /* fall through */
@@ -1572,6 +1580,66 @@ Exit_status process_event(PRINT_EVENT_INFO *print_event_info, Log_event *ev,
 }
 
 
+/**
+  Process the events of a Transaction_payload_log_event as if they had
+  been read one by one at the position of the payload event.
+*/
+
+static Exit_status
+process_transaction_payload(PRINT_EVENT_INFO *print_event_info, Log_event *ev,
+                            my_off_t pos, const char *logname)
+{
+  char *events, *ev_buf, *end;
+  ulong events_len;
+  const char *error_msg;
+  Exit_status retval= OK_CONTINUE;
+
+  if (transaction_payload_uncompress(glob_description_event,
+                                     glob_description_event->checksum_alg ==
+                                     BINLOG_CHECKSUM_ALG_CRC32,
+                                     ev->temp_buf,
+                                     uint4korr(ev->temp_buf + EVENT_LEN_OFFSET),
+                                     &events, &events_len))
+  {
+    error("Could not uncompress transaction payload at position %llu",
+          (ulonglong) pos);
+    return ERROR_STOP;
+  }
+
+  for (ev_buf= events, end= events + events_len;
+       ev_buf < end && retval == OK_CONTINUE; )
+  {
+    ulong len= uint4korr(ev_buf + EVENT_LEN_OFFSET);
+    char *buf;
+    Log_event *inner_ev;
+
+    if (!(buf= (char*) my_malloc(PSI_NOT_INSTRUMENTED, len + 1, MYF(MY_WME))))
+    {
+      error("Out of memory");
+      retval= ERROR_STOP;
+      break;
+    }
+    memcpy(buf, ev_buf, len);
+    buf[len]= 0;
+    if (!(inner_ev= Log_event::read_log_event(buf, len, &error_msg,
+                                              glob_description_event,
+                                              opt_verify_binlog_checksum)))
+    {
+      error("Could not construct log event object: %s", error_msg);
+      my_free(buf);
+      retval= ERROR_STOP;
+      break;
+    }
+    /* The event may be kept after process_event(), so it owns the buffer */
+    inner_ev->register_temp_buf(buf, TRUE);
+    retval= process_event(print_event_info, inner_ev, pos, logname);
+    ev_buf+= len;
+  }
+  my_free(events);
+  return retval;
+}
+
+
 static struct my_option my_options[] =
 {
   {"help", '?', "Display this help and exit.",
@@ -0,0 +1,38 @@
+# Copyright (c) 2026, MariaDB Corporation.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; version 2 of the License.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA
+
+# zstd for the compressed binary log transaction payload.
+# Sets HAVE_ZSTD, ZSTD_INCLUDE_DIR and ZSTD_LIBRARY.
+MACRO(CHECK_ZSTD)
+  SET(WITH_ZSTD "auto" CACHE STRING
+    "Compress binary log transactions with zstd (possible values are 'yes', 'no' or 'auto')")
+  IF(WITH_ZSTD STREQUAL "yes" OR WITH_ZSTD STREQUAL "auto")
+    IF(WITH_ZSTD STREQUAL "yes")
+      FIND_PACKAGE(ZSTD REQUIRED)
+    ELSE()
+      FIND_PACKAGE(ZSTD)
+    ENDIF()
+  ENDIF()
+  IF(ZSTD_FOUND AND NOT WITH_ZSTD STREQUAL "no")
+    SET(HAVE_ZSTD 1)
+    SET(ZSTD_LIBRARY ${ZSTD_LIBRARIES})
+    MESSAGE_ONCE(zstd "Binary log transaction compression with zstd enabled")
+  ELSE()
+    UNSET(HAVE_ZSTD)
+    UNSET(ZSTD_LIBRARY)
+    UNSET(ZSTD_INCLUDE_DIR)
+    MESSAGE_ONCE(zstd "Binary log transaction compression with zstd not enabled")
+  ENDIF()
+ENDMACRO()
@@ -740,6 +740,7 @@ enum options_xtrabackup
   OPT_INNODB_FILE_IO_THREADS,
   OPT_INNODB_IO_CAPACITY,
   OPT_INNODB_READ_IO_THREADS,
+  OPT_INNODB_RECOVERY_THREADS,
   OPT_INNODB_WRITE_IO_THREADS,
   OPT_INNODB_USE_NATIVE_AIO,
   OPT_INNODB_PAGE_SIZE,
@@ -1274,6 +1275,10 @@ struct my_option xb_server_options[] =
    "Number of background read I/O threads in InnoDB.", (G_PTR*) &innobase_read_io_threads,
    (G_PTR*) &innobase_read_io_threads, 0, GET_LONG, REQUIRED_ARG, 4, 1, 64, 0,
    1, 0},
+  {"innodb_recovery_threads", OPT_INNODB_RECOVERY_THREADS,
+   "Number of threads for applying the redo log in --prepare.",
+   (G_PTR*) &srv_n_recovery_threads, (G_PTR*) &srv_n_recovery_threads, 0,
+   GET_ULONG, REQUIRED_ARG, 4, 1, 64, 0, 1, 0},
   {"innodb_write_io_threads", OPT_INNODB_WRITE_IO_THREADS,
    "Number of background write I/O threads in InnoDB.", (G_PTR*) &innobase_write_io_threads,
    (G_PTR*) &innobase_write_io_threads, 0, GET_LONG, REQUIRED_ARG, 4, 1, 64, 0,
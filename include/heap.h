@@ -109,6 +109,18 @@ typedef struct st_heap_block
 
 struct st_heap_info;			/* For referense */
 
+/*
+  BLOB columns keep their length and a data pointer in the record.
+  The stored copy of the data is a chain of continuation blocks in
+  HP_SHARE::blob_block; the record stores the pointer to the first one.
+*/
+
+typedef struct st_hp_blob_desc
+{
+  uint offset;				/* Start of the column in record */
+  uint packlength;			/* Number of bytes of blob length */
+} HP_BLOB_DESC;
+
 typedef struct st_hp_keydef		/* Key definition with open */
 {
   uint flag;				/* HA_NOSAME | HA_NULL_PART_KEY */
@@ -133,13 +145,16 @@ typedef struct st_hp_keydef		/* Key definition with open */
 typedef struct st_heap_share
 {
   HP_BLOCK block;
+  HP_BLOCK blob_block;			/* Continuation blocks of blobs */
   HP_KEYDEF  *keydef;
+  HP_BLOB_DESC *blob_descs;		/* Blob columns, in record order */
   ulonglong data_length,index_length,max_table_size;
   ulonglong auto_increment;
   ulong min_records,max_records;	/* Params to open */
   ulong records;			/* records */
   ulong blength;			/* records rounded up to 2^n */
   ulong deleted;			/* Deleted records in database */
+  ulong blob_chunks;			/* Used positions in blob_block */
   uint key_stat_version;                /* version to indicate insert/delete */
   uint key_version;                     /* Updated on key change */
   uint file_version;                    /* Update on clear */
@@ -147,9 +162,11 @@ typedef struct st_heap_share
   uint visible;                         /* Offset to the visible/deleted mark */
   uint changed;
   uint keys,max_key_length;
+  uint blobs;				/* Number of blob columns */
   uint currently_disabled_keys;    /* saved value from "keys" when disabled */
   uint open_count;
   uchar *del_link;			/* Link to next block with del. rec */
+  uchar *blob_del_link;			/* Free continuation blocks */
   char * name;			/* Name of "memory-file" */
   time_t create_time;
   THR_LOCK lock;
@@ -173,6 +190,9 @@ typedef struct st_heap_info
   uint opt_flag,update;
   uchar *lastkey;			/* Last used key with rkey */
   uchar *recbuf;                         /* Record buffer for rb-tree keys */
+  uchar **blob_heads;                   /* New blob chains of write/update */
+  uchar *blob_buff;                     /* Blob data of the last read row */
+  size_t blob_buff_length;
   enum ha_rkey_function last_find_flag;
   TREE_ELEMENT *parents[MAX_TREE_HEIGHT+1];
   TREE_ELEMENT **last_pos;
@@ -188,9 +208,11 @@ typedef struct st_heap_info
 typedef struct st_heap_create_info
 {
   HP_KEYDEF *keydef;
+  HP_BLOB_DESC *blob_descs;
   uint auto_key;                        /* keynr [1 - maxkey] for auto key */
   uint auto_key_type;
   uint keys;
+  uint blobs;
   uint reclength;
   ulong max_records;
   ulong min_records;
@@ -16,45 +16,148 @@
 
 /*
   Radixsort for pointers to fixed length strings.
-  A very quick sort for not to long (< 20 char) strings.
-  Neads a extra buffers of number_of_elements pointers but is
-  2-3 times faster than quicksort
+  The strings are compared as by memcmp(), so they must be normalized
+  sort keys. Needs an extra buffer of number_of_elements pointers.
+
+  Short keys are sorted LSD (least significant byte first). The
+  histograms of all byte positions are built in a single pass over the
+  keys, and passes where all keys have the same byte are skipped, so
+  that e.g. integer keys with constant high bytes cost only a few
+  passes. The passes alternate between the two pointer arrays instead
+  of copying back after each pass.
+
+  Longer keys are sorted MSD (most significant byte first): the keys
+  are distributed into buckets on one byte, and each bucket is sorted
+  on the following bytes. Small buckets are finished by insertion sort.
 */
 
 #include "mysys_priv.h"
 #include <m_string.h>
 
+/* Longest key that is sorted LSD */
+#define RADIX_LSD_MAX_LENGTH 8
+/* Longest key for which radixsort is used at all */
+#define RADIX_MAX_LENGTH 128
+/* MSD buckets smaller than this are sorted by insertion sort */
+#define RADIX_INSERTION_SORT_LIMIT 32
+
 	/* Radixsort */
 
 my_bool radixsort_is_appliccable(uint n_items, size_t size_of_element)
 {
-  return size_of_element <= 20 && n_items >= 1000 && n_items < 100000;
+  return size_of_element <= RADIX_MAX_LENGTH && n_items >= 1000;
 }
 
-void radixsort_for_str_ptr(uchar **base, uint number_of_elements, size_t size_of_element, uchar **buffer)
+
+static void radixsort_lsd(uchar **base, uint number_of_elements,
+                          size_t size_of_element, uchar **buffer)
 {
-  uchar **end,**ptr,**buffer_ptr;
-  uint32 *count_ptr,*count_end,count[256];
-  int pass;
+  uint32 count[RADIX_LSD_MAX_LENGTH][256];
+  uchar **from= base, **to= buffer, **ptr, **end, **tmp;
+  size_t pass;
 
-  end=base+number_of_elements; count_end=count+256;
-  for (pass=(int) size_of_element-1 ; pass >= 0 ; pass--)
+  bzero((uchar*) count, sizeof(count[0]) * size_of_element);
+  end= base + number_of_elements;
+  for (ptr= base ; ptr < end ; ptr++)
   {
-    bzero((uchar*) count,sizeof(uint32)*256);
+    const uchar *key= *ptr;
+    for (pass= 0 ; pass < size_of_element ; pass++)
+      count[pass][key[pass]]++;
+  }
+
+  for (pass= size_of_element ; pass-- > 0 ;)
+  {
+    uint32 *cnt= count[pass], sum= 0, i;
+    if (cnt[from[0][pass]] == number_of_elements)
+      continue;                                 /* All keys equal here */
+    for (i= 0 ; i < 256 ; i++)
+    {
+      uint32 c= cnt[i];
+      cnt[i]= sum;
+      sum+= c;
+    }
+    end= from + number_of_elements;
+    for (ptr= from ; ptr < end ; ptr++)
+      to[cnt[ptr[0][pass]]++]= *ptr;
+    tmp= from; from= to; to= tmp;
+  }
+  if (from != base)
+    memcpy(base, from, number_of_elements * sizeof(uchar*));
+}
+
+
+/*
+  Sort base..end on the bytes depth..size-1.
+  count is scratch space of 256 entries; it is not used across the
+  recursive calls, which keeps the recursion depth (at most size)
+  cheap on the stack.
+*/
+
+static void radixsort_msd(uchar **base, uchar **end, size_t depth,
+                          size_t size, uchar **buffer, uint32 *count)
+{
+  uchar **ptr, **next;
+
+  while (end - base >= RADIX_INSERTION_SORT_LIMIT)
+  {
+    uint32 sum= 0, i, n= (uint32) (end - base);
+    if (depth == size)
+      return;
+    bzero((uchar*) count, sizeof(uint32) * 256);
     for (ptr= base ; ptr < end ; ptr++)
-      count[ptr[0][pass]]++;
-    if (count[0] == number_of_elements)
-      goto next;
-    for (count_ptr=count+1 ; count_ptr < count_end ; count_ptr++)
+      count[ptr[0][depth]]++;
+    if (count[base[0][depth]] == n)
     {
-      if (*count_ptr == number_of_elements)
-	goto next;
-      (*count_ptr)+= *(count_ptr-1);
+      depth++;                                  /* All keys equal here */
+      continue;
     }
-    for (ptr= end ; ptr-- != base ;)
-      buffer[--count[ptr[0][pass]]]= *ptr;
-    for (ptr=base, buffer_ptr=buffer ; ptr < end ;)
-      (*ptr++) = *buffer_ptr++;
-  next:;
+    for (i= 0 ; i < 256 ; i++)
+    {
+      uint32 c= count[i];
+      count[i]= sum;
+      sum+= c;
+    }
+    for (ptr= base ; ptr < end ; ptr++)
+      buffer[count[ptr[0][depth]]++]= *ptr;
+    memcpy(base, buffer, n * sizeof(uchar*));
+
+    /* Sort each bucket on the next byte; the last one by this loop */
+    for (ptr= base ;; ptr= next)
+    {
+      uchar c= ptr[0][depth];
+      for (next= ptr + 1 ; next < end && next[0][depth] == c ; next++) ;
+      if (next == end)
+        break;
+      radixsort_msd(ptr, next, depth + 1, size, buffer, count);
+    }
+    base= ptr;
+    depth++;
   }
+
+  if (depth >= size)
+    return;
+  for (ptr= base + 1 ; ptr < end ; ptr++)
+  {
+    uchar *key= *ptr;
+    for (next= ptr ;
+         next > base && memcmp(next[-1] + depth, key + depth,
+                               size - depth) > 0 ;
+         next--)
+      next[0]= next[-1];
+    next[0]= key;
+  }
+}
+
+
+void radixsort_for_str_ptr(uchar **base, uint number_of_elements, size_t size_of_element, uchar **buffer)
+{
+  uint32 count[256];
+
+  if (number_of_elements < 2 || !size_of_element)
+    return;
+  if (size_of_element <= RADIX_LSD_MAX_LENGTH)
+    radixsort_lsd(base, number_of_elements, size_of_element, buffer);
+  else
+    radixsort_msd(base, base + number_of_elements, 0, size_of_element,
+                  buffer, count);
 }
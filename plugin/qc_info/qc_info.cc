@@ -48,7 +48,7 @@ class Accessible_Query_Cache : public Query_cache {
   {
     return &this->queries;
   }
-} *qc;
+};
 
 bool schema_table_store_record(THD *thd, TABLE *table);
 
@@ -117,18 +117,14 @@ static ST_FIELD_INFO qc_info_fields[]=
 
 static const char unknown[]= "#UNKNOWN#";
 
-static int qc_info_fill_table(THD *thd, TABLE_LIST *tables,
-                                              COND *cond)
+/* Store the queries of one query cache partition */
+static int qc_info_fill_partition(THD *thd, TABLE *table,
+                                  Accessible_Query_Cache *qc)
 {
   int status= 1;
   CHARSET_INFO *scs= system_charset_info;
-  TABLE *table= tables->table;
   HASH *queries = qc->get_queries();
 
-  /* one must have PROCESS privilege to see others' queries */
-  if (check_global_access(thd, PROCESS_ACL, true))
-    return 0;
-
   if (qc->try_lock(thd))
     return 0; // QC is or is being disabled
 
@@ -277,15 +273,32 @@ static int qc_info_fill_table(THD *thd, TABLE_LIST *tables,
   return status;
 }
 
+static int qc_info_fill_table(THD *thd, TABLE_LIST *tables,
+                                              COND *cond)
+{
+  /* one must have PROCESS privilege to see others' queries */
+  if (check_global_access(thd, PROCESS_ACL, true))
+    return 0;
+
+  /* Lock and list each partition (query_cache_partitions) in turn */
+  for (uint i= 0; i < query_cache.get_partition_count(); i++)
+  {
+    Accessible_Query_Cache *qc=
+      (Accessible_Query_Cache *) query_cache.get_partition_at(i);
+    if (qc_info_fill_partition(thd, tables->table, qc))
+      return 1;
+  }
+  return 0;
+}
+
 static int qc_info_plugin_init(void *p)
 {
   ST_SCHEMA_TABLE *schema= (ST_SCHEMA_TABLE *)p;
 
   schema->fields_info= Show::qc_info_fields;
   schema->fill_table= qc_info_fill_table;
-  qc = (Accessible_Query_Cache *)&query_cache;
 
-  return qc == 0;
+  return 0;
 }
 
 
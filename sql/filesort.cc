@@ -35,6 +35,7 @@
 #include "filesort_utils.h"
 #include "sql_select.h"
 #include "debug_sync.h"
+#include <tpool.h>
 
 	/* functions defined in this file */
 
@@ -67,6 +68,106 @@ static bool check_if_pq_applicable(Sort_param *param, SORT_INFO *info,
                                    TABLE *table,
                                    ha_rows records, size_t memory_available);
 
+/* Smallest number of keys that is worth sorting in a separate thread */
+#define MIN_SORT_THREAD_KEYS 8192
+
+/** Threads for parallel filesort, created on first use */
+static std::atomic<tpool::thread_pool*> filesort_thread_pool;
+static std::mutex filesort_thread_pool_mutex;
+
+static void filesort_thread_init()
+{
+  my_thread_init();
+}
+
+static void filesort_thread_end()
+{
+  my_thread_end();
+}
+
+static tpool::thread_pool *get_filesort_thread_pool()
+{
+  tpool::thread_pool *pool=
+    filesort_thread_pool.load(std::memory_order_acquire);
+  if (likely(pool != NULL))
+    return pool;
+
+  std::lock_guard<std::mutex> lk(filesort_thread_pool_mutex);
+  if (!(pool= filesort_thread_pool.load(std::memory_order_relaxed)))
+  {
+#ifdef _WIN32
+    pool= tpool::create_thread_pool_win();
+#else
+    pool= tpool::create_thread_pool_generic();
+#endif
+    pool->set_thread_callbacks(filesort_thread_init, filesort_thread_end);
+    filesort_thread_pool.store(pool, std::memory_order_release);
+  }
+  return pool;
+}
+
+
+void filesort_thread_pool_end()
+{
+  delete filesort_thread_pool.load(std::memory_order_relaxed);
+  filesort_thread_pool.store(NULL, std::memory_order_relaxed);
+}
+
+
+/**
+  Tasks that a connection thread runs in the filesort thread pool.
+  The worker threads have no THD, so they must not report errors or
+  touch the status of the connection; wait() returns the first error
+  that a task reported.
+*/
+
+class Filesort_workers
+{
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  uint m_running;
+  int m_errno;
+
+public:
+  Filesort_workers() : m_running(0), m_errno(0) {}
+
+  void submit(tpool::task *task)
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_running++;
+    }
+    get_filesort_thread_pool()->submit_task(task);
+  }
+
+  /** Called by a task when it is done. @param err 0, or my_errno */
+  void done(int err)
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (err && !m_errno)
+      m_errno= err;
+    if (!--m_running)
+      m_cv.notify_one();
+  }
+
+  /** Whether a task has failed, and the remaining work can be skipped */
+  bool failed()
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_errno != 0;
+  }
+
+  /** Wait for all submitted tasks. @return 0, or the error of a task */
+  int wait()
+  {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    while (m_running)
+      m_cv.wait(lk);
+    return m_errno;
+  }
+};
+
+
 static void store_key_part_length(uint32 num, uchar *to, uint bytes)
 {
   switch(bytes) {
@@ -205,6 +306,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
   ha_rows max_rows= filesort->limit;
   uint s_length= 0;
   Sort_keys *sort_keys;
+  ulonglong phase_start;
 
   DBUG_ENTER("filesort");
 
@@ -253,6 +355,8 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
 
   param.set_all_read_bits= filesort->set_all_read_bits;
   param.unpack= filesort->unpack;
+  param.max_threads= thd->variables.max_sort_threads;
+  param.tracker= tracker;
 
   sort->addon_fields=  param.addon_fields;
   sort->sort_keys= param.sort_keys;
@@ -352,12 +456,14 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
   param.local_sortorder=
     Bounds_checked_array<SORT_FIELD>(filesort->sortorder, s_length);
 
+  phase_start= tracker->start_phase();
   num_rows= find_all_keys(thd, &param, select,
                           sort,
                           &buffpek_pointers,
                           &tempfile, 
                           pq.is_initialized() ? &pq : NULL,
                           &sort->found_rows);
+  tracker->end_phase(Filesort_tracker::READ_PHASE, phase_start);
   if (num_rows == HA_POS_ERROR)
     goto err;
 
@@ -413,6 +519,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
     set_if_bigger(param.max_keys_per_buffer, 1);
     maxbuffer--;				// Offset from 0
 
+    phase_start= tracker->start_phase();
     if (merge_many_buff(&param, sort->get_raw_buf(),
                         buffpek,&maxbuffer,
 	                      &tempfile))
@@ -427,6 +534,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
                     &tempfile,
                     outfile))
       goto err;
+    tracker->end_phase(Filesort_tracker::MERGE_PHASE, phase_start);
   }
 
   if (num_rows > param.max_rows)
@@ -1019,6 +1127,65 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
 } /* find_all_keys */
 
 
+/** Sorting of a part of the sort buffer in the filesort thread pool */
+
+struct Sort_task
+{
+  tpool::task task;
+  Filesort_workers *workers;
+  const Sort_param *param;
+  uchar **keys;
+  uint count;
+};
+
+static void sort_task(void *arg)
+{
+  Sort_task *t= static_cast<Sort_task*>(arg);
+  Filesort_buffer::sort_keys(t->param, t->keys, t->count, MYF(0));
+  t->workers->done(0);
+}
+
+
+/**
+  Sort the buffer in parts, each part in its own thread.
+
+  @param param     Sort parameters
+  @param fs_info   Contains the buffer to be sorted
+  @param count     Number of keys in the buffer
+  @param parts     Number of parts
+
+  Part i consists of the keys get_sorted_record(i*count/parts) up to
+  get_sorted_record((i+1)*count/parts - 1).
+*/
+
+static void sort_buffer_parts(Sort_param *param, SORT_INFO *fs_info,
+                              uint count, uint parts)
+{
+  Filesort_workers workers;
+  Sort_task tasks[MAX_SORT_THREADS];
+  uchar **keys= fs_info->prepare_sort(param);
+
+  DBUG_ASSERT(parts <= MAX_SORT_THREADS);
+  for (uint i= 0; i < parts; i++)
+  {
+    Sort_task *t= &tasks[i];
+    t->task= tpool::task(sort_task, t);
+    t->workers= &workers;
+    t->param= param;
+    t->keys= keys + ulonglong(count) * i / parts;
+    t->count= uint(ulonglong(count) * (i + 1) / parts -
+                   ulonglong(count) * i / parts);
+    if (i + 1 < parts)
+      workers.submit(&t->task);
+  }
+  /* The connection thread sorts the last part itself */
+  Filesort_buffer::sort_keys(param, tasks[parts - 1].keys,
+                             tasks[parts - 1].count, MYF(MY_THREAD_SPECIFIC));
+  workers.wait();
+  status_var_add(current_thd->status_var.filesort_parallel_chunks_, parts);
+}
+
+
 /**
   @details
   Sort the buffer and write:
@@ -1027,6 +1194,10 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
 
     (was: Skriver en buffert med nycklar till filen)
 
+  If the buffer is large and param->max_threads allows it, the buffer
+  is sorted in parts by several threads, and each part is written as a
+  separate sorted sequence.
+
   @param param             Sort parameters
   @param sort_keys         Array of pointers to keys to sort
   @param count             Number of elements in sort_keys array
@@ -1046,34 +1217,54 @@ write_keys(Sort_param *param,  SORT_INFO *fs_info, uint count,
            IO_CACHE *buffpek_pointers, IO_CACHE *tempfile)
 {
   Merge_chunk buffpek;
+  uint parts= 1;
   DBUG_ENTER("write_keys");
 
-  fs_info->sort_buffer(param, count);
+  if (param->max_threads > 1 && param->sort_length)
+    parts= MY_MIN(param->max_threads, count / MIN_SORT_THREAD_KEYS);
+
+  ulonglong start= param->tracker ? param->tracker->start_phase() : 0;
+  if (parts > 1)
+    sort_buffer_parts(param, fs_info, count, parts);
+  else
+  {
+    parts= 1;
+    fs_info->sort_buffer(param, count);
+  }
+  if (param->tracker)
+    param->tracker->end_sort_phase(start);
 
   if (!my_b_inited(tempfile) &&
       open_cached_file(tempfile, mysql_tmpdir, TEMP_PREFIX, DISK_BUFFER_SIZE,
                        MYF(MY_WME)))
     DBUG_RETURN(1);                                /* purecov: inspected */
-  /* check we won't have more buffpeks than we can possibly keep in memory */
-  if (my_b_tell(buffpek_pointers) + sizeof(Merge_chunk) > (ulonglong)UINT_MAX)
-    DBUG_RETURN(1);
 
-  buffpek.set_file_position(my_b_tell(tempfile));
-  if ((ha_rows) count > param->max_rows)
-    count=(uint) param->max_rows;               /* purecov: inspected */
-  buffpek.set_rowcount(static_cast<ha_rows>(count));
-
-  for (uint ix= 0; ix < count; ++ix)
+  for (uint part= 0; part < parts; part++)
   {
-    uchar *record= fs_info->get_sorted_record(ix);
+    uint first= uint(ulonglong(count) * part / parts);
+    uint end= uint(ulonglong(count) * (part + 1) / parts);
 
+    /* check we won't have more buffpeks than we can possibly keep in memory */
+    if (my_b_tell(buffpek_pointers) + sizeof(Merge_chunk) > (ulonglong)UINT_MAX)
+      DBUG_RETURN(1);
 
-    if (my_b_write(tempfile, record, param->get_record_length(record)))
-      DBUG_RETURN(1);                           /* purecov: inspected */
-  }
+    buffpek.set_file_position(my_b_tell(tempfile));
+    if ((ha_rows) (end - first) > param->max_rows)
+      end= first + (uint) param->max_rows;       /* purecov: inspected */
+    buffpek.set_rowcount(static_cast<ha_rows>(end - first));
+
+    for (uint ix= first; ix < end; ++ix)
+    {
+      uchar *record= fs_info->get_sorted_record(ix);
 
-  if (my_b_write(buffpek_pointers, (uchar*) &buffpek, sizeof(buffpek)))
-    DBUG_RETURN(1);
+
+      if (my_b_write(tempfile, record, param->get_record_length(record)))
+        DBUG_RETURN(1);                           /* purecov: inspected */
+    }
+
+    if (my_b_write(buffpek_pointers, (uchar*) &buffpek, sizeof(buffpek)))
+      DBUG_RETURN(1);
+  }
 
   DBUG_RETURN(0);
 
@@ -1615,12 +1806,206 @@ static bool check_if_pq_applicable(Sort_param *param,
 }
 
 
+/** A merge of buffpek[first..last] in a merge pass */
+
+struct Merge_job
+{
+  uint first, last;
+  my_off_t start;                               // Output file position
+  my_off_t end;                                 // End of the output
+  Merge_chunk result;
+};
+
+
+/** A thread that runs the Merge_jobs of a merge pass */
+
+struct Merge_worker
+{
+  tpool::task task;
+  Filesort_workers *workers;
+  THD *thd;
+  Sort_param *param;
+  IO_CACHE *from_file;
+  File to_file;
+  Sort_buffer sort_buffer;
+  Merge_chunk *buffpek;
+  Merge_job *jobs;
+  uint n_jobs;
+  std::atomic<uint> *next_job;
+  /** Whether writing to to_file failed (otherwise, reading failed) */
+  bool write_failed;
+};
+
+
+/**
+  write_function of the IO_CACHE of a Merge_worker. The workers share the
+  file descriptor, so they must write with pwrite() instead of seek()
+  and write().
+*/
+
+static int merge_worker_write(IO_CACHE *info, const uchar *buffer,
+                              size_t count)
+{
+  if (mysql_file_pwrite(info->file, buffer, count, info->pos_in_file,
+                        info->myflags | MY_NABP))
+    return info->error= -1;
+  info->pos_in_file+= count;
+  return 0;
+}
+
+
+static void merge_worker(void *arg)
+{
+  Merge_worker *w= static_cast<Merge_worker*>(arg);
+  IO_CACHE to_file;
+  bool error= false;
+
+  for (uint i; !error && (i= w->next_job->fetch_add(1)) < w->n_jobs; )
+  {
+    if (w->thd->killed || w->workers->failed())
+      break;
+    Merge_job *job= &w->jobs[i];
+    if (init_io_cache(&to_file, w->to_file, DISK_BUFFER_SIZE, WRITE_CACHE,
+                      job->start, 0, MYF(0)))
+    {
+      error= true;
+      break;
+    }
+    to_file.write_function= merge_worker_write;
+    error= merge_buffers(w->param, w->from_file, &to_file, w->sort_buffer,
+                         &job->result, w->buffpek + job->first,
+                         w->buffpek + job->last, 0);
+    job->end= my_b_tell(&to_file);
+    if (to_file.error)
+      w->write_failed= true;
+    if (end_io_cache(&to_file))
+      error= w->write_failed= true;
+  }
+  w->workers->done(error ? (my_errno ? my_errno : EIO) : 0);
+}
+
+
+/**
+  Do one pass of merge_many_buff() with several threads.
+
+  The merges of the pass are independent of each other. Each merge
+  writes its output to the same position of to_file where its input
+  starts in from_file, so that the merges can write without
+  coordination. The output of a merge is never longer than its input.
+
+  @param param        Sort parameters
+  @param sort_buffer  Buffer that is split between the threads
+  @param buffpek      The sorted runs in from_file. On return, the runs
+                      in to_file.
+  @param maxbuffer    The last element of buffpek
+  @param from_file    File to read the runs from
+  @param to_file      File to write the merged runs to
+  @param threads      Number of threads to use
+  @param n_runs [out] Number of runs written to to_file
+
+  @retval 0 OK
+  @retval 1 Error
+*/
+
+static bool merge_pass_parallel(Sort_param *param, Sort_buffer sort_buffer,
+                                Merge_chunk *buffpek, uint maxbuffer,
+                                IO_CACHE *from_file, IO_CACHE *to_file,
+                                uint threads, uint *n_runs)
+{
+  THD *thd= current_thd;
+  Filesort_workers workers;
+  Merge_worker worker[MAX_SORT_THREADS];
+  std::atomic<uint> next_job(0);
+  Merge_job *jobs;
+  uint i, n_jobs= 0;
+  int err;
+  my_off_t end= 0;
+  const uint save_max_keys= param->max_keys_per_buffer;
+  const size_t slice= sort_buffer.size() / threads;
+  DBUG_ENTER("merge_pass_parallel");
+  DBUG_ASSERT(threads > 1 && threads <= MAX_SORT_THREADS);
+
+  if (!(jobs= (Merge_job*) my_malloc(PSI_INSTRUMENT_ME,
+                                     (maxbuffer / MERGEBUFF + 1) *
+                                     sizeof(*jobs),
+                                     MYF(MY_WME | MY_THREAD_SPECIFIC))))
+    DBUG_RETURN(1);
+
+  /* The same grouping of the runs as in merge_many_buff() */
+  for (i=0 ; i <= maxbuffer-MERGEBUFF*3/2 ; i+=MERGEBUFF)
+  {
+    jobs[n_jobs].first= i;
+    jobs[n_jobs++].last= i + MERGEBUFF - 1;
+  }
+  jobs[n_jobs].first= i;
+  jobs[n_jobs++].last= maxbuffer;
+  for (i= 0; i < n_jobs; i++)
+    jobs[i].start= buffpek[jobs[i].first].file_position();
+
+  if (to_file->file < 0 && real_open_cached_file(to_file))
+  {
+    my_free(jobs);
+    DBUG_RETURN(1);
+  }
+
+  /* Each thread merges with its own part of the sort buffer */
+  param->max_keys_per_buffer= (uint) (slice / param->rec_length);
+  for (i= 0; i < threads; i++)
+  {
+    Merge_worker *w= &worker[i];
+    w->task= tpool::task(merge_worker, w);
+    w->workers= &workers;
+    w->thd= thd;
+    w->param= param;
+    w->from_file= from_file;
+    w->to_file= to_file->file;
+    w->sort_buffer= Sort_buffer(sort_buffer.array() + i * slice, slice);
+    w->buffpek= buffpek;
+    w->jobs= jobs;
+    w->n_jobs= n_jobs;
+    w->next_job= &next_job;
+    w->write_failed= false;
+    workers.submit(&w->task);
+  }
+  err= workers.wait();
+  param->max_keys_per_buffer= save_max_keys;
+
+  if (thd->check_killed())
+    err= -1;
+  else if (err)
+  {
+    bool write_failed= false;
+    for (i= 0; i < threads; i++)
+      write_failed|= worker[i].write_failed;
+    if (write_failed)
+      my_error(ER_ERROR_ON_WRITE, MYF(0), my_filename(to_file->file), err);
+    else
+      my_error(ER_ERROR_ON_READ, MYF(0), my_filename(from_file->file), err);
+  }
+  else
+  {
+    for (i= 0; i < n_jobs; i++)
+    {
+      buffpek[i]= jobs[i].result;
+      set_if_bigger(end, jobs[i].end);
+      thd->inc_status_sort_merge_passes();
+    }
+    thd->query_plan_fsort_passes+= n_jobs;
+    /* Continue writing, and reading in the next pass, after the merges */
+    err= reinit_io_cache(to_file, WRITE_CACHE, end, 0, 0);
+  }
+  my_free(jobs);
+  *n_runs= n_jobs;
+  DBUG_RETURN(err != 0);
+}
+
+
 /** Merge buffers to make < MERGEBUFF2 buffers. */
 
 int merge_many_buff(Sort_param *param, Sort_buffer sort_buffer,
                     Merge_chunk *buffpek, uint *maxbuffer, IO_CACHE *t_file)
 {
-  uint i;
+  uint i, threads= 1;
   IO_CACHE t_file2,*from_file,*to_file,*temp;
   Merge_chunk *lastbuff;
   DBUG_ENTER("merge_many_buff");
@@ -1632,6 +2017,17 @@ int merge_many_buff(Sort_param *param, Sort_buffer sort_buffer,
 			MYF(MY_WME)))
     DBUG_RETURN(1);				/* purecov: inspected */
 
+  /*
+    Merge in parallel if allowed. The workers access the temporary files
+    directly, which does not work with encrypted temporary files.
+    Every thread needs room for at least MERGEBUFF2 records.
+  */
+  if (param->max_threads > 1 && !param->unique_buff &&
+      !(t_file->myflags & MY_ENCRYPT))
+    threads= (uint) MY_MIN(param->max_threads,
+                           sort_buffer.size() /
+                           (MERGEBUFF2 * param->rec_length));
+
   from_file= t_file ; to_file= &t_file2;
   while (*maxbuffer >= MERGEBUFF2)
   {
@@ -1639,16 +2035,29 @@ int merge_many_buff(Sort_param *param, Sort_buffer sort_buffer,
       goto cleanup;
     if (reinit_io_cache(to_file,WRITE_CACHE,0L,0,0))
       goto cleanup;
-    lastbuff=buffpek;
-    for (i=0 ; i <= *maxbuffer-MERGEBUFF*3/2 ; i+=MERGEBUFF)
+    if (threads > 1)
+    {
+      uint n_runs;
+      if (merge_pass_parallel(param, sort_buffer, buffpek, *maxbuffer,
+                              from_file, to_file,
+                              MY_MIN(threads, *maxbuffer / MERGEBUFF + 1),
+                              &n_runs))
+        break;
+      lastbuff= buffpek + n_runs;
+    }
+    else
     {
+      lastbuff=buffpek;
+      for (i=0 ; i <= *maxbuffer-MERGEBUFF*3/2 ; i+=MERGEBUFF)
+      {
+        if (merge_buffers(param,from_file,to_file,sort_buffer, lastbuff++,
+                          buffpek+i,buffpek+i+MERGEBUFF-1,0))
+        goto cleanup;
+      }
       if (merge_buffers(param,from_file,to_file,sort_buffer, lastbuff++,
-			buffpek+i,buffpek+i+MERGEBUFF-1,0))
-      goto cleanup;
+                        buffpek+i,buffpek+ *maxbuffer,0))
+        break;					/* purecov: inspected */
     }
-    if (merge_buffers(param,from_file,to_file,sort_buffer, lastbuff++,
-		      buffpek+i,buffpek+ *maxbuffer,0))
-      break;					/* purecov: inspected */
     if (flush_io_cache(to_file))
       break;					/* purecov: inspected */
     temp=from_file; from_file=to_file; to_file=temp;
@@ -1819,12 +2228,19 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
   element_count dupl_count= 0;
   uchar *src;
   uchar *unique_buff= param->unique_buff;
-  const bool killable= !param->not_killable;
+  /*
+    In the filesort thread pool there is no THD; the connection thread
+    accounts for the merges of its workers, and checks for KILL.
+  */
   THD* const thd=current_thd;
+  const bool killable= !param->not_killable && thd;
   DBUG_ENTER("merge_buffers");
 
-  thd->inc_status_sort_merge_passes();
-  thd->query_plan_fsort_passes++;
+  if (thd)
+  {
+    thd->inc_status_sort_merge_passes();
+    thd->query_plan_fsort_passes++;
+  }
 
   rec_length= param->rec_length;
   res_length= param->res_length;
@@ -161,6 +161,9 @@ class SORT_INFO
   void sort_buffer(Sort_param *param, uint count)
   { filesort_buffer.sort_buffer(param, count); }
 
+  uchar **prepare_sort(Sort_param *param)
+  { return filesort_buffer.prepare_sort(param); }
+
   uchar **get_sort_keys()
   { return filesort_buffer.get_sort_keys(); }
 
@@ -234,6 +237,8 @@ bool filesort_use_addons(TABLE *table, uint sortlength,
                          uint *length, uint *fields, uint *null_fields,
                          uint *m_packable_length);
 
+void filesort_thread_pool_end();
+
 void change_double_for_sort(double nr,uchar *to);
 void store_length(uchar *to, uint length, uint pack_length);
 void
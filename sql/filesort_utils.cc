@@ -161,28 +161,44 @@ void Filesort_buffer::free_sort_buffer()
 
 void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
-  size_t size= param->sort_length;
   m_sort_keys= get_sort_keys();
 
-  if (count <= 1 || size == 0)
+  if (count <= 1 || param->sort_length == 0)
     return;
 
+  sort_keys(param, prepare_sort(param), count, MYF(MY_THREAD_SPECIFIC));
+}
+
+
+uchar **Filesort_buffer::prepare_sort(const Sort_param *param)
+{
   // don't reverse for PQ, it is already done
   if (!param->using_pq)
     reverse_record_pointers();
+  return m_sort_keys= get_sort_keys();
+}
+
+
+void Filesort_buffer::sort_keys(const Sort_param *param, uchar **keys,
+                                uint count, myf malloc_flags)
+{
+  size_t size= param->sort_length;
+
+  if (count <= 1 || size == 0)
+    return;
 
   uchar **buffer= NULL;
   if (!param->using_packed_sortkeys() &&
       radixsort_is_appliccable(count, param->sort_length) &&
       (buffer= (uchar**) my_malloc(PSI_INSTRUMENT_ME, count*sizeof(char*),
-                                   MYF(MY_THREAD_SPECIFIC))))
+                                   MYF(malloc_flags))))
   {
-    radixsort_for_str_ptr(m_sort_keys, count, param->sort_length, buffer);
+    radixsort_for_str_ptr(keys, count, param->sort_length, buffer);
     my_free(buffer);
     return;
   }
 
-  my_qsort2(m_sort_keys, count, sizeof(uchar*),
+  my_qsort2(keys, count, sizeof(uchar*),
             param->get_compare_function(),
             param->get_compare_argument(&size));
 }
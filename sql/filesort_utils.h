@@ -84,6 +84,25 @@ class Filesort_buffer
   /** Sort me... */
   void sort_buffer(const Sort_param *param, uint count);
 
+  /**
+    Prepares the record pointers for sorting, like sort_buffer() does,
+    but does not sort them. The caller sorts the keys with sort_keys(),
+    possibly splitting them into parts that are sorted in parallel.
+    @returns the array of pointers to the keys. @see get_sort_keys()
+  */
+  uchar **prepare_sort(const Sort_param *param);
+
+  /**
+    Sorts an array of pointers to keys.
+    @param param        Sort parameters
+    @param keys         The array to sort
+    @param count        Number of elements in the array
+    @param malloc_flags MY_THREAD_SPECIFIC when called by the connection
+                        thread, 0 when called by a thread without THD
+  */
+  static void sort_keys(const Sort_param *param, uchar **keys, uint count,
+                        myf malloc_flags);
+
   /**
     Reverses the record pointer array, to avoid recording new results for
     non-deterministic mtr tests.
@@ -0,0 +1,353 @@
+/* Copyright (c) 2021, MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/*
+  The binlog GTID index file.
+
+  The file starts with a header of GTID_INDEX_HEADER_LEN bytes: the magic
+  number and a version byte. Then come the entries, each one
+
+    4 bytes   length of the rest of the entry
+    8 bytes   file offset of the GTID event in the binlog file
+    4 bytes   number of domains
+    for each domain:
+      4 bytes   domain_id
+      4 bytes   server_id of the last GTID
+      8 bytes   seq_no of the last GTID
+      8 bytes   highest seq_no
+    4 bytes   checksum of the entry from the file offset on
+
+  All numbers are stored little-endian.
+*/
+
+#include "mariadb.h"
+#include "sql_priv.h"
+#include "unireg.h"
+#include "sql_class.h"
+#include "gtid_index.h"
+
+static const uchar gtid_index_magic[]= { 0xfe, 'G', 'I', 'X' };
+#define GTID_INDEX_VERSION 1
+#define GTID_INDEX_HEADER_LEN 8
+#define GTID_INDEX_DOMAIN_LEN 24
+/* Length of an entry without the domains and the length field */
+#define GTID_INDEX_ENTRY_LEN (8 + 4 + 4)
+/* Sanity limit on the number of domains of an entry */
+#define GTID_INDEX_MAX_DOMAINS 65536
+
+
+static void gtid_index_file_name(char *buf, const char *binlog_name)
+{
+  strxnmov(buf, FN_REFLEN - 1, binlog_name, GTID_INDEX_EXT, NullS);
+}
+
+
+Gtid_index_writer::Gtid_index_writer(): file(-1), last_offset(0)
+{
+  my_init_dynamic_array(PSI_INSTRUMENT_ME, &domains, sizeof(domain_state),
+                        0, 8, MYF(0));
+}
+
+
+Gtid_index_writer::~Gtid_index_writer()
+{
+  close();
+}
+
+
+/*
+  Create the index of the new binlog file 'binlog_name'
+
+  RETURN
+    false  OK
+    true   Error, the binlog file has no index
+*/
+
+bool Gtid_index_writer::open(const char *binlog_name)
+{
+  char name[FN_REFLEN];
+  uchar header[GTID_INDEX_HEADER_LEN];
+  DBUG_ENTER("Gtid_index_writer::open");
+
+  close();
+  last_offset= 0;
+
+  gtid_index_file_name(name, binlog_name);
+  if ((file= mysql_file_open(key_file_binlog_gtid_index, name,
+                             O_WRONLY | O_CREAT | O_TRUNC | O_BINARY,
+                             MYF(0))) < 0)
+    DBUG_RETURN(true);
+
+  bzero(header, sizeof(header));
+  memcpy(header, gtid_index_magic, sizeof(gtid_index_magic));
+  header[sizeof(gtid_index_magic)]= GTID_INDEX_VERSION;
+  if (mysql_file_write(file, header, sizeof(header), MYF(MY_NABP)))
+  {
+    close();
+    DBUG_RETURN(true);
+  }
+  DBUG_RETURN(false);
+}
+
+
+void Gtid_index_writer::close()
+{
+  if (file >= 0)
+  {
+    mysql_file_close(file, MYF(0));
+    file= -1;
+  }
+  delete_dynamic(&domains);
+}
+
+
+/*
+  Account for the GTID event of 'gtid', which is about to be written at
+  'offset' of the binlog file.
+
+  NOTE
+    Called with LOCK_log held, in binlog order.
+*/
+
+void Gtid_index_writer::add(const rpl_gtid *gtid, my_off_t offset)
+{
+  domain_state *d, *end;
+
+  if (file < 0)
+    return;
+
+  if (offset - last_offset >= opt_binlog_gtid_index_span_min &&
+      domains.elements)
+  {
+    if (write_entry(offset))
+    {
+      /* What is written so far can still be used */
+      close();
+      return;
+    }
+    last_offset= offset;
+  }
+
+  d= dynamic_element(&domains, 0, domain_state *);
+  for (end= d + domains.elements; d < end; d++)
+  {
+    if (d->last.domain_id == gtid->domain_id)
+      break;
+  }
+  if (d == end)
+  {
+    if (!(d= (domain_state *) alloc_dynamic(&domains)))
+    {
+      close();
+      return;
+    }
+    d->max_seq_no= 0;
+  }
+  d->last= *gtid;
+  set_if_bigger(d->max_seq_no, gtid->seq_no);
+}
+
+
+bool Gtid_index_writer::write_entry(my_off_t offset)
+{
+  size_t length= 4 + GTID_INDEX_ENTRY_LEN +
+                 domains.elements * GTID_INDEX_DOMAIN_LEN;
+  uchar *buf, *p;
+  domain_state *d, *end;
+  bool res;
+
+  if (!(buf= (uchar *) my_malloc(PSI_INSTRUMENT_ME, length, MYF(0))))
+    return true;
+  int4store(buf, (uint32) (length - 4));
+  int8store(buf + 4, (ulonglong) offset);
+  int4store(buf + 12, domains.elements);
+  p= buf + 16;
+  d= dynamic_element(&domains, 0, domain_state *);
+  for (end= d + domains.elements; d < end; d++)
+  {
+    int4store(p, d->last.domain_id);
+    int4store(p + 4, d->last.server_id);
+    int8store(p + 8, d->last.seq_no);
+    int8store(p + 16, d->max_seq_no);
+    p+= GTID_INDEX_DOMAIN_LEN;
+  }
+  int4store(p, my_checksum(0, buf + 4, p - (buf + 4)));
+  res= MY_TEST(mysql_file_write(file, buf, length, MYF(MY_NABP)));
+  my_free(buf);
+  return res;
+}
+
+
+/*
+  Check if the event groups before an index entry all come before the slave
+  position 'state', so that the dump thread can skip them.
+
+  Every domain of the entry must be in 'state', and every GTID of the domain
+  before the entry must have a smaller seq_no than the slave position in
+  the domain, except that the last one may be the slave position itself.
+*/
+
+static bool gtid_index_entry_usable(const uchar *domain, uint32 count,
+                                    slave_connection_state *state)
+{
+  for (; count--; domain+= GTID_INDEX_DOMAIN_LEN)
+  {
+    slave_connection_state::entry *e= state->find_entry(uint4korr(domain));
+    uint64 max_seq_no= uint8korr(domain + 16);
+
+    if (!e || (e->flags & slave_connection_state::START_ON_EMPTY_DOMAIN))
+      return false;
+    if (max_seq_no < e->gtid.seq_no)
+      continue;
+    if (max_seq_no == e->gtid.seq_no &&
+        uint4korr(domain + 4) == e->gtid.server_id &&
+        uint8korr(domain + 8) == e->gtid.seq_no)
+      continue;
+    return false;
+  }
+  return true;
+}
+
+
+/*
+  Find where to start sending binlog file 'binlog_name' to a slave
+
+  SYNOPSIS
+    gtid_index_find_start_pos()
+    binlog_name         Binlog file
+    max_pos             End of the part of the binlog file that can be read
+    state       IN/OUT  Slave position. Domains in which the slave position
+                        is the last GTID before the returned offset are
+                        removed, as the dump thread will not see that GTID.
+    binlog_state  OUT   The last GTID of each domain before the returned
+                        offset is added here
+
+  RETURN
+    Offset of a GTID event, or BIN_LOG_HEADER_SIZE if the file has to be
+    sent from the start.
+*/
+
+my_off_t gtid_index_find_start_pos(const char *binlog_name, my_off_t max_pos,
+                                   slave_connection_state *state,
+                                   rpl_binlog_state *binlog_state)
+{
+  char name[FN_REFLEN];
+  File file;
+  IO_CACHE cache;
+  uchar header[GTID_INDEX_HEADER_LEN];
+  uchar *buf= NULL, *best= NULL;
+  size_t buf_size= 0, best_size= 0;
+  my_off_t start_pos= BIN_LOG_HEADER_SIZE;
+  DBUG_ENTER("gtid_index_find_start_pos");
+
+  gtid_index_file_name(name, binlog_name);
+  if ((file= mysql_file_open(key_file_binlog_gtid_index, name,
+                             O_RDONLY | O_BINARY | O_SHARE, MYF(0))) < 0)
+    DBUG_RETURN(start_pos);
+  if (init_io_cache(&cache, file, IO_SIZE * 2, READ_CACHE, 0, 0,
+                    MYF(MY_DONT_CHECK_FILESIZE)))
+  {
+    mysql_file_close(file, MYF(0));
+    DBUG_RETURN(start_pos);
+  }
+
+  if (my_b_read(&cache, header, sizeof(header)) ||
+      memcmp(header, gtid_index_magic, sizeof(gtid_index_magic)) ||
+      header[sizeof(gtid_index_magic)] != GTID_INDEX_VERSION)
+    goto end;
+
+  for (;;)
+  {
+    uchar len_buf[4];
+    size_t length;
+    uint32 count;
+    my_off_t offset;
+
+    if (my_b_read(&cache, len_buf, sizeof(len_buf)))
+      break;
+    length= uint4korr(len_buf);
+    if (length < GTID_INDEX_ENTRY_LEN ||
+        (length - GTID_INDEX_ENTRY_LEN) % GTID_INDEX_DOMAIN_LEN ||
+        (length - GTID_INDEX_ENTRY_LEN) / GTID_INDEX_DOMAIN_LEN >
+        GTID_INDEX_MAX_DOMAINS)
+      break;
+    if (length > buf_size)
+    {
+      uchar *new_buf;
+      if (!(new_buf= (uchar *) my_realloc(PSI_INSTRUMENT_ME, buf, length,
+                                          MYF(MY_ALLOW_ZERO_PTR))))
+        break;
+      buf= new_buf;
+      buf_size= length;
+    }
+    if (my_b_read(&cache, buf, length) ||
+        my_checksum(0, buf, length - 4) != uint4korr(buf + length - 4))
+      break;
+    offset= uint8korr(buf);
+    count= uint4korr(buf + 8);
+    if (count != (length - GTID_INDEX_ENTRY_LEN) / GTID_INDEX_DOMAIN_LEN ||
+        offset <= start_pos || offset > max_pos ||
+        !gtid_index_entry_usable(buf + 12, count, state))
+      break;
+
+    start_pos= offset;
+    /* Keep this entry, and read the next one into the other buffer */
+    swap_variables(uchar *, best, buf);
+    swap_variables(size_t, best_size, buf_size);
+  }
+
+  if (best)
+  {
+    const uchar *domain= best + 12;
+    uint32 count= uint4korr(best + 8);
+    uint32 i;
+    /* Account for the GTIDs that the dump thread will not read */
+    for (i= 0; i < count; i++)
+    {
+      const uchar *d= domain + i * GTID_INDEX_DOMAIN_LEN;
+      rpl_gtid last;
+      last.domain_id= uint4korr(d);
+      last.server_id= uint4korr(d + 4);
+      last.seq_no= uint8korr(d + 8);
+      if (binlog_state->update_nolock(&last, false))
+      {
+        start_pos= BIN_LOG_HEADER_SIZE;
+        goto end;
+      }
+    }
+    for (; count--; domain+= GTID_INDEX_DOMAIN_LEN)
+    {
+      rpl_gtid *gtid= state->find(uint4korr(domain));
+      if (gtid->seq_no == uint8korr(domain + 16))
+        state->remove(gtid);
+    }
+  }
+
+end:
+  my_free(buf);
+  my_free(best);
+  end_io_cache(&cache);
+  mysql_file_close(file, MYF(0));
+  DBUG_PRINT("info", ("start_pos: %llu", (ulonglong) start_pos));
+  DBUG_RETURN(start_pos);
+}
+
+
+void gtid_index_delete(const char *binlog_name)
+{
+  char name[FN_REFLEN];
+  gtid_index_file_name(name, binlog_name);
+  mysql_file_delete(key_file_binlog_gtid_index, name, MYF(0));
+}
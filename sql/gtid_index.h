@@ -0,0 +1,73 @@
+/* Copyright (c) 2021, MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#ifndef GTID_INDEX_H
+#define GTID_INDEX_H
+
+#include "rpl_gtid.h"
+
+/*
+  Sampled index of the GTID positions in a binlog file.
+
+  Next to each binlog file the binlog writes a file with the same name and
+  the extension GTID_INDEX_EXT. Whenever at least
+  binlog_gtid_index_span_min bytes of binlog were written since the last
+  entry, an entry is appended before the next GTID event. It holds the file
+  offset of that GTID event and, for every replication domain logged in the
+  file before that offset, the last GTID and the highest seq_no.
+
+  A dump thread that is given a GTID start position uses the last entry
+  before that position to start sending from the middle of the binlog
+  file rather than skipping event groups from the start of the file.
+
+  The index is an optimisation only: it is not synced, and a reader stops
+  at the first entry that is incomplete or does not check out.
+*/
+
+#define GTID_INDEX_EXT ".idx"
+
+class Gtid_index_writer
+{
+public:
+  Gtid_index_writer();
+  ~Gtid_index_writer();
+
+  bool open(const char *binlog_name);
+  void close();
+  bool is_open() const { return file >= 0; }
+  void add(const rpl_gtid *gtid, my_off_t offset);
+
+private:
+  /* What the binlog file holds of one replication domain so far */
+  struct domain_state
+  {
+    rpl_gtid last;
+    uint64 max_seq_no;
+  };
+
+  bool write_entry(my_off_t offset);
+
+  File file;
+  /* File offset of the last entry written */
+  my_off_t last_offset;
+  DYNAMIC_ARRAY domains;
+};
+
+my_off_t gtid_index_find_start_pos(const char *binlog_name, my_off_t max_pos,
+                                   slave_connection_state *state,
+                                   rpl_binlog_state *binlog_state);
+void gtid_index_delete(const char *binlog_name);
+
+#endif /* GTID_INDEX_H */
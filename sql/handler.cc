@@ -3087,6 +3087,34 @@ int handler::ha_rnd_next(uchar *buf)
   DBUG_RETURN(result);
 }
 
+int handler::ha_rnd_next_batch(uchar *buf, uint max_rows, uint *rows)
+{
+  int result;
+  DBUG_ENTER("handler::ha_rnd_next_batch");
+  DBUG_ASSERT(table_share->tmp_table != NO_TMP_TABLE ||
+              m_lock_type != F_UNLCK);
+  DBUG_ASSERT(inited == RND);
+  DBUG_ASSERT(max_rows > 0);
+
+  do
+  {
+    *rows= 0;
+    TABLE_IO_WAIT(tracker, PSI_TABLE_FETCH_ROW, MAX_KEY, result,
+      { result= rnd_next_batch(buf, max_rows, rows); })
+    if (result != HA_ERR_RECORD_DELETED)
+      break;
+    status_var_increment(table->in_use->status_var.ha_read_rnd_deleted_count);
+  } while (!table->in_use->check_killed(1));
+
+  if (result == HA_ERR_RECORD_DELETED)
+    result= HA_ERR_ABORTED_BY_USER;
+  else if (result && result != HA_ERR_WRONG_COMMAND)
+    increment_statistics(&SSV::ha_read_rnd_next_count);
+
+  table->status= *rows ? 0 : STATUS_NOT_FOUND;
+  DBUG_RETURN(result);
+}
+
 int handler::ha_rnd_pos(uchar *buf, uchar *pos)
 {
   int result;
@@ -6859,6 +6887,34 @@ void handler::alloc_lookup_buffer()
                                       + table_share->reclength);
 }
 
+/**
+  Allocate the buffer for batched table scans, see rnd_next_batch()
+
+  The buffer lives as long as the TABLE; it is allocated with the number
+  of rows of the first batched scan and reused by the later ones.
+  Every row starts out as a copy of the default values, like record[0],
+  because engines only store the columns that were requested and whole
+  rows are copied to record[0].
+
+  @return true on out of memory
+*/
+
+bool handler::alloc_batch_buffer(uint rows)
+{
+  if (!batch_buffer)
+  {
+    const size_t reclength= table_share->reclength;
+    if (!(batch_buffer= (uchar*) alloc_root(&table->mem_root,
+                                            (size_t) rows * reclength)))
+      return true;
+    for (uint i= 0; i < rows; i++)
+      memcpy(batch_buffer + i * reclength, table_share->default_values,
+             reclength);
+    batch_buffer_rows= rows;
+  }
+  return false;
+}
+
 /** @brief
     check whether inserted records breaks the
     unique constraint on long columns.
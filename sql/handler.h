@@ -3091,6 +3091,9 @@ class handler :public Sql_alloc
   uchar *ref;				/* Pointer to current row */
   uchar *dup_ref;			/* Pointer to duplicate row */
   uchar *lookup_buffer;
+  /* Rows of a batched table scan, see rnd_next_batch() */
+  uchar *batch_buffer;
+  uint batch_buffer_rows;
 
   ha_statistics stats;
 
@@ -3286,7 +3289,8 @@ class handler :public Sql_alloc
     :table_share(share_arg), table(0),
     estimation_rows_to_insert(0),
     lookup_handler(this),
-    ht(ht_arg), ref(0), lookup_buffer(NULL), end_range(NULL),
+    ht(ht_arg), ref(0), lookup_buffer(NULL),
+    batch_buffer(NULL), batch_buffer_rows(0), end_range(NULL),
     implicit_emptied(0),
     mark_trx_read_write_done(0),
     check_table_binlog_row_based_done(0),
@@ -3913,6 +3917,31 @@ class handler :public Sql_alloc
 public:
   virtual int ft_read(uchar *buf) { return HA_ERR_WRONG_COMMAND; }
   virtual int rnd_next(uchar *buf)=0;
+  /**
+    Read the next rows of a table scan.
+
+    @param buf       Buffer for max_rows rows in table->record[0] format,
+                     stored one after another, table_share->reclength
+                     bytes each
+    @param max_rows  Maximum number of rows to read
+    @param[out] rows Number of rows stored in buf
+
+    The rows are the same as the ones consecutive rnd_next() calls would
+    return, but the caller neither calls position() or unlock_row() for
+    them nor updates or deletes them, so the engine does not need to keep
+    its cursor on any of them. It is only used for tables without BLOB
+    columns.
+
+    If an error occurs after some rows were read, those rows are returned
+    in buf and *rows together with the error.
+
+    @retval 0                    OK, at least one row was read
+    @retval HA_ERR_WRONG_COMMAND The engine can't read this scan in batches;
+                                 use rnd_next() instead
+    @retval #                    HA_ERR_END_OF_FILE or other error code
+  */
+  virtual int rnd_next_batch(uchar *buf, uint max_rows, uint *rows)
+  { return HA_ERR_WRONG_COMMAND; }
   virtual int rnd_pos(uchar * buf, uchar *pos)=0;
   /**
     This function only works for handlers having
@@ -3940,6 +3969,10 @@ class handler :public Sql_alloc
   inline int ha_ft_read(uchar *buf);
   inline void ha_ft_end() { ft_end(); ft_handler=NULL; }
   int ha_rnd_next(uchar *buf);
+  int ha_rnd_next_batch(uchar *buf, uint max_rows, uint *rows);
+  /* Statistics for a row of a batch when the caller starts using it */
+  inline void ha_rnd_next_batch_row();
+  bool alloc_batch_buffer(uint rows);
   int ha_rnd_pos(uchar *buf, uchar *pos);
   inline int ha_rnd_pos_by_record(uchar *buf);
   inline int ha_read_first_row(uchar *buf, uint primary_key);
@@ -807,8 +807,8 @@ bool Aggregator_distinct::setup(THD *thd)
     if (table->s->db_type() == heap_hton)
     {
       /*
-        No blobs, otherwise it would have been MyISAM: set up a compare
-        function and its arguments to use with Unique.
+        No blobs, as a distinct table with blobs is never a heap table:
+        set up a compare function and its arguments to use with Unique.
       */
       qsort_cmp2 compare_key;
       void* cmp_arg;
@@ -35,7 +35,9 @@
 #include "sql_time.h"           // calc_time_from_sec, my_time_compare
 #include "tztime.h"             // my_tz_OFFSET0, struct Time_zone
 #include "log_event.h"          // Query_log_event
+#include "key.h"                // key_copy, key_hashnr
 #include "rpl_filter.h"
+#include "gtid_index.h"
 #include "rpl_rli.h"
 #include "sql_audit.h"
 #include "mysqld.h"
@@ -117,8 +119,12 @@ static ulonglong binlog_status_var_num_group_commits;
 static ulonglong binlog_status_group_commit_trigger_count;
 static ulonglong binlog_status_group_commit_trigger_lock_wait;
 static ulonglong binlog_status_group_commit_trigger_timeout;
+static ulonglong binlog_status_group_commit_pipelined;
+static ulonglong binlog_status_group_commit_pipeline_sync_wait;
 static char binlog_snapshot_file[FN_REFLEN];
 static ulonglong binlog_snapshot_position;
+static ulonglong binlog_status_dump_cache_hits;
+static Atomic_counter<ulonglong> binlog_dump_cache_hits;
 
 static const char *fatal_log_error=
   "Could not use %s for logging (error %d). "
@@ -131,6 +137,8 @@ static SHOW_VAR binlog_status_vars_detail[]=
 {
   {"commits",
     (char *)&binlog_status_var_num_commits, SHOW_LONGLONG},
+  {"dump_cache_hits",
+    (char *)&binlog_status_dump_cache_hits, SHOW_LONGLONG},
   {"group_commits",
     (char *)&binlog_status_var_num_group_commits, SHOW_LONGLONG},
   {"group_commit_trigger_count",
@@ -139,6 +147,10 @@ static SHOW_VAR binlog_status_vars_detail[]=
     (char *)&binlog_status_group_commit_trigger_lock_wait, SHOW_LONGLONG},
   {"group_commit_trigger_timeout",
     (char *)&binlog_status_group_commit_trigger_timeout, SHOW_LONGLONG},
+  {"group_commit_pipelined",
+    (char *)&binlog_status_group_commit_pipelined, SHOW_LONGLONG},
+  {"group_commit_pipeline_sync_wait",
+    (char *)&binlog_status_group_commit_pipeline_sync_wait, SHOW_LONGLONG},
   {"snapshot_file",
     (char *)&binlog_snapshot_file, SHOW_CHAR},
   {"snapshot_position",
@@ -270,7 +282,7 @@ void make_default_log_name(char **out, const char* log_ext, bool once)
 class binlog_cache_data
 {
 public:
-  binlog_cache_data(): m_pending(0), status(0),
+  binlog_cache_data(): payload(0), payload_len(0), m_pending(0), status(0),
   before_stmt_pos(MY_OFF_T_UNDEF),
   incident(FALSE), changes_to_non_trans_temp_table_flag(FALSE),
   saved_max_binlog_cache_size(0), ptr_binlog_cache_use(0),
@@ -280,6 +292,7 @@ class binlog_cache_data
   ~binlog_cache_data()
   {
     DBUG_ASSERT(empty());
+    my_free(payload);
     close_cached_file(&cache_log);
   }
 
@@ -346,9 +359,13 @@ class binlog_cache_data
     status= 0;
     incident= FALSE;
     before_stmt_pos= MY_OFF_T_UNDEF;
+    my_free(payload);
+    payload= NULL;
     DBUG_ASSERT(empty());
   }
 
+  void compress();
+
   my_off_t get_byte_position() const
   {
     return my_b_tell(&cache_log);
@@ -416,6 +433,13 @@ class binlog_cache_data
   */
   IO_CACHE cache_log;
 
+  /*
+    The contents of cache_log compressed by compress(), to be logged as a
+    Transaction_payload_log_event, or NULL.
+  */
+  char *payload;
+  uint32 payload_len;
+
 private:
   /*
     Pending binrows event. This event is the event where the rows are currently
@@ -508,6 +532,57 @@ class binlog_cache_data
 };
 
 
+/*
+  Compress the complete contents of the cache into 'payload'
+
+  Called by the committing thread before it queues for group commit, so
+  that the group commit leader only copies the compressed events to the
+  binary log while it holds LOCK_log. The payload is left NULL if the
+  events do not get smaller.
+
+  The payload uses the compressed record format of the other compressed
+  events. It is compressed with zstd when the server is built with it
+  (WITH_ZSTD), and with zlib otherwise.
+*/
+
+void binlog_cache_data::compress()
+{
+  size_t length= (size_t) my_b_tell(&cache_log);
+#ifdef HAVE_ZSTD
+  const uint alg= BINLOG_COMPRESS_ZSTD;
+#else
+  const uint alg= BINLOG_COMPRESS_ZLIB;
+#endif
+  uint32 len;
+  char *events;
+
+  DBUG_ASSERT(!payload);
+  DBUG_ASSERT(!pending());
+  /*
+    The payload event has to fit in a replication packet, and the cache is
+    compressed in memory, so larger caches are logged as they are.
+  */
+  if (length > MAX_MAX_ALLOWED_PACKET ||
+      reinit_io_cache(&cache_log, READ_CACHE, 0, 0, 0))
+    return;
+  len= binlog_get_compress_len((uint32) length, alg);
+  if (!(events= (char *) my_malloc(PSI_INSTRUMENT_ME, length, MYF(MY_WME))) ||
+      !(payload= (char *) my_malloc(PSI_INSTRUMENT_ME, len, MYF(MY_WME))) ||
+      my_b_read(&cache_log, (uchar *) events, length) ||
+      binlog_buf_compress(events, payload, (uint32) length, &len, alg) ||
+      len >= length)
+  {
+    my_free(payload);
+    payload= NULL;
+  }
+  else
+    payload_len= len;
+  my_free(events);
+  /* Back to appending, for the writers that look at the cache until then */
+  truncate(length);
+}
+
+
 void Log_event_writer::add_status(enum_logged_status status)
 {
   if (likely(cache_data))
@@ -520,6 +595,59 @@ void Log_event_writer::set_incident()
 }
 
 
+/*
+  Hashes of the primary and unique keys of the rows changed by a
+  transaction, logged with its GTID event for --slave-parallel-mode=writeset.
+  The hashes are stored in the byte order of the event.
+*/
+class binlog_writeset
+{
+public:
+  binlog_writeset(): buf(0), count(0), size(0), incomplete(FALSE) { }
+  ~binlog_writeset() { my_free(buf); }
+
+  void reset()
+  {
+    count= 0;
+    incomplete= FALSE;
+  }
+
+  void add(uint32 hash)
+  {
+    if (incomplete)
+      return;
+    if (count >= opt_binlog_writeset_max_keys)
+    {
+      incomplete= TRUE;
+      return;
+    }
+    if (count == size)
+    {
+      uint new_size= MY_MIN(MY_MAX(size * 2, 16),
+                            (uint) opt_binlog_writeset_max_keys);
+      uchar *new_buf= (uchar *) my_realloc(PSI_INSTRUMENT_ME, buf,
+                                           new_size * 4,
+                                           MYF(MY_ALLOW_ZERO_PTR));
+      if (!new_buf)
+      {
+        incomplete= TRUE;
+        return;
+      }
+      buf= new_buf;
+      size= new_size;
+    }
+    int4store(buf + count * 4, hash);
+    count++;
+  }
+
+  uchar *buf;
+  uint count;
+  uint size;
+  /* Set when some change of the transaction is not covered by the hashes */
+  bool incomplete;
+};
+
+
 class binlog_cache_mngr {
 public:
   binlog_cache_mngr(my_off_t param_max_binlog_stmt_cache_size,
@@ -546,6 +674,7 @@ class binlog_cache_mngr {
     if (do_trx)
     {
       trx_cache.reset();
+      writeset.reset();
       using_xa= FALSE;
       last_commit_pos_file[0]= 0;
       last_commit_pos_offset= 0;
@@ -566,6 +695,8 @@ class binlog_cache_mngr {
 
   binlog_cache_data trx_cache;
 
+  binlog_writeset writeset;
+
   /*
     Binlog position for current transaction.
     For START TRANSACTION WITH CONSISTENT SNAPSHOT, this is the binlog
@@ -2574,6 +2705,191 @@ File open_binlog(IO_CACHE *log, const char *log_file_name, const char **errmsg)
   DBUG_RETURN(-1);
 }
 
+
+/*
+  Copy of the end of the active binary log file, shared by the binlog
+  dump threads.
+
+  Everything the binlog writes to the file through its IO_CACHE is also
+  appended to a ring buffer of binlog_dump_cache_size bytes. Dump threads
+  whose read position is still inside the ring copy the file contents from
+  memory; the others read the file as usual. As the ring holds the raw file
+  contents, event decoding, decryption and checksum checks in the dump
+  threads are the same in both cases.
+*/
+
+class Binlog_dump_cache
+{
+  mysql_rwlock_t lock;
+  uchar *buf;
+  size_t size;
+  /* The ring holds the bytes [start, end) of the file log_name */
+  my_off_t start, end;
+  char log_name[FN_REFLEN];
+
+public:
+  Binlog_dump_cache(): buf(NULL), size(0), start(0), end(0)
+  {
+    log_name[0]= 0;
+  }
+  bool enabled() const { return buf != NULL; }
+
+  bool init(size_t size_arg)
+  {
+    if (!(buf= (uchar*) my_malloc(PSI_INSTRUMENT_ME, size_arg, MYF(MY_WME))))
+      return true;
+    size= size_arg;
+    mysql_rwlock_init(key_rwlock_BINLOG_dump_cache, &lock);
+    return false;
+  }
+
+  void destroy()
+  {
+    if (buf)
+    {
+      mysql_rwlock_destroy(&lock);
+      my_free(buf);
+      buf= NULL;
+    }
+  }
+
+  /* Start caching the file 'name', of which 'pos' bytes are written */
+  void reset(const char *name, my_off_t pos)
+  {
+    mysql_rwlock_wrlock(&lock);
+    strmake_buf(log_name, name);
+    start= end= pos;
+    mysql_rwlock_unlock(&lock);
+  }
+
+  void append(my_off_t pos, const uchar *data, size_t length)
+  {
+    size_t offset, part;
+    mysql_rwlock_wrlock(&lock);
+    if (pos != end)
+      start= pos;                               /* Not contiguous, start over */
+    if (length > size)
+    {
+      data+= length - size;
+      pos+= length - size;
+      length= size;
+    }
+    offset= (size_t) (pos % size);
+    part= MY_MIN(length, size - offset);
+    memcpy(buf + offset, data, part);
+    memcpy(buf, data + part, length - part);
+    end= pos + length;
+    if (end - start > size)
+      start= end - size;
+    mysql_rwlock_unlock(&lock);
+  }
+
+  /*
+    Copy up to 'length' bytes from position 'pos' of the file 'name'
+
+    RETURN
+      Number of bytes copied, 0 if 'pos' is not in the ring
+  */
+  size_t read(const char *name, my_off_t pos, uchar *to, size_t length)
+  {
+    size_t copied= 0;
+    mysql_rwlock_rdlock(&lock);
+    if (pos >= start && pos < end && !strcmp(name, log_name))
+    {
+      size_t offset= (size_t) (pos % size), part;
+      copied= (size_t) MY_MIN(length, end - pos);
+      part= MY_MIN(copied, size - offset);
+      memcpy(to, buf + offset, part);
+      memcpy(to + part, buf, copied - part);
+    }
+    mysql_rwlock_unlock(&lock);
+    return copied;
+  }
+};
+
+static Binlog_dump_cache binlog_dump_cache;
+static Gtid_index_writer binlog_gtid_index;
+/* Original IO_CACHE functions of the binlog file */
+static int (*binlog_file_read)(IO_CACHE *, uchar *, size_t);
+static int (*binlog_file_write)(IO_CACHE *, const uchar *, size_t);
+
+
+static int binlog_dump_cache_write(IO_CACHE *info, const uchar *Buffer,
+                                   size_t Count)
+{
+  my_off_t pos= info->pos_in_file;
+  int res= binlog_file_write(info, Buffer, Count);
+  if (info->pos_in_file > pos)
+    binlog_dump_cache.append(pos, Buffer, (size_t) (info->pos_in_file - pos));
+  return res;
+}
+
+
+/*
+  Read function of a binlog file IO_CACHE of a dump thread
+
+  NOTE
+    This is called like _my_b_cache_read(): when the buffer of the cache is
+    consumed. If the wanted bytes are in the dump cache, they are copied
+    from there and the buffer is refilled from the dump cache as far as it
+    can; otherwise the file is read.
+*/
+
+static int binlog_dump_cache_read(IO_CACHE *info, uchar *Buffer, size_t Count)
+{
+  my_off_t pos= info->pos_in_file + (size_t) (info->read_end - info->buffer);
+  const char *name= current_thd->current_linfo->log_file_name;
+
+  if (pos + Count <= info->end_of_file &&
+      binlog_dump_cache.read(name, pos, Buffer, Count) == Count)
+  {
+    size_t length;
+    pos+= Count;
+    length= (size_t) MY_MIN(info->read_length, info->end_of_file - pos);
+    info->pos_in_file= pos;
+    info->read_pos= info->buffer;
+    info->read_end= info->buffer +
+                    binlog_dump_cache.read(name, pos, info->buffer, length);
+    /* The file position no longer matches the cache */
+    info->seek_not_done= 1;
+    binlog_dump_cache_hits++;
+    return 0;
+  }
+  return binlog_file_read(info, Buffer, Count);
+}
+
+
+/*
+  Make a binlog dump thread read the binlog file 'log' through the dump
+  cache, if there is one.
+*/
+
+void use_binlog_dump_cache(IO_CACHE *log)
+{
+  if (binlog_dump_cache.enabled())
+    log->read_function= binlog_dump_cache_read;
+}
+
+
+/*
+  Copy what is written to the new, empty binlog file 'log' to the dump
+  cache. The cache is created on the first call.
+*/
+
+static void attach_binlog_dump_cache(IO_CACHE *log, const char *name)
+{
+  if (!binlog_dump_cache.enabled())
+  {
+    /* No dump thread is running yet */
+    binlog_file_read= log->read_function;
+    binlog_file_write= log->write_function;
+    if (binlog_dump_cache.init((size_t) binlog_dump_cache_size))
+      return;
+  }
+  binlog_dump_cache.reset(name, my_b_tell(log));
+  log->write_function= binlog_dump_cache_write;
+}
+
 #ifdef _WIN32
 static int eventSource = 0;
 
@@ -3386,6 +3702,7 @@ MYSQL_BIN_LOG::MYSQL_BIN_LOG(uint *sync_period)
    num_commits(0), num_group_commits(0),
    group_commit_trigger_count(0), group_commit_trigger_timeout(0),
    group_commit_trigger_lock_wait(0),
+   group_commit_pipelined(0), group_commit_pipeline_sync_wait(0),
    sync_period_ptr(sync_period), sync_counter(0),
    state_file_deleted(false), binlog_state_recover_done(false),
    is_relay_log(0), relay_signal_cnt(0),
@@ -3458,6 +3775,7 @@ void MYSQL_BIN_LOG::cleanup()
     mysql_mutex_destroy(&LOCK_xid_list);
     mysql_mutex_destroy(&LOCK_binlog_background_thread);
     mysql_mutex_destroy(&LOCK_binlog_end_pos);
+    mysql_mutex_destroy(&LOCK_binlog_sync);
     mysql_cond_destroy(&COND_relay_log_updated);
     mysql_cond_destroy(&COND_bin_log_updated);
     mysql_cond_destroy(&COND_queue_busy);
@@ -3472,7 +3790,10 @@ void MYSQL_BIN_LOG::cleanup()
     safemalloc is shut down
   */
   if (!is_relay_log)
+  {
     rpl_global_gtid_binlog_state.free();
+    binlog_dump_cache.destroy();
+  }
   DBUG_VOID_RETURN;
 }
 
@@ -3508,6 +3829,8 @@ void MYSQL_BIN_LOG::init_pthread_objects()
 
   mysql_mutex_init(m_key_LOCK_binlog_end_pos, &LOCK_binlog_end_pos,
                    MY_MUTEX_INIT_SLOW);
+  mysql_mutex_init(key_BINLOG_LOCK_binlog_sync, &LOCK_binlog_sync,
+                   MY_MUTEX_INIT_SLOW);
 }
 
 
@@ -3695,6 +4018,12 @@ bool MYSQL_BIN_LOG::open(const char *log_name,
 	an extension for the binary log files.
 	In this case we write a standard header to it.
       */
+      if (!is_relay_log && binlog_dump_cache_size)
+        attach_binlog_dump_cache(&log_file, log_file_name);
+      if (!is_relay_log && opt_binlog_gtid_index &&
+          binlog_gtid_index.open(log_file_name))
+        sql_print_warning("Could not create the GTID index of binlog file "
+                          "'%s' (errno: %d)", log_file_name, my_errno);
       if (my_b_safe_write(&log_file, BINLOG_MAGIC,
 			  BIN_LOG_HEADER_SIZE))
         goto err;
@@ -4323,6 +4652,7 @@ bool MYSQL_BIN_LOG::reset_logs(THD *thd, bool create_new_log,
       later would leave such transaction not recoverable.
     */
 
+    wait_for_binlog_sync();
     mysql_mutex_lock(&LOCK_after_binlog_sync);
     mysql_mutex_lock(&LOCK_commit_ordered);
     mysql_mutex_unlock(&LOCK_after_binlog_sync);
@@ -4379,6 +4709,8 @@ bool MYSQL_BIN_LOG::reset_logs(THD *thd, bool create_new_log,
 
   for (;;)
   {
+    if (!is_relay_log)
+      gtid_index_delete(linfo.log_file_name);
     if (unlikely((error= my_delete(linfo.log_file_name, MYF(0)))))
     {
       if (my_errno == ENOENT) 
@@ -4994,6 +5326,8 @@ int MYSQL_BIN_LOG::purge_index_entry(THD *thd, ulonglong *reclaimed_space,
         error= 0;
 
         DBUG_PRINT("info",("purging %s",log_info.log_file_name));
+        if (!is_relay_log)
+          gtid_index_delete(log_info.log_file_name);
         if (!my_delete(log_info.log_file_name, MYF(0)))
         {
           if (reclaimed_space)
@@ -5293,6 +5627,7 @@ int MYSQL_BIN_LOG::new_file_impl()
     DBUG_RETURN(error);
   }
 
+  wait_for_binlog_sync();
   mysql_mutex_lock(&LOCK_index);
 
   /* Reuse old name if not binlog and not update log */
@@ -5561,6 +5896,7 @@ bool MYSQL_BIN_LOG::flush_and_sync(bool *synced)
   if (synced)
     *synced= 0;
   mysql_mutex_assert_owner(&LOCK_log);
+  wait_for_binlog_sync();
   if (flush_io_cache(&log_file))
     return 1;
   uint sync_period= get_sync_period();
@@ -5578,6 +5914,24 @@ bool MYSQL_BIN_LOG::flush_and_sync(bool *synced)
   return err;
 }
 
+
+/*
+  Wait until the group commit that is syncing the binlog without LOCK_log
+  (see binlog_commit_pipeline) is done with it.
+
+  As we hold LOCK_log, no other group commit can start syncing meanwhile.
+  Must be done before the binlog end position is moved by anyone else, and
+  before the binlog file is closed.
+*/
+
+void MYSQL_BIN_LOG::wait_for_binlog_sync()
+{
+  mysql_mutex_assert_owner(&LOCK_log);
+  mysql_mutex_lock(&LOCK_binlog_sync);
+  mysql_mutex_unlock(&LOCK_binlog_sync);
+}
+
+
 void MYSQL_BIN_LOG::start_union_events(THD *thd, query_id_t query_id_param)
 {
   DBUG_ASSERT(!thd->binlog_evt_union.do_union);
@@ -5764,6 +6118,93 @@ binlog_cache_mngr *THD::binlog_setup_trx_data()
   DBUG_RETURN(cache_mngr);
 }
 
+
+/**
+  Add the primary and unique keys of a changed row to the writeset of the
+  transaction.
+
+  @param table        Table of the row
+  @param is_trans     If the row is logged in the transactional cache
+  @param record       Row image, in the record format of the table
+  @param all_columns  If all columns of the record are set; otherwise only
+                      those in the read and write sets of the table are
+
+  A change that cannot be described by its keys makes the writeset
+  incomplete, so that the transaction is logged without one.
+*/
+
+void THD::binlog_add_row_keys(TABLE *table, bool is_trans,
+                              const uchar *record, bool all_columns)
+{
+  binlog_cache_mngr *cache_mngr;
+  binlog_writeset *writeset;
+  uchar key_buf[MAX_KEY_LENGTH];
+  uint keys_added= 0;
+  DBUG_ENTER("THD::binlog_add_row_keys");
+
+  if (!opt_binlog_writeset_max_keys || !is_trans ||
+      !(cache_mngr= binlog_setup_trx_data()))
+    DBUG_VOID_RETURN;
+  writeset= &cache_mngr->writeset;
+  if (writeset->incomplete)
+    DBUG_VOID_RETURN;
+
+  /*
+    A foreign key makes changes of the child table depend on the rows of
+    the parent table, which the keys of the child rows do not show.
+  */
+  if (!table->file->has_transactions_and_rollback() ||
+      table->file->referenced_by_foreign_key())
+    goto incomplete;
+
+  {
+    my_hash_value_type table_hash=
+      my_hash_sort(&my_charset_bin, (const uchar*) table->s->table_cache_key.str,
+                   table->s->table_cache_key.length);
+
+    for (uint i= 0; i < table->s->keys; i++)
+    {
+      KEY *key_info= table->key_info + i;
+      KEY_PART_INFO *key_part, *key_part_end;
+      bool has_null= false;
+
+      if (!(key_info->flags & HA_NOSAME))
+        continue;
+      if (key_info->algorithm == HA_KEY_ALG_LONG_HASH)
+        goto incomplete;
+      key_part_end= key_info->key_part + key_info->user_defined_key_parts;
+      for (key_part= key_info->key_part; key_part < key_part_end; key_part++)
+      {
+        uint field_no= key_part->fieldnr - 1;
+        if (!all_columns &&
+            !bitmap_is_set(table->read_set, field_no) &&
+            !bitmap_is_set(table->write_set, field_no))
+          goto incomplete;
+        if (key_part->null_bit &&
+            (record[key_part->null_offset] & key_part->null_bit))
+          has_null= true;
+      }
+      /* NULL values do not conflict in a unique key */
+      if (has_null)
+        continue;
+
+      key_copy(key_buf, record, key_info, 0);
+      ulonglong nr= key_hashnr(key_info, key_info->user_defined_key_parts,
+                               key_buf);
+      writeset->add((uint32) (nr ^ (nr >> 32)) ^ (table_hash + i));
+      keys_added++;
+    }
+  }
+
+  /* Without a non-NULL unique key the row cannot be told apart */
+  if (keys_added)
+    DBUG_VOID_RETURN;
+
+incomplete:
+  writeset->incomplete= TRUE;
+  DBUG_VOID_RETURN;
+}
+
 /*
   Function to start a statement and optionally a transaction for the
   binary log.
@@ -6280,8 +6721,27 @@ MYSQL_BIN_LOG::write_gtid_event(THD *thd, bool standalone,
                             LOG_EVENT_SUPPRESS_USE_F, is_transactional,
                             commit_id);
 
+  /*
+    Only a transaction that went entirely through the transactional cache is
+    fully described by the row keys collected in binlog_add_row_keys().
+    The parts of an XA transaction are not: XA COMMIT and XA ROLLBACK change
+    no rows, but must not be applied before their XA PREPARE. An empty
+    writeset would let such a transaction run in parallel with anything.
+  */
+  binlog_cache_mngr *cache_mngr;
+  if (opt_binlog_writeset_max_keys && !standalone &&
+      (gtid_event.flags2 & Gtid_log_event::FL_TRANSACTIONAL) &&
+      !(gtid_event.flags2 & (Gtid_log_event::FL_PREPARED_XA |
+                             Gtid_log_event::FL_COMPLETED_XA)) &&
+      (cache_mngr= (binlog_cache_mngr*) thd_get_ha_data(thd, binlog_hton)) &&
+      !cache_mngr->writeset.incomplete && cache_mngr->writeset.count &&
+      cache_mngr->stmt_cache.empty())
+    gtid_event.set_writeset(cache_mngr->writeset.buf,
+                            (uint16) cache_mngr->writeset.count);
+
   /* Write the event to the binary log. */
   DBUG_ASSERT(this == &mysql_bin_log);
+  binlog_gtid_index.add(&gtid, my_b_tell(&log_file));
 
 #ifdef WITH_WSREP
   if (wsrep_gtid_mode)
@@ -6632,6 +7092,9 @@ bool MYSQL_BIN_LOG::write(Log_event *event_info, my_bool *with_annotate)
       is_trans_cache= use_trans_cache(thd, using_trans);
       cache_data= cache_mngr->get_binlog_cache_data(is_trans_cache);
       file= &cache_data->cache_log;
+      /* Statement events carry no row keys */
+      if (is_trans_cache)
+        cache_mngr->writeset.incomplete= TRUE;
 
       if (thd->lex->stmt_accessed_non_trans_temp_table())
         cache_data->set_changes_to_non_trans_temp_table();
@@ -7425,6 +7888,31 @@ int MYSQL_BIN_LOG::write_cache(THD *thd, IO_CACHE *cache)
   DBUG_RETURN(0);                               // All OK
 }
 
+/*
+  Write the payload of a cache, compressed by binlog_cache_data::compress(),
+  to the binary log as one Transaction_payload_log_event
+
+  RETURN
+    false  OK
+    true   Error
+*/
+
+bool MYSQL_BIN_LOG::write_cache_payload(THD *thd,
+                                        binlog_cache_data *cache_data)
+{
+  DBUG_ENTER("MYSQL_BIN_LOG::write_cache_payload");
+
+  mysql_mutex_assert_owner(&LOCK_log);
+  Transaction_payload_log_event ev(thd, cache_data->payload,
+                                   cache_data->payload_len);
+  DBUG_EXECUTE_IF("fail_binlog_write_1",
+                  errno= 28; DBUG_RETURN(true););
+  if (write_event(&ev))
+    DBUG_RETURN(true);
+  status_var_add(thd->status_var.binlog_bytes_written, ev.data_written);
+  DBUG_RETURN(false);
+}
+
 /*
   Helper function to get the error code of the query to be binlogged.
  */
@@ -7627,6 +8115,18 @@ MYSQL_BIN_LOG::write_transaction_to_binlog(THD *thd,
     break;
   }
 
+  /*
+    Compress the caches now, so that the group commit leader does not do it
+    for everyone while holding LOCK_log.
+  */
+  if (opt_bin_log_compress_transactions)
+  {
+    if (using_stmt_cache && !cache_mngr->stmt_cache.empty())
+      cache_mngr->stmt_cache.compress();
+    if (using_trx_cache && !cache_mngr->trx_cache.empty())
+      cache_mngr->trx_cache.compress();
+  }
+
   entry.end_event= end_ev;
   if (cache_mngr->stmt_cache.has_incident() ||
       cache_mngr->trx_cache.has_incident())
@@ -8138,6 +8638,7 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
   group_commit_entry *current, *last_in_queue;
   group_commit_entry *queue= NULL;
   bool check_purge= false;
+  bool pipelined= false;
   ulong UNINIT_VAR(binlog_id);
   uint64 commit_id;
   DBUG_ENTER("MYSQL_BIN_LOG::trx_group_commit_leader");
@@ -8252,8 +8753,39 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
     }
     set_current_thd(leader->thd);
 
+    /*
+      With binlog_commit_pipeline, a group that has to sync the binlog does
+      so after releasing LOCK_log, holding LOCK_binlog_sync instead, so that
+      the next group can write to the binlog meanwhile. The next group takes
+      LOCK_binlog_sync in turn before it syncs, and we only release it once
+      we hold LOCK_after_binlog_sync, so the groups still commit in order.
+
+      This is not done when the binlog is due to be rotated, as that has to
+      be done under LOCK_log after the sync.
+    */
+    uint sync_period= get_sync_period();
     bool synced= 0;
-    if (unlikely(flush_and_sync(&synced)))
+    bool flush_error;
+    if (opt_binlog_commit_pipeline && sync_period &&
+        sync_counter + 1 >= sync_period &&
+        my_b_write_tell(&log_file) < (my_off_t) max_size)
+    {
+      if (likely(!(flush_error= flush_io_cache(&log_file))))
+      {
+        sync_counter= 0;
+        if (mysql_mutex_trylock(&LOCK_binlog_sync))
+        {
+          group_commit_pipeline_sync_wait++;
+          mysql_mutex_lock(&LOCK_binlog_sync);
+        }
+        group_commit_pipelined++;
+        pipelined= true;
+      }
+    }
+    else
+      flush_error= flush_and_sync(&synced);
+
+    if (unlikely(flush_error))
     {
       for (current= queue; current != NULL; current= current->next)
       {
@@ -8298,8 +8830,10 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
         Note: must be _after_ the RUN_HOOK(after_flush) or else
         semi-sync might not have put the transaction into
         it's list before dump-thread tries to send it
+        When pipelined, this is done after the sync.
       */
-      update_binlog_end_pos(commit_offset);
+      if (!pipelined)
+        update_binlog_end_pos(commit_offset);
 
       if (unlikely(any_error))
         sql_print_error("Failed to run 'after_flush' hooks");
@@ -8316,7 +8850,7 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
       mark_xids_active(binlog_id, xid_count);
     }
 
-    if (rotate(false, &check_purge))
+    if (!pipelined && rotate(false, &check_purge))
     {
       /*
         If we fail to rotate, which thread should get the error?
@@ -8339,15 +8873,48 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
     commit_offset= my_b_write_tell(&log_file);
   }
 
-  DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_after_binlog_sync");
-  mysql_mutex_lock(&LOCK_after_binlog_sync);
-  /*
-    We cannot unlock LOCK_log until we have locked LOCK_after_binlog_sync;
-    otherwise scheduling could allow the next group commit to run ahead of us,
-    messing up the order of commit_ordered() calls. But as soon as
-    LOCK_after_binlog_sync is obtained, we can let the next group commit start.
-  */
-  mysql_mutex_unlock(&LOCK_log);
+  if (pipelined)
+  {
+    mysql_mutex_unlock(&LOCK_log);
+    DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log_before_sync");
+
+    if (unlikely(mysql_file_sync(log_file.file, MYF(MY_WME|MY_SYNC_FILESIZE))))
+    {
+      for (current= queue; current != NULL; current= current->next)
+      {
+        if (!current->error)
+        {
+          current->error= ER_ERROR_ON_WRITE;
+          current->commit_errno= errno;
+          current->error_cache= NULL;
+        }
+      }
+    }
+    else
+      update_binlog_end_pos(commit_offset);
+#ifndef DBUG_OFF
+    if (opt_binlog_dbug_fsync_sleep > 0)
+      my_sleep(opt_binlog_dbug_fsync_sleep);
+#endif
+
+    DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_after_binlog_sync");
+    mysql_mutex_lock(&LOCK_after_binlog_sync);
+    /* Same as for LOCK_log below, the next group may now sync */
+    mysql_mutex_unlock(&LOCK_binlog_sync);
+  }
+  else
+  {
+    DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_after_binlog_sync");
+    mysql_mutex_lock(&LOCK_after_binlog_sync);
+    /*
+      We cannot unlock LOCK_log until we have locked LOCK_after_binlog_sync;
+      otherwise scheduling could allow the next group commit to run ahead of
+      us, messing up the order of commit_ordered() calls. But as soon as
+      LOCK_after_binlog_sync is obtained, we can let the next group commit
+      start.
+    */
+    mysql_mutex_unlock(&LOCK_log);
+  }
 
   DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log");
 
@@ -8470,7 +9037,9 @@ MYSQL_BIN_LOG::write_transaction_or_stmt(group_commit_entry *entry,
     DBUG_RETURN(ER_ERROR_ON_WRITE);
 
   if (entry->using_stmt_cache && !mngr->stmt_cache.empty() &&
-      write_cache(entry->thd, mngr->get_binlog_cache_log(FALSE)))
+      (mngr->stmt_cache.payload ?
+       write_cache_payload(entry->thd, &mngr->stmt_cache) :
+       write_cache(entry->thd, mngr->get_binlog_cache_log(FALSE))))
   {
     entry->error_cache= &mngr->stmt_cache.cache_log;
     DBUG_RETURN(ER_ERROR_ON_WRITE);
@@ -8490,7 +9059,9 @@ MYSQL_BIN_LOG::write_transaction_or_stmt(group_commit_entry *entry,
                       DBUG_SUICIDE();
                     });
 
-    if (write_cache(entry->thd, mngr->get_binlog_cache_log(TRUE)))
+    if (mngr->trx_cache.payload ?
+        write_cache_payload(entry->thd, &mngr->trx_cache) :
+        write_cache(entry->thd, mngr->get_binlog_cache_log(TRUE)))
     {
       entry->error_cache= &mngr->trx_cache.cache_log;
       DBUG_RETURN(ER_ERROR_ON_WRITE);
@@ -8749,6 +9320,7 @@ void MYSQL_BIN_LOG::close(uint exiting)
   DBUG_PRINT("enter",("exiting: %d", (int) exiting));
 
   mysql_mutex_assert_owner(&LOCK_log);
+  wait_for_binlog_sync();
 
   if (log_state == LOG_OPENED)
   {
@@ -8790,6 +9362,13 @@ void MYSQL_BIN_LOG::close(uint exiting)
     }
 #endif /* HAVE_REPLICATION */
 
+    if (!is_relay_log)
+    {
+      if (binlog_dump_cache.enabled())
+        binlog_dump_cache.reset("", 0);
+      binlog_gtid_index.close();
+    }
+
     /* don't pwrite in a file opened with O_APPEND - it doesn't work */
     if (log_file.type == WRITE_CACHE && !(exiting & LOG_CLOSE_DELAYED_CLOSE))
     {
@@ -10896,6 +11475,10 @@ TC_LOG_BINLOG::set_status_variables(THD *thd)
   binlog_status_group_commit_trigger_timeout= this->group_commit_trigger_timeout;
   binlog_status_group_commit_trigger_lock_wait= this->group_commit_trigger_lock_wait;
   mysql_mutex_unlock(&LOCK_prepare_ordered);
+  binlog_status_group_commit_pipelined= this->group_commit_pipelined;
+  binlog_status_group_commit_pipeline_sync_wait=
+    this->group_commit_pipeline_sync_wait;
+  binlog_status_dump_cache_hits= binlog_dump_cache_hits;
 
   if (have_snapshot)
   {
@@ -493,6 +493,12 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   /* LOCK_log and LOCK_index are inited by init_pthread_objects() */
   mysql_mutex_t LOCK_index;
   mysql_mutex_t LOCK_binlog_end_pos;
+  /*
+    Held by a group commit leader from the end of its binlog write until its
+    sync of the binlog is done, when binlog_commit_pipeline is set. Taken
+    after LOCK_log and before LOCK_after_binlog_sync.
+  */
+  mysql_mutex_t LOCK_binlog_sync;
   mysql_mutex_t LOCK_xid_list;
   mysql_cond_t  COND_xid_list;
   mysql_cond_t  COND_relay_log_updated, COND_bin_log_updated;
@@ -541,6 +547,12 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   /* The reason why the group commit was grouped */
   ulonglong group_commit_trigger_count, group_commit_trigger_timeout;
   ulonglong group_commit_trigger_lock_wait;
+  /*
+    Number of group commits that synced the binlog without LOCK_log, and
+    how many of them had to wait for the sync of the previous group.
+  */
+  Atomic_counter<ulonglong> group_commit_pipelined;
+  Atomic_counter<ulonglong> group_commit_pipeline_sync_wait;
 
   /* binlog encryption data */
   struct Binlog_crypt_data crypto;
@@ -774,7 +786,10 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   }
   void update_binlog_end_pos(my_off_t pos)
   {
-    mysql_mutex_assert_owner(&LOCK_log);
+#ifdef SAFE_MUTEX
+    DBUG_ASSERT(mysql_mutex_is_owner(&LOCK_log) ||
+                mysql_mutex_is_owner(&LOCK_binlog_sync));
+#endif
     mysql_mutex_assert_not_owner(&LOCK_binlog_end_pos);
     lock_binlog_end_pos();
     /*
@@ -816,6 +831,7 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   bool write_incident(THD *thd);
   void write_binlog_checkpoint_event_already_locked(const char *name, uint len);
   int  write_cache(THD *thd, IO_CACHE *cache);
+  bool write_cache_payload(THD *thd, binlog_cache_data *cache_data);
   void set_write_error(THD *thd, bool is_transactional);
   bool check_write_error(THD *thd);
 
@@ -853,6 +869,7 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
      @retval other Failure
   */
   bool flush_and_sync(bool *synced);
+  void wait_for_binlog_sync();
   int purge_logs(const char *to_log, bool included,
                  bool need_mutex, bool need_update_threads,
                  ulonglong *decrease_log_space);
@@ -1147,6 +1164,7 @@ bool flush_error_log();
 
 File open_binlog(IO_CACHE *log, const char *log_file_name,
                  const char **errmsg);
+void use_binlog_dump_cache(IO_CACHE *log);
 
 void make_default_log_name(char **out, const char* log_ext, bool once);
 void binlog_reset_cache(THD *thd);
@@ -53,6 +53,12 @@
 #include "rpl_constants.h"
 #include "sql_digest.h"
 #include "zlib.h"
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#ifndef ZSTD_CLEVEL_DEFAULT
+#define ZSTD_CLEVEL_DEFAULT 3
+#endif
+#endif
 
 #define my_b_write_string(A, B) my_b_write((A), (uchar*)(B), (uint) (sizeof(B) - 1))
 
@@ -274,8 +280,8 @@ char *str_to_hex(char *to, const char *from, size_t len)
   Compressed Record
     Record Header: 1 Byte
              7 Bit: Always 1, mean compressed;
-           4-6 Bit: Compressed algorithm - Always 0, means zlib
-                    It maybe support other compression algorithm in the future.
+           4-6 Bit: Compressed algorithm - 0 means zlib, 1 means zstd.
+                    zstd is only used for Transaction_payload_log_event.
            0-3 Bit: Bytes of "Record Original Length"
     Record Original Length: 1-4 Bytes
     Compressed Buf:
@@ -285,8 +291,14 @@ char *str_to_hex(char *to, const char *from, size_t len)
   Get the length of compress content.
 */
 
-uint32 binlog_get_compress_len(uint32 len)
+uint32 binlog_get_compress_len(uint32 len, uint alg)
 {
+#ifdef HAVE_ZSTD
+    if (alg == BINLOG_COMPRESS_ZSTD)
+      return ALIGN_SIZE((BINLOG_COMPRESSED_HEADER_LEN + BINLOG_COMPRESSED_ORIGINAL_LENGTH_MAX_BYTES)
+                        + (uint32) ZSTD_compressBound(len) + 1);
+#endif
+    DBUG_ASSERT(alg == BINLOG_COMPRESS_ZLIB);
     /* 5 for the begin content, 1 reserved for a '\0'*/
     return ALIGN_SIZE((BINLOG_COMPRESSED_HEADER_LEN + BINLOG_COMPRESSED_ORIGINAL_LENGTH_MAX_BYTES) 
                         + compressBound(len) + 1);
@@ -300,10 +312,13 @@ uint32 binlog_get_compress_len(uint32 len)
       the content uncompressed.
          2) The 'comlen' should stored the length of 'dst', and it will
       be set as the size of compressed content after return.
+         3) 'alg' is BINLOG_COMPRESS_ZLIB or, if the server was built
+      with it, BINLOG_COMPRESS_ZSTD.
 
    return zero if successful, others otherwise.
 */
-int binlog_buf_compress(const char *src, char *dst, uint32 len, uint32 *comlen)
+int binlog_buf_compress(const char *src, char *dst, uint32 len, uint32 *comlen,
+                        uint alg)
 {
   uchar lenlen;
   if (len & 0xFF000000)
@@ -332,7 +347,21 @@ int binlog_buf_compress(const char *src, char *dst, uint32 len, uint32 *comlen)
     dst[1] = uchar(len);
     lenlen = 1;
   }
-  dst[0] = 0x80 | (lenlen & 0x07);
+  dst[0] = 0x80 | (uchar) ((alg & 0x07) << 4) | (lenlen & 0x07);
+
+#ifdef HAVE_ZSTD
+  if (alg == BINLOG_COMPRESS_ZSTD)
+  {
+    size_t zlen= ZSTD_compress(dst + BINLOG_COMPRESSED_HEADER_LEN + lenlen,
+                               *comlen - BINLOG_COMPRESSED_HEADER_LEN -
+                               lenlen - 1, src, len, ZSTD_CLEVEL_DEFAULT);
+    if (ZSTD_isError(zlen))
+      return 1;
+    *comlen = (uint32)zlen + BINLOG_COMPRESSED_HEADER_LEN + lenlen;
+    return 0;
+  }
+#endif
+  DBUG_ASSERT(alg == BINLOG_COMPRESS_ZLIB);
 
   uLongf tmplen = (uLongf)*comlen - BINLOG_COMPRESSED_HEADER_LEN - lenlen - 1;
   if (compress((Bytef *)dst + BINLOG_COMPRESSED_HEADER_LEN + lenlen, &tmplen,
@@ -566,6 +595,81 @@ row_log_event_uncompress(const Format_description_log_event *description_event,
   return 0;
 }
 
+/**
+   Expand a TRANSACTION_PAYLOAD_EVENT in 'src' into the events it holds.
+
+   The events are returned in 'dst' one after another, as they would have
+   been written to the binlog without compression: with a checksum if
+   'contain_checksum', and with the end_log_pos of the payload event.
+
+   @Note: The caller should call my_free to release 'dst'.
+
+   return zero if successful, non-zero otherwise.
+*/
+
+int
+transaction_payload_uncompress(const Format_description_log_event *description_event,
+                               bool contain_checksum, const char *src,
+                               ulong src_len, char **dst, ulong *newlen)
+{
+  ulong len= uint4korr(src + EVENT_LEN_OFFSET);
+  uint32 log_pos= uint4korr(src + LOG_POS_OFFSET);
+  uint checksum_len= contain_checksum ? BINLOG_CHECKSUM_LEN : 0;
+  const char *tmp= src + description_event->common_header_len +
+    TRANSACTION_PAYLOAD_HEADER_LEN;
+  char *events, *ev, *ev_end, *to;
+  ulong count= 0;
+
+  // bad event
+  if (src_len < len || len <= (ulong) (tmp - src) + checksum_len)
+    return 1;
+
+  DBUG_ASSERT((uchar)src[EVENT_TYPE_OFFSET] == TRANSACTION_PAYLOAD_EVENT);
+
+  uint32 comp_len= (uint32) (len - (tmp - src) - checksum_len);
+  uint32 un_len= binlog_get_uncompress_len(tmp);
+  // bad event
+  if (un_len == 0)
+    return 1;
+
+  if (!(events= (char *) my_malloc(PSI_INSTRUMENT_ME, un_len, MYF(MY_WME))))
+    return 1;
+  if (binlog_buf_uncompress(tmp, events, comp_len, &un_len))
+    goto err;
+
+  /* Check that the events fill the buffer exactly */
+  ev_end= events + un_len;
+  for (ev= events; ev < ev_end; ev+= uint4korr(ev + EVENT_LEN_OFFSET))
+  {
+    if (ev_end - ev < LOG_EVENT_MINIMAL_HEADER_LEN ||
+        uint4korr(ev + EVENT_LEN_OFFSET) < LOG_EVENT_MINIMAL_HEADER_LEN ||
+        uint4korr(ev + EVENT_LEN_OFFSET) > (ulong) (ev_end - ev))
+      goto err;
+    count++;
+  }
+
+  *newlen= un_len + count * checksum_len;
+  if (!(*dst= (char *) my_malloc(PSI_INSTRUMENT_ME, *newlen, MYF(MY_WME))))
+    goto err;
+  for (ev= events, to= *dst; ev < ev_end; )
+  {
+    uint32 ev_len= uint4korr(ev + EVENT_LEN_OFFSET);
+    memcpy(to, ev, ev_len);
+    int4store(to + EVENT_LEN_OFFSET, ev_len + checksum_len);
+    int4store(to + LOG_POS_OFFSET, log_pos);
+    if (contain_checksum)
+      int4store(to + ev_len, my_checksum(0L, (uchar *) to, ev_len));
+    ev+= ev_len;
+    to+= ev_len + checksum_len;
+  }
+  my_free(events);
+  return 0;
+
+err:
+  my_free(events);
+  return 1;
+}
+
 /**
   Get the length of uncompress content.
   return 0 means error.
@@ -636,9 +740,19 @@ int binlog_buf_uncompress(const char *src, char *dst, uint32 len,
       return 1;
     }
     break;
+#ifdef HAVE_ZSTD
+  case BINLOG_COMPRESS_ZSTD:
+  {
+    size_t zlen= ZSTD_decompress(dst, *newlen, src + 1 + lenlen,
+                                 len - 1 - lenlen);
+    if (ZSTD_isError(zlen))
+      return 1;
+    buflen= (uLongf) zlen;
+    break;
+  }
+#endif
   default:
-    //TODO
-    //bad algorithm
+    // bad algorithm, or zstd in a build without it
     return 1;
   }
 
@@ -705,6 +819,7 @@ const char* Log_event::get_type_str(Log_event_type type)
   case TRANSACTION_CONTEXT_EVENT: return "Transaction_context";
   case VIEW_CHANGE_EVENT: return "View_change";
   case XA_PREPARE_LOG_EVENT: return "XA_prepare";
+  case TRANSACTION_PAYLOAD_EVENT: return "Transaction_payload";
   case QUERY_COMPRESSED_EVENT: return "Query_compressed";
   case WRITE_ROWS_COMPRESSED_EVENT: return "Write_rows_compressed";
   case UPDATE_ROWS_COMPRESSED_EVENT: return "Update_rows_compressed";
@@ -1081,11 +1196,13 @@ Log_event* Log_event::read_log_event(const char* buf, uint event_len,
   }
 
   if (event_type > fdle->number_of_event_types &&
-      event_type != FORMAT_DESCRIPTION_EVENT)
+      event_type != FORMAT_DESCRIPTION_EVENT &&
+      event_type != TRANSACTION_PAYLOAD_EVENT)
   {
     /*
       It is unsafe to use the fdle if its post_header_len
-      array does not include the event type.
+      array does not include the event type. TRANSACTION_PAYLOAD_EVENT
+      does not use it, see LOG_EVENT_TYPES.
     */
     DBUG_PRINT("error", ("event type %d found, but the current "
                          "Format_description_log_event supports only %d event "
@@ -1152,6 +1269,9 @@ Log_event* Log_event::read_log_event(const char* buf, uint event_len,
     case BINLOG_CHECKPOINT_EVENT:
       ev = new Binlog_checkpoint_log_event(buf, event_len, fdle);
       break;
+    case TRANSACTION_PAYLOAD_EVENT:
+      ev = new Transaction_payload_log_event(buf, event_len, fdle);
+      break;
     case GTID_EVENT:
       ev = new Gtid_log_event(buf, event_len, fdle);
       break;
@@ -2561,14 +2681,34 @@ Binlog_checkpoint_log_event::Binlog_checkpoint_log_event(
 }
 
 
+/**************************************************************************
+  Transaction_payload_log_event methods
+**************************************************************************/
+
+Transaction_payload_log_event::Transaction_payload_log_event(
+       const char *buf, uint event_len,
+       const Format_description_log_event *description_event)
+  :Log_event(buf, description_event), payload(0), payload_len(0)
+{
+  uint8 header_size= description_event->common_header_len;
+  uint8 post_header_len= TRANSACTION_PAYLOAD_HEADER_LEN;
+  if (event_len <= (uint) header_size + (uint) post_header_len)
+    return;
+  payload_len= event_len - header_size - post_header_len;
+  payload= buf + header_size + post_header_len;
+}
+
+
 /**************************************************************************
         Global transaction ID stuff
 **************************************************************************/
 
 Gtid_log_event::Gtid_log_event(const char *buf, uint event_len,
                const Format_description_log_event *description_event)
-  : Log_event(buf, description_event), seq_no(0), commit_id(0)
+  : Log_event(buf, description_event), seq_no(0), commit_id(0),
+    flags_extra(0), writeset(NULL), writeset_count(0), writeset_buf(NULL)
 {
+  const char *buf_0= buf;
   uint8 header_size= description_event->common_header_len;
   uint8 post_header_len= description_event->post_header_len[GTID_EVENT-1];
   if (event_len < (uint) header_size + (uint) post_header_len ||
@@ -2604,6 +2744,34 @@ Gtid_log_event::Gtid_log_event(const char *buf, uint event_len,
     memcpy(xid.data, buf, data_length);
     buf+= data_length;
   }
+  /* Older masters leave zeroes here, or nothing at all */
+  if (event_len > (uint) (buf - buf_0))
+    flags_extra= *(buf++);
+  if (flags_extra & FL_EXTRA_WRITESET)
+  {
+    uint16 count;
+    if (event_len < (uint) (buf - buf_0) + 2)
+    {
+      seq_no= 0;                                // So is_valid() returns false
+      return;
+    }
+    count= uint2korr(buf);
+    buf+= 2;
+    if (event_len < (uint) (buf - buf_0) + 4 * count)
+    {
+      seq_no= 0;
+      return;
+    }
+    if (count &&
+        !(writeset_buf= (uchar *) my_memdup(PSI_INSTRUMENT_ME, buf, 4 * count,
+                                            MYF(MY_WME))))
+    {
+      seq_no= 0;
+      return;
+    }
+    writeset= writeset_buf;
+    writeset_count= count;
+  }
 }
 
 
@@ -3178,7 +3346,7 @@ Rows_log_event::Rows_log_event(const char *buf, uint event_len,
 #if !defined(MYSQL_CLIENT) && defined(HAVE_REPLICATION)
     , m_curr_row(NULL), m_curr_row_end(NULL),
     m_key(NULL), m_key_info(NULL), m_key_nr(0),
-    master_had_triggers(0)
+    master_had_triggers(0), m_hash_scan(NULL)
 #endif
 {
   DBUG_ENTER("Rows_log_event::Rows_log_event(const char*,...)");
@@ -223,6 +223,7 @@ class String;
 #define GTID_LIST_HEADER_LEN   4
 #define START_ENCRYPTION_HEADER_LEN 0
 #define XA_PREPARE_HEADER_LEN 0
+#define TRANSACTION_PAYLOAD_HEADER_LEN 0
 
 /* 
   Max number of possible extra bytes in a replication event compared to a
@@ -571,9 +572,13 @@ class String;
 #define MARIA_SLAVE_CAPABILITY_BINLOG_CHECKPOINT 3
 /* MariaDB >= 10.0.1, which knows about global transaction id events. */
 #define MARIA_SLAVE_CAPABILITY_GTID 4
+/* Knows about the writeset in Gtid_log_event, see FL_EXTRA_WRITESET. */
+#define MARIA_SLAVE_CAPABILITY_WRITESET 5
+/* Knows about Transaction_payload_log_event. */
+#define MARIA_SLAVE_CAPABILITY_TRANSACTION_PAYLOAD 6
 
 /* Our capability. */
-#define MARIA_SLAVE_CAPABILITY_MINE MARIA_SLAVE_CAPABILITY_GTID
+#define MARIA_SLAVE_CAPABILITY_MINE MARIA_SLAVE_CAPABILITY_TRANSACTION_PAYLOAD
 
 
 /**
@@ -718,6 +723,13 @@ enum Log_event_type
   UPDATE_ROWS_COMPRESSED_EVENT = 170,
   DELETE_ROWS_COMPRESSED_EVENT = 171,
 
+  /*
+    The binlog cache of an event group, compressed into one event, see
+    Transaction_payload_log_event. Not in the post-header table of
+    Format_description_log_event, see LOG_EVENT_TYPES.
+  */
+  TRANSACTION_PAYLOAD_EVENT = 172,
+
   /* Add new MariaDB events here - right above this comment!  */
 
   ENUM_END_EVENT /* end marker */
@@ -790,8 +802,11 @@ static inline bool LOG_EVENT_IS_ROW_V2(enum Log_event_type type)
    The number of types we handle in Format_description_log_event (UNKNOWN_EVENT
    is not to be handled, it does not exist in binlogs, it does not have a
    format).
+   Events after DELETE_ROWS_COMPRESSED_EVENT have a fixed post-header length
+   and are left out, so that the Format_description_log_event of old binlogs
+   and of new ones stays the same.
 */
-#define LOG_EVENT_TYPES (ENUM_END_EVENT-1)
+#define LOG_EVENT_TYPES DELETE_ROWS_COMPRESSED_EVENT
 
 enum Int_event_type
 {
@@ -3511,6 +3526,51 @@ class Binlog_checkpoint_log_event: public Log_event
 };
 
 
+/**
+  @class Transaction_payload_log_event
+
+  The events of the binlog cache of an event group, compressed together.
+  It is logged between the Gtid_log_event and the terminating event of the
+  group when log_bin_compress_transactions is enabled.
+
+  @section Transaction_payload_log_event_binary_format Binary Format
+
+  The post-header is empty. The body is a compressed record as written by
+  binlog_buf_compress(), of the events as they are in the binlog cache:
+  without checksum, and with end_log_pos relative to the start of the
+  cache.
+
+  The slave IO thread and mysqlbinlog expand the event into the events it
+  holds, see transaction_payload_uncompress(); it is never written to a
+  relay log.
+*/
+
+class Transaction_payload_log_event: public Log_event
+{
+public:
+  const char *payload;
+  uint32 payload_len;
+
+#ifdef MYSQL_SERVER
+  Transaction_payload_log_event(THD *thd_arg, const char *payload_arg,
+                                uint32 payload_len_arg);
+#ifdef HAVE_REPLICATION
+  void pack_info(Protocol *protocol);
+#endif
+#else
+  bool print(FILE *file, PRINT_EVENT_INFO *print_event_info);
+#endif
+  Transaction_payload_log_event(const char *buf, uint event_len,
+             const Format_description_log_event *description_event);
+  Log_event_type get_type_code() { return TRANSACTION_PAYLOAD_EVENT; }
+  int get_data_size() { return payload_len + TRANSACTION_PAYLOAD_HEADER_LEN; }
+  bool is_valid() const { return payload != 0; }
+#ifdef MYSQL_SERVER
+  bool write();
+#endif
+};
+
+
 /**
   @class Gtid_log_event
 
@@ -3570,6 +3630,20 @@ class Binlog_checkpoint_log_event: public Log_event
         group commit). OR commit id, same for all GTIDs in the same group
         commit (see flags bit 1).</td>
   </tr>
+
+  <tr>
+    <td>flags_extra</td>
+    <td>1 byte bitfield, optional</td>
+    <td>Follows the commit id and any XA data. Bit 7 set indicates that a
+        writeset follows. Read as 0 from the reserved bytes when absent.</td>
+  </tr>
+
+  <tr>
+    <td>writeset</td>
+    <td>2 byte count, then 4 bytes per entry (see flags_extra bit 7)</td>
+    <td>Hashes of the primary and unique keys of the rows changed by the
+        event group.</td>
+  </tr>
   </table>
 
   The Body of Gtid_log_event is empty. The total event size is 19 bytes +
@@ -3619,6 +3693,21 @@ class Gtid_log_event: public Log_event
   /* FL_"COMMITTED or ROLLED-BACK"_XA is set for XA transaction. */
   static const uchar FL_COMPLETED_XA= 128;
 
+  uchar flags_extra;
+  /* Flags_extra. */
+
+  /*
+    FL_EXTRA_WRITESET is set when the event lists the hashes of the row keys
+    changed by the event group (see --binlog-writeset-max-keys). The low bits
+    are left to the flags_extra values of other MariaDB versions. The
+    writeset is only sent to slaves with MARIA_SLAVE_CAPABILITY_WRITESET.
+  */
+  static const uchar FL_EXTRA_WRITESET= 128;
+
+  /* Writeset hashes, 4 bytes each in little-endian byte order. */
+  const uchar *writeset;
+  uint16 writeset_count;
+
 #ifdef MYSQL_SERVER
   Gtid_log_event(THD *thd_arg, uint64 seq_no, uint32 domain_id, bool standalone,
                  uint16 flags, bool is_transactional, uint64 commit_id);
@@ -3633,7 +3722,7 @@ class Gtid_log_event: public Log_event
 #endif
   Gtid_log_event(const char *buf, uint event_len,
                  const Format_description_log_event *description_event);
-  ~Gtid_log_event() { }
+  ~Gtid_log_event() { my_free(writeset_buf); }
   Log_event_type get_type_code() { return GTID_EVENT; }
   enum_logged_status logged_status() { return LOGGED_NO_DATA; }
   int get_data_size()
@@ -3645,11 +3734,23 @@ class Gtid_log_event: public Log_event
   bool write();
   static int make_compatible_event(String *packet, bool *need_dummy_event,
                                     ulong ev_offset, enum enum_binlog_checksum_alg checksum_alg);
+  static int strip_writeset(String *packet, ulong ev_offset,
+                            enum enum_binlog_checksum_alg checksum_alg);
   static bool peek(const char *event_start, size_t event_len,
                    enum enum_binlog_checksum_alg checksum_alg,
                    uint32 *domain_id, uint32 *server_id, uint64 *seq_no,
                    uchar *flags2, const Format_description_log_event *fdev);
+  void set_writeset(const uchar *hashes, uint16 count)
+  {
+    flags_extra|= FL_EXTRA_WRITESET;
+    writeset= hashes;
+    writeset_count= count;
+  }
 #endif
+
+private:
+  /* Copy of the writeset owned by an event read from a log */
+  uchar *writeset_buf;
 };
 
 
@@ -5165,9 +5266,12 @@ class Rows_log_event : public Log_event
   KEY      *m_key_info; /* Pointer to KEY info for m_key_nr */
   uint      m_key_nr;   /* Key number */
   bool master_had_triggers;     /* set after tables opening */
+  class Rows_hash_scan *m_hash_scan; /* Rows located by hash_scan_rows() */
 
   int find_key(); // Find a best key to use in find_row()
   int find_row(rpl_group_info *);
+  int hash_scan_rows(rpl_group_info *);
+  void end_hash_scan();
   int write_row(rpl_group_info *, const bool);
   int update_sequence();
 
@@ -5765,9 +5869,19 @@ enum Log_event_type wsrep_peak_event(rpl_group_info *rgi, ulonglong* event_size)
 */
 
 
-int binlog_buf_compress(const char *src, char *dst, uint32 len, uint32 *comlen);
+/* Compressed record algorithms, see binlog_buf_compress() */
+#define BINLOG_COMPRESS_ZLIB 0
+#define BINLOG_COMPRESS_ZSTD 1
+
+int binlog_buf_compress(const char *src, char *dst, uint32 len, uint32 *comlen,
+                        uint alg= BINLOG_COMPRESS_ZLIB);
 int binlog_buf_uncompress(const char *src, char *dst, uint32 len, uint32 *newlen);
-uint32 binlog_get_compress_len(uint32 len);
+uint32 binlog_get_compress_len(uint32 len, uint alg= BINLOG_COMPRESS_ZLIB);
+/* Name of the algorithm of the compressed record in 'buf' */
+static inline const char *binlog_compress_alg_name(const char *buf)
+{
+  return ((buf[0] & 0x70) >> 4) == BINLOG_COMPRESS_ZSTD ? "zstd" : "zlib";
+}
 uint32 binlog_get_uncompress_len(const char *buf);
 
 int query_event_uncompress(const Format_description_log_event *description_event, bool contain_checksum,
@@ -5778,4 +5892,8 @@ int row_log_event_uncompress(const Format_description_log_event *description_eve
                              const char *src, ulong src_len, char* buf, ulong buf_size, bool* is_malloc,
                              char **dst, ulong *newlen);
 
+int transaction_payload_uncompress(const Format_description_log_event *description_event,
+                                   bool contain_checksum, const char *src, ulong src_len,
+                                   char **dst, ulong *newlen);
+
 #endif /* _log_event_h */
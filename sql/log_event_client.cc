@@ -2283,6 +2283,24 @@ bool Binlog_checkpoint_log_event::print(FILE *file,
 }
 
 
+bool Transaction_payload_log_event::print(FILE *file,
+                                          PRINT_EVENT_INFO *print_event_info)
+{
+  if (print_event_info->short_form)
+    return 0;
+
+  Write_on_release_cache cache(&print_event_info->head_cache, file,
+                               Write_on_release_cache::FLUSH_F);
+
+  if (print_header(&cache, print_event_info, FALSE) ||
+      my_b_printf(&cache, "\tTransaction payload %s, %u -> %u bytes\n",
+                  binlog_compress_alg_name(payload),
+                  binlog_get_uncompress_len(payload), payload_len))
+    return 1;
+  return cache.flush_data();
+}
+
+
 bool
 Gtid_list_log_event::print(FILE *file, PRINT_EVENT_INFO *print_event_info)
 {
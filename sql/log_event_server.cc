@@ -3243,6 +3243,39 @@ bool Binlog_checkpoint_log_event::write()
 }
 
 
+/**************************************************************************
+  Transaction_payload_log_event methods
+**************************************************************************/
+
+#if defined(HAVE_REPLICATION)
+void Transaction_payload_log_event::pack_info(Protocol *protocol)
+{
+  char buf[64];
+  size_t len= my_snprintf(buf, sizeof(buf), "%s, %u -> %u bytes",
+                          binlog_compress_alg_name(payload),
+                          binlog_get_uncompress_len(payload), payload_len);
+  protocol->store(buf, len, &my_charset_bin);
+}
+#endif
+
+
+Transaction_payload_log_event::Transaction_payload_log_event(
+        THD *thd_arg, const char *payload_arg, uint32 payload_len_arg)
+  :Log_event(thd_arg, 0, false),
+   payload(payload_arg), payload_len(payload_len_arg)
+{
+  cache_type= EVENT_NO_CACHE;
+}
+
+
+bool Transaction_payload_log_event::write()
+{
+  return write_header(payload_len) ||
+         write_data(payload, payload_len) ||
+         write_footer();
+}
+
+
 /**************************************************************************
         Global transaction ID stuff
 **************************************************************************/
@@ -3253,7 +3286,8 @@ Gtid_log_event::Gtid_log_event(THD *thd_arg, uint64 seq_no_arg,
                                uint64 commit_id_arg)
   : Log_event(thd_arg, flags_arg, is_transactional),
     seq_no(seq_no_arg), commit_id(commit_id_arg), domain_id(domain_id_arg),
-    flags2((standalone ? FL_STANDALONE : 0) | (commit_id_arg ? FL_GROUP_COMMIT_ID : 0))
+    flags2((standalone ? FL_STANDALONE : 0) | (commit_id_arg ? FL_GROUP_COMMIT_ID : 0)),
+    flags_extra(0), writeset(NULL), writeset_count(0), writeset_buf(NULL)
 {
   cache_type= Log_event::EVENT_NO_CACHE;
   bool is_tmp_table= thd_arg->lex->stmt_accessed_temp_table();
@@ -3326,7 +3360,7 @@ Gtid_log_event::peek(const char *event_start, size_t event_len,
 bool
 Gtid_log_event::write()
 {
-  uchar buf[GTID_HEADER_LEN+2+sizeof(XID)];
+  uchar buf[GTID_HEADER_LEN+2+sizeof(XID)+3];
   size_t write_len;
 
   int8store(buf, seq_no);
@@ -3351,13 +3385,25 @@ Gtid_log_event::write()
     write_len+= data_length;
   }
 
-  if (write_len < GTID_HEADER_LEN)
+  if (flags_extra)
+    buf[write_len++]= flags_extra;
+  if (flags_extra & FL_EXTRA_WRITESET)
   {
+    int2store(buf + write_len, writeset_count);
+    write_len+= 2;
+  }
+  size_t writeset_len= (flags_extra & FL_EXTRA_WRITESET) ? 4 * writeset_count : 0;
+
+  if (write_len + writeset_len < GTID_HEADER_LEN)
+  {
+    /* Any writeset entry makes the event long enough */
+    DBUG_ASSERT(!writeset_len);
     bzero(buf+write_len, GTID_HEADER_LEN-write_len);
     write_len= GTID_HEADER_LEN;
   }
-  return write_header(write_len) ||
+  return write_header(write_len + writeset_len) ||
          write_data(buf, write_len) ||
+         (writeset_len && write_data(writeset, writeset_len)) ||
          write_footer();
 }
 
@@ -3380,6 +3426,20 @@ Gtid_log_event::make_compatible_event(String *packet, bool *need_dummy_event,
   if (packet->length() - ev_offset < LOG_EVENT_HEADER_LEN + GTID_HEADER_LEN)
     return 1;
   flags2= (*packet)[ev_offset + LOG_EVENT_HEADER_LEN + 12];
+  if (!(flags2 & (FL_PREPARED_XA | FL_COMPLETED_XA)))
+  {
+    /* Drop any flags_extra and writeset, they mean nothing to old slaves */
+    size_t data_len= LOG_EVENT_HEADER_LEN + GTID_HEADER_LEN +
+      ((flags2 & FL_GROUP_COMMIT_ID) ? 2 : 0);
+    if (checksum_alg == BINLOG_CHECKSUM_ALG_CRC32)
+      data_len+= BINLOG_CHECKSUM_LEN;
+    if (packet->length() - ev_offset > data_len)
+    {
+      packet->length(ev_offset + data_len);
+      int4store((uchar *) packet->ptr() + ev_offset + EVENT_LEN_OFFSET,
+                data_len);
+    }
+  }
   if (flags2 & FL_STANDALONE)
   {
     if (*need_dummy_event)
@@ -3392,6 +3452,58 @@ Gtid_log_event::make_compatible_event(String *packet, bool *need_dummy_event,
 }
 
 
+/*
+  Remove the writeset from a GTID event for a slave that does not declare
+  MARIA_SLAVE_CAPABILITY_WRITESET. The event keeps its other flags_extra
+  and is padded to the minimum GTID event length, as written by a master
+  without binlog_writeset_max_keys.
+
+  Returns zero on success, 1 if the event is corrupt.
+*/
+int
+Gtid_log_event::strip_writeset(String *packet, ulong ev_offset,
+                               enum enum_binlog_checksum_alg checksum_alg)
+{
+  uchar *p= (uchar *) packet->ptr() + ev_offset;
+  size_t data_len= packet->length() - ev_offset;
+  size_t pos= LOG_EVENT_HEADER_LEN + 13;
+  size_t new_len;
+  uchar flags2;
+
+  if (checksum_alg == BINLOG_CHECKSUM_ALG_CRC32)
+    data_len-= BINLOG_CHECKSUM_LEN;
+  if (data_len < LOG_EVENT_HEADER_LEN + GTID_HEADER_LEN)
+    return 1;
+  flags2= p[LOG_EVENT_HEADER_LEN + 12];
+  if (flags2 & FL_GROUP_COMMIT_ID)
+    pos+= 8;
+  if (flags2 & (FL_PREPARED_XA | FL_COMPLETED_XA))
+  {
+    if (data_len < pos + 6)
+      return 1;
+    pos+= 6 + p[pos + 4] + p[pos + 5];
+  }
+  if (data_len <= pos || !(p[pos] & FL_EXTRA_WRITESET))
+    return data_len < pos;
+
+  p[pos++]&= (uchar) ~FL_EXTRA_WRITESET;
+  new_len= MY_MAX(pos, LOG_EVENT_HEADER_LEN + GTID_HEADER_LEN);
+  bzero(p + pos, new_len - pos);
+  if (checksum_alg == BINLOG_CHECKSUM_ALG_CRC32)
+  {
+    int4store(p + EVENT_LEN_OFFSET, new_len + BINLOG_CHECKSUM_LEN);
+    int4store(p + new_len, my_checksum(0, p, new_len));
+    packet->length(ev_offset + new_len + BINLOG_CHECKSUM_LEN);
+  }
+  else
+  {
+    int4store(p + EVENT_LEN_OFFSET, new_len);
+    packet->length(ev_offset + new_len);
+  }
+  return 0;
+}
+
+
 #ifdef HAVE_REPLICATION
 void
 Gtid_log_event::pack_info(Protocol *protocol)
@@ -5150,7 +5262,7 @@ Rows_log_event::Rows_log_event(THD *thd_arg, TABLE *tbl_arg, ulong tid,
 #ifdef HAVE_REPLICATION
     , m_curr_row(NULL), m_curr_row_end(NULL),
     m_key(NULL), m_key_info(NULL), m_key_nr(0),
-    master_had_triggers(0)
+    master_had_triggers(0), m_hash_scan(NULL)
 #endif
 {
   /*
@@ -7722,6 +7834,215 @@ static int row_not_found_error(rpl_group_info *rgi)
          ? HA_ERR_KEY_NOT_FOUND : HA_ERR_RECORD_CHANGED;
 }
 
+/**
+  Before images of an UPDATE or DELETE rows event and the table rows they
+  were matched with by Rows_log_event::hash_scan_rows().
+*/
+
+class Rows_hash_scan
+{
+  struct Row
+  {
+    ulong hash;
+    uchar *image;                       /* table->record[0] format */
+    uchar *ref;                         /* handler::ref of the match */
+  };
+
+  MEM_ROOT root;
+  HASH hash;
+  Dynamic_array<Row*> rows;
+  uint unmatched;
+  uint next;
+
+  static ulong record_hash(TABLE *table)
+  {
+    ulong nr1= 1, nr2= 4;
+    for (Field **ptr= table->field; *ptr; ptr++)
+      (*ptr)->hash(&nr1, &nr2);
+    return nr1;
+  }
+
+public:
+  Rows_hash_scan()
+    : rows(PSI_INSTRUMENT_MEM, 16, 16), unmatched(0), next(0)
+  {
+    init_alloc_root(PSI_INSTRUMENT_ME, &root, 8192, 0, MYF(0));
+    my_hash_clear(&hash);
+  }
+  ~Rows_hash_scan()
+  {
+    my_hash_free(&hash);
+    free_root(&root, MYF(0));
+  }
+
+  /**
+    Add the before image in table->record[0]
+
+    @return true on out of memory
+  */
+  bool add_row(TABLE *table)
+  {
+    Row *row;
+    if (!(row= (Row*) alloc_root(&root, sizeof(Row))) ||
+        !(row->image= (uchar*) memdup_root(&root, table->record[0],
+                                           table->s->reclength)))
+      return true;
+    row->hash= record_hash(table);
+    row->ref= NULL;
+
+    /* Blob data may be in a conversion buffer that the next row reuses */
+    for (uint i= 0; i < table->s->blob_fields; i++)
+    {
+      Field_blob *blob= (Field_blob*) table->field[table->s->blob_field[i]];
+      uint32 length;
+      uchar *data;
+      if (blob->is_null() || !(length= blob->get_length()))
+        continue;
+      if (!(data= (uchar*) memdup_root(&root, blob->get_ptr(), length)))
+        return true;
+      blob->set_ptr_offset(row->image - table->record[0], length, data);
+    }
+    unmatched++;
+    return rows.append(row);
+  }
+
+  /** @return true on out of memory */
+  bool init_hash()
+  {
+    if (my_hash_init(PSI_INSTRUMENT_ME, &hash, &my_charset_bin,
+                     rows.elements(), offsetof(Row, hash), sizeof(ulong),
+                     NULL, NULL, 0))
+      return true;
+    for (size_t i= 0; i < rows.elements(); i++)
+      if (my_hash_insert(&hash, (uchar*) rows.at(i)))
+        return true;
+    return false;
+  }
+
+  bool all_matched() const { return !unmatched; }
+
+  /**
+    Match the table row in table->record[0] with one of the before images
+    that has not been matched yet, and remember the row position for it.
+
+    @note
+      Uses table->record[1].
+  */
+  void match_row(TABLE *table)
+  {
+    ulong nr= record_hash(table);
+    HASH_SEARCH_STATE state;
+    for (Row *row= (Row*) my_hash_first(&hash, (uchar*) &nr, sizeof(nr),
+                                        &state);
+         row;
+         row= (Row*) my_hash_next(&hash, (uchar*) &nr, sizeof(nr), &state))
+    {
+      if (row->ref)
+        continue;
+      memcpy(table->record[1], row->image, table->s->reclength);
+      if (record_compare(table))
+        continue;
+      if (!(row->ref= (uchar*) alloc_root(&root, table->file->ref_length)))
+        return;                                 // Treated as not found
+      table->file->position(table->record[0]);
+      memcpy(row->ref, table->file->ref, table->file->ref_length);
+      unmatched--;
+      return;
+    }
+  }
+
+  /** The position of the table row matching the next before image */
+  const uchar *next_ref()
+  {
+    DBUG_ASSERT(next < rows.elements());
+    return rows.at(next++)->ref;
+  }
+};
+
+
+/**
+  Match all before images of the event with table rows in one table scan
+
+  Used instead of one table scan per row in find_row() when the table has
+  no key to locate the rows with. The before images are put into a hash,
+  and every row of the table is looked up there. find_row() then reads
+  the matched rows with rnd_pos(), in the order of the event.
+
+  The current row is unpacked again into table->record[0] and
+  table->record[1] after the scan.
+
+  @return Error code on failure of the table scan, 0 otherwise. If the
+  before images could not be collected m_hash_scan is left NULL and
+  find_row() falls back to scanning the table for each row.
+*/
+
+int Rows_log_event::hash_scan_rows(rpl_group_info *rgi)
+{
+  TABLE *table= m_table;
+  const uchar *curr_row= m_curr_row;
+  Rows_hash_scan *scan;
+  int error= 0;
+  DBUG_ENTER("Rows_log_event::hash_scan_rows");
+
+  if (!(scan= new Rows_hash_scan()))
+    DBUG_RETURN(0);
+
+  for (m_curr_row= m_rows_buf; m_curr_row < m_rows_end && !error; )
+  {
+    prepare_record(table, m_width, FALSE);
+    if ((error= unpack_current_row(rgi)))
+      break;
+    if (scan->add_row(table))
+      error= HA_ERR_OUT_OF_MEM;
+    else if (get_general_type_code() == UPDATE_ROWS_EVENT)
+    {
+      m_curr_row= m_curr_row_end;
+      error= unpack_current_row(rgi, &m_cols_ai);
+    }
+    m_curr_row= m_curr_row_end;
+  }
+
+  if (!error && !scan->init_hash())
+  {
+    m_hash_scan= scan;
+    statistic_increment(slave_rows_hash_scans, LOCK_status);
+    if (unlikely((error= table->file->ha_rnd_init_with_error(1))))
+      DBUG_PRINT("info",("error initializing table scan"
+                         " (ha_rnd_init returns %d)",error));
+    else
+    {
+      while (!scan->all_matched() &&
+             !(error= table->file->ha_rnd_next(table->record[0])))
+        scan->match_row(table);
+      table->file->ha_rnd_end();
+      if (error == HA_ERR_END_OF_FILE || scan->all_matched())
+        error= 0;
+      else
+        table->file->print_error(error, MYF(0));
+    }
+  }
+  else
+  {
+    /* Unpacking errors are reported for the row they happen in */
+    delete scan;
+    error= 0;
+  }
+
+  m_curr_row= curr_row;
+  prepare_record(table, m_width, FALSE);
+  unpack_current_row(rgi);
+  store_record(table, record[1]);
+  DBUG_RETURN(error);
+}
+
+
+void Rows_log_event::end_hash_scan()
+{
+  delete m_hash_scan;
+  m_hash_scan= NULL;
+}
+
+
 /**
   Locate the current row in event's table.
 
@@ -7981,6 +8302,34 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
     /* We use this to test that the correct key is used in test cases. */
     DBUG_EXECUTE_IF("slave_crash_if_table_scan", abort(););
 
+    if (!m_hash_scan && opt_slave_rows_hash_scan &&
+        m_curr_row == m_rows_buf && !table->versioned())
+    {
+      is_table_scan= true;
+      if (unlikely((error= hash_scan_rows(rgi))))
+        goto end;
+    }
+    if (m_hash_scan)
+    {
+      const uchar *ref= m_hash_scan->next_ref();
+      if (!ref)
+      {
+        DBUG_PRINT("info", ("Record not found"));
+        error= HA_ERR_END_OF_FILE;
+        goto end;
+      }
+      if (!table->file->inited &&
+          unlikely((error= table->file->ha_rnd_init_with_error(0))))
+        goto end;
+      if (unlikely((error= table->file->ha_rnd_pos(table->record[0],
+                                                   (uchar*) ref))))
+      {
+        table->file->print_error(error, MYF(0));
+        table->file->ha_rnd_end();
+      }
+      goto end;
+    }
+
     /* We don't have a key: search the table using rnd_next() */
     if (unlikely((error= table->file->ha_rnd_init_with_error(1))))
     {
@@ -8095,6 +8444,7 @@ Delete_rows_log_event::do_after_row_operations(const Slave_reporting_capability
   my_free(m_key);
   m_key= NULL;
   m_key_info= NULL;
+  end_hash_scan();
 
   return error;
 }
@@ -8245,6 +8595,7 @@ Update_rows_log_event::do_after_row_operations(const Slave_reporting_capability
   my_free(m_key); // Free for multi_malloc
   m_key= NULL;
   m_key_info= NULL;
+  end_hash_scan();
 
   return error;
 }
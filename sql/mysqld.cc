@@ -50,6 +50,7 @@
 #include "des_key_file.h" // load_des_key_file
 #include "sql_manager.h"  // stop_handle_manager, start_handle_manager
 #include "sql_expression_cache.h" // subquery_cache_miss, subquery_cache_hit
+#include "filesort.h"     // filesort_thread_pool_end
 #include "sys_vars_shared.h"
 
 #include <m_ctype.h>
@@ -357,6 +358,7 @@ static longlong start_memory_used;
 bool opt_bin_log, opt_bin_log_used=0, opt_ignore_builtin_innodb= 0;
 bool opt_bin_log_compress;
 uint opt_bin_log_compress_min_len;
+bool opt_bin_log_compress_transactions;
 my_bool opt_log, debug_assert_if_crashed_table= 0, opt_help= 0;
 my_bool debug_assert_on_not_freed_memory= 0;
 my_bool disable_log_notes, opt_support_flashback= 0;
@@ -435,6 +437,7 @@ ulong opt_binlog_rows_event_max_size;
 ulong binlog_row_metadata;
 my_bool opt_master_verify_checksum= 0;
 my_bool opt_slave_sql_verify_checksum= 1;
+my_bool opt_slave_rows_hash_scan= 0;
 const char *binlog_format_names[]= {"MIXED", "STATEMENT", "ROW", NullS};
 volatile sig_atomic_t calling_initgroups= 0; /**< Used in SIGSEGV handler. */
 uint mysqld_port, select_errors, dropping_tables, ha_open_options;
@@ -462,6 +465,10 @@ ulonglong slave_type_conversions_options;
 ulong thread_cache_size=0;
 ulonglong binlog_cache_size=0;
 ulonglong binlog_file_cache_size=0;
+ulonglong binlog_dump_cache_size=0;
+my_bool opt_binlog_gtid_index= TRUE;
+ulong opt_binlog_gtid_index_span_min= 65536;
+ulong binlog_gtid_index_hits;
 ulonglong max_binlog_cache_size=0;
 ulong slave_max_allowed_packet= 0;
 ulonglong binlog_stmt_cache_size=0;
@@ -483,6 +490,7 @@ uint max_password_errors;
 ulong extra_max_connections;
 uint max_digest_length= 0;
 ulong slave_retried_transactions;
+ulong slave_rows_hash_scans;
 ulong transactions_multi_engine;
 ulong rpl_transactions_multi_engine;
 ulong transactions_gtid_foreign_engine;
@@ -528,6 +536,8 @@ ulong opt_slave_domain_parallel_threads= 0;
 ulong opt_slave_parallel_mode;
 ulong opt_binlog_commit_wait_count= 0;
 ulong opt_binlog_commit_wait_usec= 0;
+ulong opt_binlog_writeset_max_keys= 0;
+my_bool opt_binlog_commit_pipeline= FALSE;
 ulong opt_slave_parallel_max_queued= 131072;
 my_bool opt_gtid_ignore_duplicates= FALSE;
 uint opt_gtid_cleanup_batch_size= 64;
@@ -857,7 +867,7 @@ PSI_file_key key_file_binlog,  key_file_binlog_cache, key_file_binlog_index,
 PSI_file_key key_file_query_log, key_file_slow_log;
 PSI_file_key key_file_relaylog, key_file_relaylog_index,
              key_file_relaylog_cache, key_file_relaylog_index_cache;
-PSI_file_key key_file_binlog_state;
+PSI_file_key key_file_binlog_state, key_file_binlog_gtid_index;
 
 #ifdef HAVE_PSI_INTERFACE
 #ifdef HAVE_MMAP
@@ -871,7 +881,7 @@ PSI_mutex_key key_LOCK_des_key_file;
 
 PSI_mutex_key key_BINLOG_LOCK_index, key_BINLOG_LOCK_xid_list,
   key_BINLOG_LOCK_binlog_background_thread,
-  key_LOCK_binlog_end_pos,
+  key_LOCK_binlog_end_pos, key_BINLOG_LOCK_binlog_sync,
   key_delayed_insert_mutex, key_hash_filo_lock, key_LOCK_active_mi,
   key_LOCK_crypt, key_LOCK_delayed_create,
   key_LOCK_delayed_insert, key_LOCK_delayed_status, key_LOCK_error_log,
@@ -932,6 +942,7 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_BINLOG_LOCK_xid_list, "MYSQL_BIN_LOG::LOCK_xid_list", 0},
   { &key_BINLOG_LOCK_binlog_background_thread, "MYSQL_BIN_LOG::LOCK_binlog_background_thread", 0},
   { &key_LOCK_binlog_end_pos, "MYSQL_BIN_LOG::LOCK_binlog_end_pos", 0 },
+  { &key_BINLOG_LOCK_binlog_sync, "MYSQL_BIN_LOG::LOCK_binlog_sync", 0},
   { &key_RELAYLOG_LOCK_index, "MYSQL_RELAY_LOG::LOCK_index", 0},
   { &key_LOCK_relaylog_end_pos, "MYSQL_RELAY_LOG::LOCK_binlog_end_pos", 0},
   { &key_delayed_insert_mutex, "Delayed_insert::mutex", 0},
@@ -1000,7 +1011,8 @@ PSI_rwlock_key key_rwlock_LOCK_grant, key_rwlock_LOCK_logger,
   key_rwlock_LOCK_vers_stats, key_rwlock_LOCK_stat_serial,
   key_rwlock_LOCK_ssl_refresh,
   key_rwlock_THD_list,
-  key_rwlock_LOCK_all_status_vars;
+  key_rwlock_LOCK_all_status_vars,
+  key_rwlock_BINLOG_dump_cache;
 
 static PSI_rwlock_info all_server_rwlocks[]=
 {
@@ -1018,7 +1030,8 @@ static PSI_rwlock_info all_server_rwlocks[]=
   { &key_rwlock_LOCK_stat_serial, "TABLE_SHARE::LOCK_stat_serial", 0},
   { &key_rwlock_LOCK_ssl_refresh, "LOCK_ssl_refresh", PSI_FLAG_GLOBAL },
   { &key_rwlock_THD_list, "THD_list::lock", PSI_FLAG_GLOBAL },
-  { &key_rwlock_LOCK_all_status_vars, "LOCK_all_status_vars", PSI_FLAG_GLOBAL }
+  { &key_rwlock_LOCK_all_status_vars, "LOCK_all_status_vars", PSI_FLAG_GLOBAL },
+  { &key_rwlock_BINLOG_dump_cache, "Binlog_dump_cache::lock", PSI_FLAG_GLOBAL }
 };
 
 #ifdef HAVE_MMAP
@@ -1426,6 +1439,7 @@ int deny_severity = LOG_WARNING;
 #endif
 #ifdef HAVE_QUERY_CACHE
 ulong query_cache_min_res_unit= QUERY_CACHE_MIN_RESULT_DATA_SIZE;
+uint query_cache_partitions= 1;
 Query_cache query_cache;
 #endif
 
@@ -1991,6 +2005,7 @@ static void clean_up(bool print_message)
   wt_end();
   multi_keycache_free();
   sp_cache_end();
+  filesort_thread_pool_end();
   free_status_vars();
   end_thr_alarm(1);			/* Free allocated memory */
   end_thr_timer();
@@ -5045,7 +5060,6 @@ static int init_server_components()
       MARIADB_REMOVED_OPTION("innodb-log-compressed-pages"),
       MARIADB_REMOVED_OPTION("innodb-log-files-in-group"),
       MARIADB_REMOVED_OPTION("innodb-log-optimize-ddl"),
-      MARIADB_REMOVED_OPTION("innodb-page-cleaners"),
       MARIADB_REMOVED_OPTION("innodb-replication-delay"),
       MARIADB_REMOVED_OPTION("innodb-scrub-log"),
       MARIADB_REMOVED_OPTION("innodb-scrub-log-speed"),
@@ -6481,7 +6495,9 @@ struct my_option my_long_options[]=
    "--slave-parallel-threads. Possible values: \"optimistic\" tries to "
    "apply most transactional DML in parallel, and handles any conflicts "
    "with rollback and retry. \"conservative\" limits parallelism in an "
-   "effort to avoid any conflicts. \"aggressive\" tries to maximise the "
+   "effort to avoid any conflicts. \"writeset\" also applies in parallel "
+   "transactions that the master logged with non-overlapping writesets "
+   "(see --binlog-writeset-max-keys). \"aggressive\" tries to maximise the "
    "parallelism, possibly at the cost of increased conflict rate. "
    "\"minimal\" only parallelizes the commit steps of transactions. "
    "\"none\" disables parallel apply completely.",
@@ -6586,6 +6602,29 @@ static int show_queries(THD *thd, SHOW_VAR *var, char *buff,
 }
 
 
+#ifdef HAVE_QUERY_CACHE
+/* Query cache statistics are summed over all query cache partitions */
+#define DEF_SHOW_QCACHE_FUNC(name)                                           \
+  static int show_qcache_##name(THD *thd, SHOW_VAR *var, char *buff,        \
+                                enum enum_var_type scope)                   \
+  {                                                                          \
+    var->type= SHOW_LONG;                                                    \
+    var->value= buff;                                                        \
+    *(ulong*) buff= (ulong) query_cache.get_status(&Query_cache::name);      \
+    return 0;                                                                \
+  }
+
+DEF_SHOW_QCACHE_FUNC(free_memory_blocks)
+DEF_SHOW_QCACHE_FUNC(free_memory)
+DEF_SHOW_QCACHE_FUNC(hits)
+DEF_SHOW_QCACHE_FUNC(inserts)
+DEF_SHOW_QCACHE_FUNC(lowmem_prunes)
+DEF_SHOW_QCACHE_FUNC(refused)
+DEF_SHOW_QCACHE_FUNC(queries_in_cache)
+DEF_SHOW_QCACHE_FUNC(total_blocks)
+#endif /* HAVE_QUERY_CACHE */
+
+
 static int show_net_compression(THD *thd, SHOW_VAR *var, char *buff,
                                 enum enum_var_type scope)
 {
@@ -7086,6 +7125,7 @@ SHOW_VAR status_vars[]= {
   {"Binlog_bytes_written",     (char*) offsetof(STATUS_VAR, binlog_bytes_written), SHOW_LONGLONG_STATUS},
   {"Binlog_cache_disk_use",    (char*) &binlog_cache_disk_use,  SHOW_LONG},
   {"Binlog_cache_use",         (char*) &binlog_cache_use,       SHOW_LONG},
+  {"Binlog_gtid_index_hits",   (char*) &binlog_gtid_index_hits, SHOW_LONG},
   {"Binlog_stmt_cache_disk_use",(char*) &binlog_stmt_cache_disk_use,  SHOW_LONG},
   {"Binlog_stmt_cache_use",    (char*) &binlog_stmt_cache_use,       SHOW_LONG},
   {"Busy_time",                (char*) offsetof(STATUS_VAR, busy_time), SHOW_DOUBLE_STATUS},
@@ -7160,6 +7200,7 @@ SHOW_VAR status_vars[]= {
   {"Handler_tmp_write",        (char*) offsetof(STATUS_VAR, ha_tmp_write_count), SHOW_LONG_STATUS},
   {"Handler_update",           (char*) offsetof(STATUS_VAR, ha_update_count), SHOW_LONG_STATUS},
   {"Handler_write",            (char*) offsetof(STATUS_VAR, ha_write_count), SHOW_LONG_STATUS},
+  {"Join_cache_spills",        (char*) offsetof(STATUS_VAR, join_cache_spills), SHOW_LONG_STATUS},
   {"Key",                      (char*) &show_default_keycache, SHOW_FUNC},
   {"Last_query_cost",          (char*) offsetof(STATUS_VAR, last_query_cost), SHOW_DOUBLE_STATUS},
   {"Max_statement_time_exceeded", (char*) offsetof(STATUS_VAR, max_statement_time_exceeded), SHOW_LONG_STATUS},
@@ -7204,14 +7245,14 @@ SHOW_VAR status_vars[]= {
   {"Rpl_semi_sync_slave_send_ack", (char*) &rpl_semi_sync_slave_send_ack, SHOW_LONGLONG},
 #endif /* HAVE_REPLICATION */
 #ifdef HAVE_QUERY_CACHE
-  {"Qcache_free_blocks",       (char*) &query_cache.free_memory_blocks, SHOW_LONG_NOFLUSH},
-  {"Qcache_free_memory",       (char*) &query_cache.free_memory, SHOW_LONG_NOFLUSH},
-  {"Qcache_hits",              (char*) &query_cache.hits,       SHOW_LONG},
-  {"Qcache_inserts",           (char*) &query_cache.inserts,    SHOW_LONG},
-  {"Qcache_lowmem_prunes",     (char*) &query_cache.lowmem_prunes, SHOW_LONG},
-  {"Qcache_not_cached",        (char*) &query_cache.refused,    SHOW_LONG},
-  {"Qcache_queries_in_cache",  (char*) &query_cache.queries_in_cache, SHOW_LONG_NOFLUSH},
-  {"Qcache_total_blocks",      (char*) &query_cache.total_blocks, SHOW_LONG_NOFLUSH},
+  {"Qcache_free_blocks",       (char*) &show_qcache_free_memory_blocks, SHOW_SIMPLE_FUNC},
+  {"Qcache_free_memory",       (char*) &show_qcache_free_memory, SHOW_SIMPLE_FUNC},
+  {"Qcache_hits",              (char*) &show_qcache_hits,       SHOW_SIMPLE_FUNC},
+  {"Qcache_inserts",           (char*) &show_qcache_inserts,    SHOW_SIMPLE_FUNC},
+  {"Qcache_lowmem_prunes",     (char*) &show_qcache_lowmem_prunes, SHOW_SIMPLE_FUNC},
+  {"Qcache_not_cached",        (char*) &show_qcache_refused,    SHOW_SIMPLE_FUNC},
+  {"Qcache_queries_in_cache",  (char*) &show_qcache_queries_in_cache, SHOW_SIMPLE_FUNC},
+  {"Qcache_total_blocks",      (char*) &show_qcache_total_blocks, SHOW_SIMPLE_FUNC},
 #endif /*HAVE_QUERY_CACHE*/
   {"Queries",                  (char*) &show_queries,            SHOW_SIMPLE_FUNC},
   {"Questions",                (char*) offsetof(STATUS_VAR, questions), SHOW_LONG_STATUS},
@@ -7231,12 +7272,14 @@ SHOW_VAR status_vars[]= {
   {"Slave_heartbeat_period",   (char*) &show_heartbeat_period, SHOW_SIMPLE_FUNC},
   {"Slave_received_heartbeats",(char*) &show_slave_received_heartbeats, SHOW_SIMPLE_FUNC},
   {"Slave_retried_transactions",(char*)&slave_retried_transactions, SHOW_LONG},
+  {"Slave_rows_hash_scans",    (char*) &slave_rows_hash_scans,  SHOW_LONG},
   {"Slave_running",            (char*) &show_slave_running,     SHOW_SIMPLE_FUNC},
   {"Slave_skipped_errors",     (char*) &slave_skipped_errors, SHOW_LONGLONG},
 #endif
   {"Slow_launch_threads",      (char*) &slow_launch_threads,    SHOW_LONG},
   {"Slow_queries",             (char*) offsetof(STATUS_VAR, long_query_count), SHOW_LONG_STATUS},
   {"Sort_merge_passes",	       (char*) offsetof(STATUS_VAR, filesort_merge_passes_), SHOW_LONG_STATUS},
+  {"Sort_parallel_chunks",     (char*) offsetof(STATUS_VAR, filesort_parallel_chunks_), SHOW_LONG_STATUS},
   {"Sort_priority_queue_sorts",(char*) offsetof(STATUS_VAR, filesort_pq_sorts_), SHOW_LONG_STATUS}, 
   {"Sort_range",	       (char*) offsetof(STATUS_VAR, filesort_range_count_), SHOW_LONG_STATUS},
   {"Sort_rows",		       (char*) offsetof(STATUS_VAR, filesort_rows_), SHOW_LONG_STATUS},
@@ -7556,6 +7599,8 @@ static int mysql_init_variables(void)
   report_user= report_password = report_host= 0;	/* TO BE DELETED */
   opt_relay_logname= opt_relaylog_index_name= 0;
   slave_retried_transactions= 0;
+  slave_rows_hash_scans= 0;
+  binlog_gtid_index_hits= 0;
   transactions_multi_engine= 0;
   rpl_transactions_multi_engine= 0;
   transactions_gtid_foreign_engine= 0;
@@ -8802,6 +8847,9 @@ void refresh_status(THD *thd)
 
   /* Reset some global variables */
   reset_status_vars();
+#ifdef HAVE_QUERY_CACHE
+  query_cache.reset_status();
+#endif
 #ifdef WITH_WSREP
   if (WSREP_ON)
   {
@@ -8860,7 +8908,8 @@ static PSI_file_info all_server_files[]=
   { &key_file_trg, "trigger_name", 0},
   { &key_file_trn, "trigger", 0},
   { &key_file_init, "init", 0},
-  { &key_file_binlog_state, "binlog_state", 0}
+  { &key_file_binlog_state, "binlog_state", 0},
+  { &key_file_binlog_gtid_index, "binlog_gtid_index", 0}
 };
 #endif /* HAVE_PSI_INTERFACE */
 
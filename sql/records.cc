@@ -37,6 +37,7 @@
 
 static int rr_quick(READ_RECORD *info);
 int rr_sequential(READ_RECORD *info);
+static int rr_sequential_batch(READ_RECORD *info);
 static int rr_from_tempfile(READ_RECORD *info);
 template<bool> static int rr_unpack_from_tempfile(READ_RECORD *info);
 template<bool,bool> static int rr_unpack_from_buffer(READ_RECORD *info);
@@ -178,6 +179,14 @@ bool init_read_record_idx(READ_RECORD *info, THD *thd, TABLE *table,
   --------------
     This is the most basic access method of a table using rnd_init,
     rnd_next and rnd_end. No indexes are used.
+
+    rr_sequential_batch:
+    --------------------
+      A variant of rr_sequential that can be enabled with
+      init_read_record_batch() when the caller never needs the handler
+      to be positioned on the current row. It fetches a number of rows
+      with one rnd_next_batch call into handler::batch_buffer and returns
+      them one by one.
 */
 
 bool init_read_record(READ_RECORD *info,THD *thd, TABLE *table,
@@ -544,6 +553,82 @@ static int rr_from_tempfile(READ_RECORD *info)
 } /* rr_from_tempfile */
 
 
+/**
+  Switch a table scan set up by init_read_record() to batched reads
+
+  @param info  READ_RECORD set up by init_read_record()
+
+  @note
+    The caller must not use the handler for the current row (position(),
+    unlock_row(), update_row() ...), as the engine has already moved on to
+    the end of the batch. The scan is left as it is if it is not a plain
+    table scan or if batched reads can't be used for the table.
+*/
+
+void init_read_record_batch(READ_RECORD *info)
+{
+  TABLE *table= info->table;
+  uint rows;
+
+  if (info->read_record_func != rr_sequential ||
+      table->s->tmp_table != NO_TMP_TABLE ||
+      table->s->blob_fields ||
+      table->reginfo.lock_type > TL_READ_NO_INSERT)
+    return;
+
+  rows= (uint) MY_MIN(info->thd->variables.read_buff_size /
+                      table->s->reclength, RR_BATCH_MAX_ROWS);
+  if (table->file->batch_buffer)
+    rows= MY_MIN(rows, table->file->batch_buffer_rows);
+  if (rows < 2 || table->file->alloc_batch_buffer(rows))
+    return;
+
+  info->reclength= table->s->reclength;
+  info->rec_cache_size= rows;
+  info->cache_pos= info->cache_end= table->file->batch_buffer;
+  info->batch_error= 0;
+  info->read_record_func= rr_sequential_batch;
+}
+
+
+static int rr_sequential_batch(READ_RECORD *info)
+{
+  TABLE *table= info->table;
+
+  if (info->cache_pos == info->cache_end)
+  {
+    uint rows;
+    int error;
+
+    if (info->batch_error)
+      return rr_handle_error(info, info->batch_error);
+    error= table->file->ha_rnd_next_batch(table->file->batch_buffer,
+                                          info->rec_cache_size, &rows);
+    if (!rows)
+    {
+      if (error == HA_ERR_WRONG_COMMAND)
+      {
+        /* The engine can't do it; continue row by row */
+        info->read_record_func= rr_sequential;
+        return rr_sequential(info);
+      }
+      return rr_handle_error(info, error);
+    }
+    info->batch_error= error;
+    info->cache_pos= table->file->batch_buffer;
+    info->cache_end= info->cache_pos + (size_t) rows * info->reclength;
+  }
+
+  memcpy(info->record(), info->cache_pos, info->reclength);
+  info->cache_pos+= info->reclength;
+  table->file->ha_rnd_next_batch_row();
+  table->status= 0;
+  if (table->vfield)
+    table->update_virtual_fields(table->file, VCOL_UPDATE_FOR_READ);
+  return 0;
+}
+
+
 /**
   Read a result set record from a temporary file after sorting.
 
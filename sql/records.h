@@ -60,6 +60,8 @@ struct READ_RECORD
   THD *thd;
   SQL_SELECT *select;
   uint ref_length, reclength, rec_cache_size, error_offset;
+  /* Error that ended the last batch of rr_sequential_batch() */
+  int batch_error;
 
   /**
     Counting records when reading result from filesort().
@@ -98,6 +100,7 @@ bool init_read_record(READ_RECORD *info, THD *thd, TABLE *reg_form,
                       bool print_errors, bool disable_rr_cache);
 bool init_read_record_idx(READ_RECORD *info, THD *thd, TABLE *table,
                           bool print_error, uint idx, bool reverse);
+void init_read_record_batch(READ_RECORD *info);
 
 void rr_unlock_row(st_join_table *tab);
 
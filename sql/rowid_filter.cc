@@ -30,6 +30,8 @@ double Range_rowid_filter_cost_info::lookup_cost(
   switch (cont_type) {
   case SORTED_ARRAY_CONTAINER:
     return log(est_elements)*0.01;
+  case BLOOM_FILTER_CONTAINER:
+    return BLOOM_FILTER_LOOKUP_COST;
   default:
     DBUG_ASSERT(0);
     return 0;
@@ -37,6 +39,19 @@ double Range_rowid_filter_cost_info::lookup_cost(
 }
 
 
+/**
+  @brief
+    The expected fraction of rowids not in a bloom filter that pass its check
+*/
+
+static double bloom_filter_false_positive_rate()
+{
+  return pow(1 - exp(-(double) BLOOM_FILTER_HASH_FUNCS /
+                     BLOOM_FILTER_BITS_PER_ELEM),
+             BLOOM_FILTER_HASH_FUNCS);
+}
+
+
 /**
   @brief
     The average gain in cost per row to use the range filter with this cost info
@@ -118,6 +133,8 @@ void Range_rowid_filter_cost_info::init(Rowid_filter_container_type cont_type,
   est_elements= (ulonglong) table->opt_range[key_no].rows;
   b= build_cost(container_type);
   selectivity= est_elements/((double) table->stat_records());
+  if (container_type == BLOOM_FILTER_CONTAINER)
+    selectivity+= (1 - selectivity) * bloom_filter_false_positive_rate();
   a= avg_access_and_eval_gain_per_row(container_type);
   if (a > 0)
     cross_x= b/a;
@@ -146,6 +163,9 @@ Range_rowid_filter_cost_info::build_cost(Rowid_filter_container_type cont_type)
     cost+= ARRAY_WRITE_COST * est_elements; /* cost filling the container */
     cost+= ARRAY_SORT_C * est_elements * log(est_elements); /* sorting cost */
     break;
+  case BLOOM_FILTER_CONTAINER:
+    cost+= BLOOM_FILTER_WRITE_COST * est_elements; /* cost filling the filter */
+    break;
   default:
     DBUG_ASSERT(0);
   }
@@ -165,6 +185,10 @@ Rowid_filter_container *Range_rowid_filter_cost_info::create_container()
     res= new (thd->mem_root) Rowid_filter_sorted_array((uint) est_elements,
                                                        elem_sz);
     break;
+  case BLOOM_FILTER_CONTAINER:
+    res= new (thd->mem_root) Rowid_filter_bloom_filter((uint) est_elements,
+                                                       elem_sz);
+    break;
   default:
     DBUG_ASSERT(0);
   }
@@ -315,6 +339,8 @@ get_max_range_rowid_filter_elems_for_table(
   switch (cont_type) {
   case SORTED_ARRAY_CONTAINER :
     return thd->variables.max_rowid_filter_size/tab->file->ref_length;
+  case BLOOM_FILTER_CONTAINER :
+    return thd->variables.max_rowid_filter_size*8/BLOOM_FILTER_BITS_PER_ELEM;
   default :
     DBUG_ASSERT(0);
     return 0;
@@ -347,7 +373,9 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
 {
   uint key_no;
   key_map usable_range_filter_keys;
+  key_map bloom_filter_keys;
   usable_range_filter_keys.clear_all();
+  bloom_filter_keys.clear_all();
   key_map::Iterator it(opt_range_keys);
 
   /*
@@ -355,6 +383,8 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
     - range filter pushdown is supported by the engine for them     (1)
     - they are not clustered primary                                (2)
     - the range filter containers for them are not too large        (3)
+    A sorted array is used as the container if it is small enough,
+    otherwise a bloom filter is used.
   */
   while ((key_no= it++) != key_map::Iterator::BITMAP_END)
   {
@@ -362,10 +392,16 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
       continue;
     if (file->is_clustering_key(key_no))                              // !2
       continue;
-   if (opt_range[key_no].rows >
-       get_max_range_rowid_filter_elems_for_table(thd, this,
-                                                  SORTED_ARRAY_CONTAINER)) // !3
-      continue;
+    if (opt_range[key_no].rows >
+        get_max_range_rowid_filter_elems_for_table(thd, this,
+                                                   SORTED_ARRAY_CONTAINER))
+    {
+      if (opt_range[key_no].rows >
+          get_max_range_rowid_filter_elems_for_table(thd, this,
+                                                     BLOOM_FILTER_CONTAINER)) // !3
+        continue;
+      bloom_filter_keys.set_bit(key_no);
+    }
     usable_range_filter_keys.set_bit(key_no);
   }
 
@@ -401,7 +437,10 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
   while ((key_no= li++) != key_map::Iterator::BITMAP_END)
   {
     *curr_ptr= curr_filter_cost_info;
-    curr_filter_cost_info->init(SORTED_ARRAY_CONTAINER, this, key_no);
+    curr_filter_cost_info->init(bloom_filter_keys.is_set(key_no) ?
+                                BLOOM_FILTER_CONTAINER :
+                                SORTED_ARRAY_CONTAINER,
+                                this, key_no);
     curr_ptr++;
     curr_filter_cost_info++;
   }
@@ -649,6 +688,88 @@ bool Rowid_filter_sorted_array::check(void *ctxt, char *elem)
 }
 
 
+Rowid_filter_bloom_filter::~Rowid_filter_bloom_filter()
+{
+  my_free(bits);
+  bits= 0;
+}
+
+
+bool Rowid_filter_bloom_filter::alloc()
+{
+  ulonglong n_bits= MY_MAX(max_elements, 1ULL) * BLOOM_FILTER_BITS_PER_ELEM;
+  n_blocks= (uint) ((n_bits + BLOCK_SIZE * 8 - 1) / (BLOCK_SIZE * 8));
+  bits= (uchar *) my_malloc(PSI_INSTRUMENT_ME, (size_t) n_blocks * BLOCK_SIZE,
+                            MYF(MY_ZEROFILL | MY_THREAD_SPECIFIC));
+  return bits == NULL;
+}
+
+
+/**
+  @brief
+    Get the block of a bloom filter where the bits of an element are placed
+
+  @param elem   rowid / primary key
+  @param h1     OUT: the first bit to probe in the block
+  @param h2     OUT: the distance between the probed bits in the block
+
+  @details
+    A single 32-bit hash of the element is spread by a multiplication.
+    The high half of the product selects the block, the remaining bits
+    define the double-hashing probe sequence within the block.
+*/
+
+inline uchar *
+Rowid_filter_bloom_filter::get_block(const char *elem, uint *h1, uint *h2) const
+{
+  uint32 hash= my_crc32c(0, elem, elem_size);
+  ulonglong x= hash * 0x9E3779B97F4A7C15ULL;
+  ulonglong block_no= ((x >> 32) * n_blocks) >> 32;
+  *h1= hash;
+  *h2= (uint) (x >> 7) | 1;
+  return bits + block_no * BLOCK_SIZE;
+}
+
+
+bool Rowid_filter_bloom_filter::add(void *ctxt, char *elem)
+{
+  uint h1, h2;
+  uchar *block= get_block(elem, &h1, &h2);
+  for (uint i= 0; i < BLOOM_FILTER_HASH_FUNCS; i++, h1+= h2)
+  {
+    uint bit= h1 % (BLOCK_SIZE * 8);
+    block[bit / 8]|= (uchar) (1 << (bit % 8));
+  }
+  return false;
+}
+
+
+/**
+  @brief
+    Check whether a rowid / primary key may be in the bloom filter
+
+  @param ctxt   context of the search (not used)
+  @param elem   rowid / primary key to look for
+
+  @retval
+    true    elem may be in the container
+    false   elem is definitely not in the container
+*/
+
+bool Rowid_filter_bloom_filter::check(void *ctxt, char *elem)
+{
+  uint h1, h2;
+  const uchar *block= get_block(elem, &h1, &h2);
+  for (uint i= 0; i < BLOOM_FILTER_HASH_FUNCS; i++, h1+= h2)
+  {
+    uint bit= h1 % (BLOCK_SIZE * 8);
+    if (!(block[bit / 8] & (1 << (bit % 8))))
+      return false;
+  }
+  return true;
+}
+
+
 Range_rowid_filter::~Range_rowid_filter()
 {
   delete container;
@@ -149,11 +149,19 @@ class Range_rowid_filter_cost_info;
 #define ARRAY_SORT_C          0.01
 /* Cost to evaluate condition */
 #define COST_COND_EVAL  0.2
+/* Cost to hash a rowid and set its bits in a bloom filter */
+#define BLOOM_FILTER_WRITE_COST  0.01
+/* Cost to hash a rowid and test its bits in a bloom filter */
+#define BLOOM_FILTER_LOOKUP_COST 0.02
+/* Number of bits of a bloom filter allocated per expected element */
+#define BLOOM_FILTER_BITS_PER_ELEM 10
+/* Number of bits set in a bloom filter for each element */
+#define BLOOM_FILTER_HASH_FUNCS 7
 
 typedef enum
 {
   SORTED_ARRAY_CONTAINER,
-  BLOOM_FILTER_CONTAINER      // Not used yet
+  BLOOM_FILTER_CONTAINER
 } Rowid_filter_container_type;
 
 /**
@@ -370,6 +378,61 @@ class Rowid_filter_sorted_array: public Rowid_filter_container
   bool check(void *ctxt, char *elem);
 };
 
+
+/**
+  @class Rowid_filter_bloom_filter
+
+  The implementation of the Rowid_filter_container interface as
+  a blocked bloom filter of rowids / primary keys.
+
+  All bits set for an element belong to the same block that fits one
+  cache line, so any check touches at most one cache line. The size of
+  the filter depends only on the expected number of elements, not on the
+  length of rowids. The check may return false positives, which are then
+  discarded by the evaluation of the conditions pushed into the table.
+
+  @note
+    Elements are compared by their binary images. This is correct because
+    the filter is filled and checked with rowids / primary keys produced
+    by handler::position() for the same rows.
+*/
+
+class Rowid_filter_bloom_filter: public Rowid_filter_container
+{
+  /* Number of bytes in a block of the filter */
+  static const uint BLOCK_SIZE= 64;
+  /* Expected number of elements in the filter */
+  uint max_elements;
+  /* Number of bytes in an element */
+  uint elem_size;
+  /* Number of blocks in the filter */
+  uint n_blocks;
+  /* The bit array of the filter */
+  uchar *bits;
+
+  /*
+    @brief Get the block of the filter and the parameters of the probe
+           sequence in it for an element
+  */
+  inline uchar *get_block(const char *elem, uint *h1, uint *h2) const;
+
+public:
+  Rowid_filter_bloom_filter(uint elems, uint elem_sz)
+    : max_elements(elems), elem_size(elem_sz), n_blocks(0), bits(0) {}
+
+  ~Rowid_filter_bloom_filter();
+
+  Rowid_filter_container_type get_type()
+  { return BLOOM_FILTER_CONTAINER; }
+
+  bool alloc();
+
+  bool add(void *ctxt, char *elem);
+
+  bool check(void *ctxt, char *elem);
+};
+
+
 /**
   @class Range_rowid_filter_cost_info
 
@@ -408,7 +471,10 @@ class Range_rowid_filter_cost_info : public Sql_alloc
   Rowid_filter_container_type container_type;
   /* The index whose range scan would be used to build the range filter */
   uint key_no;
-  /* The selectivity of the range filter */
+  /*
+    The selectivity of the range filter
+    (including the false positives of a bloom filter)
+  */
   double selectivity;
 
   Range_rowid_filter_cost_info() : table(0), key_no(0) {}
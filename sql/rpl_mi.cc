@@ -40,7 +40,8 @@ Master_info::Master_info(LEX_CSTRING *connection_name_arg,
    sync_counter(0), heartbeat_period(0), received_heartbeats(0),
    master_id(0), prev_master_id(0),
    using_gtid(USE_GTID_NO), events_queued_since_last_gtid(0),
-   gtid_reconnect_event_skip_count(0), gtid_event_seen(false),
+   gtid_reconnect_event_skip_count(0), payload_events_queued(0),
+   payload_end_log_pos(0), gtid_event_seen(false),
    in_start_all_slaves(0), in_stop_all_slaves(0), in_flush_all_relay_logs(0),
    users(0), killed(0),
    total_ddl_groups(0), total_non_trans_groups(0), total_trans_groups(0)
@@ -200,6 +201,7 @@ void init_master_log_pos(Master_info* mi)
   mi->gtid_current_pos.reset();
   mi->events_queued_since_last_gtid= 0;
   mi->gtid_reconnect_event_skip_count= 0;
+  mi->payload_events_queued= 0;
   mi->gtid_event_seen= false;
 
   /* Intentionally init ssl_verify_server_cert to 0, no option available  */
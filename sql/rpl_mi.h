@@ -312,6 +312,14 @@ class Master_info : public Slave_reporting_capability
     to avoid duplicating events in the relay log.
   */
   uint64 gtid_reconnect_event_skip_count;
+  /*
+    Without GTID, the number of events of a Transaction_payload_log_event
+    that were queued before queueing the rest failed, and the end_log_pos
+    of that event. The IO thread reads the event again from its start and
+    skips that many events of it, to avoid duplicating them in the relay log.
+  */
+  uint payload_events_queued;
+  my_off_t payload_end_log_pos;
   /* gtid_event_seen is false until we receive first GTID event from master. */
   bool gtid_event_seen;
   /**
@@ -2227,6 +2227,114 @@ rpl_parallel_entry::choose_thread(rpl_group_info *rgi, bool *did_enter_cond,
   return thr;
 }
 
+
+/* Number of slots in rpl_parallel_entry::writeset_window, a power of 2. */
+static const uint32 WRITESET_WINDOW_SIZE= 4096;
+
+/*
+  Find the slot of a writeset hash in the window, or the free slot where it
+  would be inserted. 0 marks a free slot, so hash 0 is stored as 1.
+*/
+static uint32 *
+writeset_window_slot(uint32 *window, uint32 hash)
+{
+  uint32 idx= hash & (WRITESET_WINDOW_SIZE - 1);
+  while (window[idx] && window[idx] != hash)
+    idx= (idx + 1) & (WRITESET_WINDOW_SIZE - 1);
+  return window + idx;
+}
+
+
+static inline uint32
+writeset_hash(Gtid_log_event *gtid_ev, uint i)
+{
+  uint32 hash= uint4korr(gtid_ev->writeset + 4 * i);
+  return hash ? hash : 1;
+}
+
+
+/*
+  Check if the writeset of a GTID event describes all the changes of its
+  event group. XA event groups never qualify, whatever the master logged:
+  XA COMMIT and XA ROLLBACK depend on their XA PREPARE without sharing any
+  row with it.
+*/
+static inline bool
+has_writeset(Gtid_log_event *gtid_ev)
+{
+  return (gtid_ev->flags_extra & Gtid_log_event::FL_EXTRA_WRITESET) &&
+    gtid_ev->writeset_count &&
+    (gtid_ev->flags2 & Gtid_log_event::FL_TRANSACTIONAL) &&
+    !(gtid_ev->flags2 & (Gtid_log_event::FL_PREPARED_XA |
+                         Gtid_log_event::FL_COMPLETED_XA));
+}
+
+
+/*
+  Check if the event group of a GTID event changes none of the rows changed
+  by the event groups in current_gco, so that it can run in parallel with
+  them.
+*/
+bool
+rpl_parallel_entry::writeset_independent(Gtid_log_event *gtid_ev)
+{
+  if (!writeset_complete || !has_writeset(gtid_ev))
+    return false;
+  if (!writeset_window_used)
+    return true;
+  for (uint i= 0; i < gtid_ev->writeset_count; i++)
+  {
+    if (*writeset_window_slot(writeset_window, writeset_hash(gtid_ev, i)))
+      return false;
+  }
+  return true;
+}
+
+
+/*
+  Record the writeset of an event group queued in current_gco. new_gco is
+  true if the event group starts a new current_gco.
+*/
+void
+rpl_parallel_entry::writeset_add(Gtid_log_event *gtid_ev, bool new_gco)
+{
+  if (new_gco)
+  {
+    if (writeset_window_used)
+      bzero(writeset_window, WRITESET_WINDOW_SIZE * sizeof(uint32));
+    writeset_window_used= 0;
+    writeset_complete= true;
+  }
+  if (!writeset_complete)
+    return;
+  /* Keep the window at most half full, so that probing stays short */
+  if (!has_writeset(gtid_ev) ||
+      writeset_window_used + gtid_ev->writeset_count > WRITESET_WINDOW_SIZE / 2)
+  {
+    writeset_complete= false;
+    return;
+  }
+  if (!writeset_window &&
+      !(writeset_window= (uint32 *)
+        my_malloc(PSI_INSTRUMENT_ME, WRITESET_WINDOW_SIZE * sizeof(uint32),
+                  MYF(MY_ZEROFILL))))
+  {
+    writeset_complete= false;
+    return;
+  }
+  for (uint i= 0; i < gtid_ev->writeset_count; i++)
+  {
+    uint32 hash= writeset_hash(gtid_ev, i);
+    uint32 *slot= writeset_window_slot(writeset_window, hash);
+    if (!*slot)
+    {
+      *slot= hash;
+      ++writeset_window_used;
+    }
+  }
+}
+
+
 static void
 free_rpl_parallel_entry(void *element)
 {
@@ -2237,6 +2345,7 @@ free_rpl_parallel_entry(void *element)
     dealloc_gco(e->current_gco);
     e->current_gco= prev_gco;
   }
+  my_free(e->writeset_window);
   mysql_cond_destroy(&e->COND_parallel_entry);
   mysql_mutex_destroy(&e->LOCK_parallel_entry);
   my_free(e);
@@ -2828,6 +2937,15 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
       /* Make sure we do not attempt to run DDL in parallel speculatively. */
       if (gtid_flags & Gtid_log_event::FL_DDL)
         flags|= (force_switch_flag= group_commit_orderer::FORCE_SWITCH);
+      /*
+        Without speculation, the writesets logged by the master show which
+        event groups of different group commits are still independent.
+      */
+      if (mode == SLAVE_PARALLEL_WRITESET &&
+          (flags & group_commit_orderer::MULTI_BATCH) &&
+          !(flags & group_commit_orderer::FORCE_SWITCH) &&
+          e->writeset_independent(gtid_ev))
+        flags&= ~group_commit_orderer::MULTI_BATCH;
 
       if (!(flags & group_commit_orderer::MULTI_BATCH))
       {
@@ -2881,6 +2999,8 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
         force_switch_flag= group_commit_orderer::FORCE_SWITCH;
     }
     rgi->speculation= speculation;
+    if (mode == SLAVE_PARALLEL_WRITESET)
+      e->writeset_add(gtid_ev, new_gco);
 
     if (gtid_flags & Gtid_log_event::FL_GROUP_COMMIT_ID)
       e->last_commit_id= gtid_ev->commit_id;
@@ -345,12 +345,23 @@ struct rpl_parallel_entry {
   uint64 count_committing_event_groups;
   /* The group_commit_orderer object for the events currently being queued. */
   group_commit_orderer *current_gco;
+  /*
+    For --slave-parallel-mode=writeset, an open-addressing hash set of the
+    writeset hashes of the event groups in current_gco. writeset_complete is
+    false if some event group in current_gco has no writeset (or it did not
+    fit), so nothing can be known to be independent of it.
+  */
+  uint32 *writeset_window;
+  uint32 writeset_window_used;
+  bool writeset_complete;
 
   rpl_parallel_thread * choose_thread(rpl_group_info *rgi, bool *did_enter_cond,
                                       PSI_stage_info *old_stage,
                                       Gtid_log_event *gtid_ev);
   int queue_master_restart(rpl_group_info *rgi,
                            Format_description_log_event *fdev);
+  bool writeset_independent(Gtid_log_event *gtid_ev);
+  void writeset_add(Gtid_log_event *gtid_ev, bool new_gco);
 };
 struct rpl_parallel {
   HASH domain_hash;
@@ -170,7 +170,8 @@ static int safe_connect(THD* thd, MYSQL* mysql, Master_info* mi);
 static int safe_reconnect(THD*, MYSQL*, Master_info*, bool);
 static int connect_to_master(THD*, MYSQL*, Master_info*, bool, bool);
 static Log_event* next_event(rpl_group_info* rgi, ulonglong *event_size);
-static int queue_event(Master_info* mi,const char* buf,ulong event_len);
+static int queue_event(Master_info* mi,const char* buf,ulong event_len,
+                       bool from_payload= false);
 static int terminate_slave_thread(THD *, mysql_mutex_t *, mysql_cond_t *,
                                   volatile uint *, bool);
 static bool check_io_slave_killed(Master_info *mi, const char *info);
@@ -1406,6 +1407,7 @@ int start_slave_threads(THD *thd,
                                              Master_info::USE_GTID_CURRENT_POS);
     mi->events_queued_since_last_gtid= 0;
     mi->gtid_reconnect_event_skip_count= 0;
+    mi->payload_events_queued= 0;
 
     mi->rli.restart_gtid_pos.reset();
   }
@@ -6265,6 +6267,74 @@ static int queue_old_event(Master_info *mi, const char *buf,
   }
 }
 
+/*
+  Queue the events of a TRANSACTION_PAYLOAD_EVENT as if the master had sent
+  them uncompressed.
+
+  The events get the end_log_pos of the payload event, and mi->master_log_pos
+  is moved past the payload event once all of them are queued. If queueing
+  fails half-way, the position stays at the start of the payload event.
+  With GTID the reconnect skips the events of the group already queued;
+  without it, mi->payload_events_queued is kept so that they are skipped
+  when the payload event is read again.
+*/
+
+static int queue_transaction_payload(Master_info *mi, const char *buf,
+                                     ulong event_len, bool contain_checksum)
+{
+  char *events, *ev, *end;
+  ulong events_len;
+  ulonglong event_pos= uint4korr(buf + LOG_POS_OFFSET);
+  uint skip= 0, queued= 0;
+  int error= 0;
+  DBUG_ENTER("queue_transaction_payload");
+
+  if (transaction_payload_uncompress(mi->rli.relay_log.
+                                     description_event_for_queue,
+                                     contain_checksum, buf, event_len,
+                                     &events, &events_len))
+  {
+    mi->report(ERROR_LEVEL, ER_BINLOG_UNCOMPRESS_ERROR, NULL,
+               ER_DEFAULT(ER_BINLOG_UNCOMPRESS_ERROR));
+    DBUG_RETURN(ER_BINLOG_UNCOMPRESS_ERROR);
+  }
+
+  if (mi->payload_events_queued && mi->payload_end_log_pos == event_pos)
+    skip= mi->payload_events_queued;
+  mi->payload_events_queued= 0;
+
+  for (ev= events, end= events + events_len; ev < end && !error; )
+  {
+    ulong len= uint4korr(ev + EVENT_LEN_OFFSET);
+    if (skip)
+      skip--;
+    else if ((error= queue_event(mi, ev, len, true)))
+      break;
+    queued++;
+    ev+= len;
+  }
+  my_free(events);
+
+  if (unlikely(error))
+  {
+    if (mi->using_gtid == Master_info::USE_GTID_NO)
+    {
+      mi->payload_events_queued= queued;
+      mi->payload_end_log_pos= event_pos;
+    }
+  }
+  else
+  {
+    mysql_mutex_lock(&mi->data_lock);
+    mi->master_log_pos+= event_len;
+    /* Same as in queue_event(), for master-side filtering */
+    if (event_pos > mi->master_log_pos)
+      mi->master_log_pos= event_pos;
+    mysql_mutex_unlock(&mi->data_lock);
+  }
+  DBUG_RETURN(error);
+}
+
 /*
   queue_event()
 
@@ -6273,9 +6343,13 @@ static int queue_old_event(Master_info *mi, const char *buf,
   no format conversion, it's pure read/write of bytes.
   So a 5.0.0 slave's relay log can contain events in the slave's format or in
   any >=5.0.0 format.
+
+  A TRANSACTION_PAYLOAD_EVENT is not written itself: the events it holds are
+  queued one by one, with 'from_payload' set, by queue_transaction_payload().
 */
 
-static int queue_event(Master_info* mi,const char* buf, ulong event_len)
+static int queue_event(Master_info* mi,const char* buf, ulong event_len,
+                       bool from_payload)
 {
   int error= 0;
   StringBuffer<1024> error_msg;
@@ -6381,6 +6455,11 @@ static int queue_event(Master_info* mi,const char* buf, ulong event_len)
                     dbug_rows_event_count = 0;
                   };);
 #endif
+  if ((uchar)buf[EVENT_TYPE_OFFSET] == TRANSACTION_PAYLOAD_EVENT)
+    DBUG_RETURN(queue_transaction_payload(mi, buf, event_len,
+                                          checksum_alg ==
+                                          BINLOG_CHECKSUM_ALG_CRC32));
+
   mysql_mutex_lock(&mi->data_lock);
 
   switch ((uchar)buf[EVENT_TYPE_OFFSET]) {
@@ -6977,6 +7056,10 @@ static int queue_event(Master_info* mi,const char* buf, ulong event_len)
     goto err;
   }
 
+  /* The position is moved past the whole payload event by the caller */
+  if (from_payload)
+    inc_pos= 0;
+
   /*
     If we filter events master-side (eg. @@skip_replication), we will see holes
     in the event positions from the master. If we see such a hole, adjust
@@ -69,6 +69,15 @@ void Filesort_tracker::print_json_members(Json_writer *writer)
   {
     writer->add_member("r_sort_passes").add_ll(
                         (longlong) rint((double)sort_passes / get_r_loops()));
+    if (time_tracker.timed)
+    {
+      writer->add_member("r_read_time_ms").
+              add_double(get_phase_time_ms(READ_PHASE));
+      writer->add_member("r_sort_time_ms").
+              add_double(get_phase_time_ms(SORT_PHASE));
+      writer->add_member("r_merge_time_ms").
+              add_double(get_phase_time_ms(MERGE_PHASE));
+    }
   }
 
   if (sort_buffer_size != 0)
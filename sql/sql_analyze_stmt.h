@@ -226,7 +226,18 @@ class Filesort_tracker : public Sql_alloc
     r_using_addons(false),
     r_packed_addon_fields(false),
     r_sort_keys_packed(false)
-  {}
+  {
+    for (uint i= 0; i < N_PHASES; i++)
+      r_phase_cycles[i]= 0;
+  }
+
+  /*
+    The phases of filesort that are timed separately in ANALYZE.
+    READ_PHASE is reading the rows and making the sort keys,
+    SORT_PHASE is sorting the buffers that are written to the temporary
+    file, and MERGE_PHASE is merging the sorted runs.
+  */
+  enum Phase { READ_PHASE, SORT_PHASE, MERGE_PHASE, N_PHASES };
   
   /* Functions that filesort uses to report various things about its execution */
 
@@ -278,6 +289,34 @@ class Filesort_tracker : public Sql_alloc
     r_sort_keys_packed= sort_keys_packed;
   }
 
+  /*
+    Functions to time the phases of filesort. start_phase() returns the
+    value to pass to end_phase(). Nothing is measured unless this is
+    ANALYZE.
+  */
+  inline ulonglong start_phase() const
+  {
+    return unlikely(time_tracker.timed) ? my_timer_cycles() : 0;
+  }
+  inline void end_phase(Phase phase, ulonglong start)
+  {
+    if (unlikely(time_tracker.timed))
+      r_phase_cycles[phase]+= my_timer_cycles() - start;
+  }
+  /*
+    Sorting is done while reading, move the time spent in a SORT_PHASE
+    out of the enclosing READ_PHASE.
+  */
+  inline void end_sort_phase(ulonglong start)
+  {
+    if (unlikely(time_tracker.timed))
+    {
+      ulonglong cycles= my_timer_cycles() - start;
+      r_phase_cycles[SORT_PHASE]+= cycles;
+      r_phase_cycles[READ_PHASE]-= cycles;
+    }
+  }
+
   void get_data_format(String *str);
 
   /* Functions to get the statistics */
@@ -343,6 +382,14 @@ class Filesort_tracker : public Sql_alloc
   bool r_using_addons;
   bool r_packed_addon_fields;
   bool r_sort_keys_packed;
+
+  /* Time spent in each Phase, only collected in ANALYZE */
+  ulonglong r_phase_cycles[N_PHASES];
+  double get_phase_time_ms(Phase phase) const
+  {
+    return 1000.0 * static_cast<double>(r_phase_cycles[phase]) /
+      static_cast<double>(sys_timer_info.cycles.frequency);
+  }
 };
 
 
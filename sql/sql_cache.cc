@@ -1068,6 +1068,14 @@ Query_cache::insert(THD *thd, Query_cache_tls *query_cache_tls,
 {
   DBUG_ENTER("Query_cache::insert");
 
+  if (partitions)
+  {
+    if (query_cache_tls->first_query_block)
+      query_cache_tls->partition->insert(thd, query_cache_tls, packet,
+                                         length, pkt_nr);
+    DBUG_VOID_RETURN;
+  }
+
   /* First we check if query cache is disable without doing a mutex lock */
   if (is_disabled() || query_cache_tls->first_query_block == NULL)
     DBUG_VOID_RETURN;
@@ -1110,8 +1118,8 @@ Query_cache::insert(THD *thd, Query_cache_tls *query_cache_tls,
     header->result(result);
     DBUG_PRINT("qcache", ("free query %p", query_block));
     // The following call will remove the lock on query_block
-    query_cache.free_query(query_block);
-    query_cache.refused++;
+    free_query(query_block);
+    refused++;
     // append_result_data no success => we need unlock
     unlock();
     DBUG_VOID_RETURN;
@@ -1131,6 +1139,13 @@ Query_cache::abort(THD *thd, Query_cache_tls *query_cache_tls)
 {
   DBUG_ENTER("query_cache_abort");
 
+  if (partitions)
+  {
+    if (query_cache_tls->first_query_block)
+      query_cache_tls->partition->abort(thd, query_cache_tls);
+    DBUG_VOID_RETURN;
+  }
+
   /* See the comment on double-check locking usage above. */
   if (is_disabled() || query_cache_tls->first_query_block == NULL)
     DBUG_VOID_RETURN;
@@ -1171,6 +1186,12 @@ void Query_cache::end_of_result(THD *thd)
   if (query_cache_tls->first_query_block == NULL)
     DBUG_VOID_RETURN;
 
+  if (partitions)
+  {
+    query_cache_tls->partition->end_of_result(thd);
+    DBUG_VOID_RETURN;
+  }
+
   /* Ensure that only complete results are cached. */
   DBUG_ASSERT(thd->get_stmt_da()->is_eof());
 
@@ -1224,9 +1245,9 @@ void Query_cache::end_of_result(THD *thd)
     }
     last_result_block= header->result()->prev;
     allign_size= ALIGN_SIZE(last_result_block->used);
-    len= MY_MAX(query_cache.min_allocation_unit, allign_size);
-    if (last_result_block->length >= query_cache.min_allocation_unit + len)
-      query_cache.split_block(last_result_block,len);
+    len= MY_MAX(min_allocation_unit, allign_size);
+    if (last_result_block->length >= min_allocation_unit + len)
+      split_block(last_result_block,len);
 
     header->found_rows(limit_found_rows);
     header->set_results_ready(); // signal for plugin
@@ -1282,6 +1303,8 @@ Query_cache::Query_cache(size_t query_cache_limit_arg,
    def_table_hash_size(ALIGN_SIZE(def_table_hash_size_arg)),
    initialized(0)
 {
+  partitions= NULL;
+  partition_count= 0;
   size_t min_needed= (ALIGN_SIZE(sizeof(Query_cache_block)) +
 		     ALIGN_SIZE(sizeof(Query_cache_block_table)) +
 		     ALIGN_SIZE(sizeof(Query_cache_query)) + 3);
@@ -1299,6 +1322,20 @@ size_t Query_cache::resize(size_t query_cache_size_arg)
 			query_cache_size_arg));
   DBUG_ASSERT(initialized);
 
+  if (partitions)
+  {
+    size_t partition_size= query_cache_size_arg / partition_count;
+    new_query_cache_size= 0;
+    for (uint i= 0; i < partition_count; i++)
+      new_query_cache_size+= partitions[i].resize(partition_size);
+    query_cache_size= new_query_cache_size;
+    if (new_query_cache_size && global_system_variables.query_cache_type != 0)
+      m_cache_status= OK;
+    else
+      m_cache_status= DISABLED;
+    DBUG_RETURN(new_query_cache_size);
+  }
+
   lock_and_suspend();
 
   /*
@@ -1354,10 +1391,35 @@ size_t Query_cache::set_min_res_unit(size_t size)
   DBUG_ASSERT(size % 8 == 0);
   if (size < min_allocation_unit)
     size= ALIGN_SIZE(min_allocation_unit);
+  for (uint i= 0; i < partition_count; i++)
+    partitions[i].set_min_res_unit(size);
   return (min_result_data_size= size);
 }
 
 
+void Query_cache::result_size_limit(size_t limit)
+{
+  query_cache_limit= limit;
+  for (uint i= 0; i < partition_count; i++)
+    partitions[i].result_size_limit(limit);
+}
+
+
+/**
+  Find the partition a statement is looked up in and stored into.
+
+  The raw statement text is hashed, so the lookup in send_result_to_client()
+  and the later store_query() of the same statement pick the same partition.
+*/
+
+Query_cache *Query_cache::get_partition(const char *query,
+                                        size_t query_length)
+{
+  return partitions + my_hash_sort(&my_charset_bin, (const uchar*) query,
+                                   query_length) % partition_count;
+}
+
+
 void Query_cache::store_query(THD *thd, TABLE_LIST *tables_used)
 {
   TABLE_COUNTER_TYPE local_tables;
@@ -1366,6 +1428,13 @@ void Query_cache::store_query(THD *thd, TABLE_LIST *tables_used)
   size_t query_length;
   uint8 tables_type;
   DBUG_ENTER("Query_cache::store_query");
+
+  if (partitions)
+  {
+    get_partition(thd->query(), thd->query_length())->store_query(thd,
+                                                                 tables_used);
+    DBUG_VOID_RETURN;
+  }
   /*
     Testing 'query_cache_size' without a lock here is safe: the thing
     we may loose is that the query won't be cached, but we save on
@@ -1561,6 +1630,7 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
 	double_linked_list_simple_include(query_block, &queries_blocks);
 	inserts++;
 	queries_in_cache++;
+	thd->query_cache_tls.partition= this;
 	thd->query_cache_tls.first_query_block= query_block;
 	header->writer(&thd->query_cache_tls);
 	header->tables_type(tables_type);
@@ -1716,6 +1786,10 @@ Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
   const char *sql, *sql_end, *found_brace= 0;
   DBUG_ENTER("Query_cache::send_result_to_client");
 
+  if (partitions)
+    DBUG_RETURN(get_partition(org_sql, query_length)->
+                send_result_to_client(thd, org_sql, query_length));
+
   /*
     Testing without a lock here is safe: the thing
     we may loose is that the query won't be served from cache, but we
@@ -2351,6 +2425,13 @@ void Query_cache::invalidate(THD *thd, const char *db)
 
   DBUG_SLOW_ASSERT(ok_for_lower_case_names(db));
 
+  if (partitions)
+  {
+    for (uint i= 0; i < partition_count; i++)
+      partitions[i].invalidate(thd, db);
+    DBUG_VOID_RETURN;
+  }
+
   bool restart= FALSE;
   /*
     Lock the query cache and queue all invalidation attempts to avoid
@@ -2440,6 +2521,13 @@ void Query_cache::flush()
   if (is_disabled())
     DBUG_VOID_RETURN;
 
+  if (partitions)
+  {
+    for (uint i= 0; i < partition_count; i++)
+      partitions[i].flush();
+    DBUG_VOID_RETURN;
+  }
+
   QC_DEBUG_SYNC("wait_in_query_cache_flush1");
 
   lock_and_suspend();
@@ -2450,7 +2538,7 @@ void Query_cache::flush()
     DUMP(this);
   }
 
-  DBUG_EXECUTE("check_querycache",query_cache.check_integrity(1););
+  DBUG_EXECUTE("check_querycache",check_integrity(1););
   unlock();
   DBUG_VOID_RETURN;
 }
@@ -2473,6 +2561,13 @@ void Query_cache::pack(THD *thd, size_t join_limit, uint iteration_limit)
   if (is_disabled())
     DBUG_VOID_RETURN;
 
+  if (partitions)
+  {
+    for (uint i= 0; i < partition_count; i++)
+      partitions[i].pack(thd, join_limit, iteration_limit);
+    DBUG_VOID_RETURN;
+  }
+
   /*
     If the entire qc is being invalidated we can bail out early
     instead of waiting for the lock.
@@ -2504,6 +2599,17 @@ void Query_cache::destroy()
   {
     DBUG_PRINT("qcache", ("Query Cache not initialized"));
   }
+  else if (partitions)
+  {
+    for (uint i= 0; i < partition_count; i++)
+      partitions[i].destroy();
+    delete [] partitions;
+    partitions= NULL;
+    partition_count= 0;
+    mysql_cond_destroy(&COND_cache_status_changed);
+    mysql_mutex_destroy(&structure_guard_mutex);
+    initialized = 0;
+  }
   else
   {
     /* Underlying code expects the lock. */
@@ -2522,6 +2628,14 @@ void Query_cache::destroy()
 
 void Query_cache::disable_query_cache(THD *thd)
 {
+  if (partitions)
+  {
+    /* Each partition is freed once its last request has finished */
+    for (uint i= 0; i < partition_count; i++)
+      partitions[i].disable_query_cache(thd);
+    m_cache_status= DISABLED;
+    return;
+  }
   m_cache_status= DISABLE_REQUEST;
   /*
     If there is no requests in progress try to free buffer.
@@ -2533,11 +2647,39 @@ void Query_cache::disable_query_cache(THD *thd)
 }
 
 
+bool Query_cache::is_disable_in_progress(void)
+{
+  for (uint i= 0; i < partition_count; i++)
+  {
+    if (partitions[i].is_disable_in_progress())
+      return true;
+  }
+  return m_cache_status == DISABLE_REQUEST;
+}
+
+
+size_t Query_cache::get_status(size_t Query_cache::*counter)
+{
+  size_t sum= this->*counter;
+  for (uint i= 0; i < partition_count; i++)
+    sum+= partitions[i].*counter;
+  return sum;
+}
+
+
+void Query_cache::reset_status()
+{
+  hits= inserts= lowmem_prunes= refused= 0;
+  for (uint i= 0; i < partition_count; i++)
+    partitions[i].reset_status();
+}
+
+
 /*****************************************************************************
   init/destroy
 *****************************************************************************/
 
-void Query_cache::init()
+void Query_cache::init(uint partition_count_arg)
 {
   DBUG_ENTER("Query_cache::init");
   mysql_mutex_init(key_structure_guard_mutex,
@@ -2570,6 +2712,17 @@ void Query_cache::init()
     (i.e. not inside a string literal or comment).
   */
   query_state_map= my_charset_latin1.state_map;
+  if (partition_count_arg > 1)
+  {
+    partitions= new Query_cache[partition_count_arg];
+    partition_count= partition_count_arg;
+    for (uint i= 0; i < partition_count; i++)
+    {
+      partitions[i].set_min_res_unit(min_result_data_size);
+      partitions[i].result_size_limit(query_cache_limit);
+      partitions[i].init();
+    }
+  }
   /*
     If we explicitly turn off query cache from the command line query
     cache will be disabled for the reminder of the server life
@@ -3300,6 +3453,14 @@ void Query_cache::invalidate_table(THD *thd, TABLE *table)
 
 void Query_cache::invalidate_table(THD *thd, uchar * key, size_t key_length)
 {
+  if (partitions)
+  {
+    /* Queries using the table may be cached in any of the partitions */
+    for (uint i= 0; i < partition_count; i++)
+      partitions[i].invalidate_table(thd, key, key_length);
+    return;
+  }
+
   DEBUG_SYNC(thd, "wait_in_query_cache_invalidate1");
 
   /*
@@ -318,8 +318,16 @@ class Query_cache
   enum Cache_staus {OK, DISABLE_REQUEST, DISABLED};
   Cache_staus m_cache_status;
 
+  /*
+    With query_cache_partitions > 1 the global query cache owns an array
+    of independently locked partitions and only forwards calls to them.
+  */
+  Query_cache *partitions;
+  uint partition_count;
+
   void free_query_internal(Query_cache_block *point);
   void invalidate_table_internal(THD *thd, uchar *key, size_t key_length);
+  Query_cache *get_partition(const char *query, size_t query_length);
 
 protected:
   /*
@@ -455,15 +463,14 @@ class Query_cache
 	      uint def_table_hash_size = QUERY_CACHE_DEF_TABLE_HASH_SIZE);
 
   inline bool is_disabled(void) { return m_cache_status != OK; }
-  inline bool is_disable_in_progress(void)
-  { return m_cache_status == DISABLE_REQUEST; }
+  bool is_disable_in_progress(void);
 
   /* initialize cache (mutex) */
-  void init();
+  void init(uint partition_count_arg= 1);
   /* resize query cache (return real query size, 0 if disabled) */
   size_t resize(size_t query_cache_size);
   /* set limit on result size */
-  inline void result_size_limit(size_t limit){query_cache_limit=limit;}
+  void result_size_limit(size_t limit);
   /* set minimal result data allocation unit size */
   size_t set_min_res_unit(size_t size);
 
@@ -542,6 +549,19 @@ class Query_cache
   void unlock(void);
 
   void disable_query_cache(THD *thd);
+
+  /*
+    The caches that hold the queries: the partitions, or this object
+    if the cache is not partitioned
+  */
+  uint get_partition_count() const { return partitions ? partition_count : 1; }
+  Query_cache *get_partition_at(uint i)
+  { return partitions ? partitions + i : this; }
+
+  /* Statistics summed over all partitions */
+  size_t get_status(size_t Query_cache::*counter);
+  /* Reset the flushable statistics (FLUSH STATUS) */
+  void reset_status();
 };
 
 #ifdef HAVE_QUERY_CACHE
@@ -575,7 +595,7 @@ struct Query_cache_query_flags
 #define query_cache_store_query(A, B) query_cache.store_query(A, B)
 #define query_cache_destroy() query_cache.destroy()
 #define query_cache_result_size_limit(A) query_cache.result_size_limit(A)
-#define query_cache_init() query_cache.init()
+#define query_cache_init() query_cache.init(query_cache_partitions)
 #define query_cache_resize(A) query_cache.resize(A)
 #define query_cache_set_min_res_unit(A) query_cache.set_min_res_unit(A)
 #define query_cache_invalidate3(A, B, C) query_cache.invalidate(A, B, C)
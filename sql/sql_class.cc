@@ -6820,6 +6820,7 @@ int THD::binlog_write_row(TABLE* table, bool is_trans,
   if (unlikely(ev == 0))
     return HA_ERR_OUT_OF_MEM;
 
+  binlog_add_row_keys(table, is_trans, record, true);
   return ev->add_row_data(row_data, len);
 }
 
@@ -6840,6 +6841,14 @@ int THD::binlog_update_row(TABLE* table, bool is_trans,
   */
   MY_BITMAP *old_read_set= table->read_set;
 
+  /* Ensure that all events in a GTID group are in the same cache */
+  if (variables.option_bits & OPTION_GTID_BEGIN)
+    is_trans= 1;
+
+  /* Before binlog_prepare_row_images() narrows down the read set */
+  binlog_add_row_keys(table, is_trans, before_record, false);
+  binlog_add_row_keys(table, is_trans, after_record, false);
+
   /**
      This will remove spurious fields required during execution but
      not needed for binlogging. This is done according to the:
@@ -6864,10 +6873,6 @@ int THD::binlog_update_row(TABLE* table, bool is_trans,
   size_t const after_size= pack_row(table, table->rpl_write_set, after_row,
                                     after_record);
 
-  /* Ensure that all events in a GTID group are in the same cache */
-  if (variables.option_bits & OPTION_GTID_BEGIN)
-    is_trans= 1;
-
   /*
     Don't print debug messages when running valgrind since they can
     trigger false warnings.
@@ -6919,6 +6924,13 @@ int THD::binlog_delete_row(TABLE* table, bool is_trans,
   */
   MY_BITMAP *old_read_set= table->read_set;
 
+  /* Ensure that all events in a GTID group are in the same cache */
+  if (variables.option_bits & OPTION_GTID_BEGIN)
+    is_trans= 1;
+
+  /* Before binlog_prepare_row_images() narrows down the read set */
+  binlog_add_row_keys(table, is_trans, record, false);
+
   /** 
      This will remove spurious fields required during execution but
      not needed for binlogging. This is done according to the:
@@ -6940,10 +6952,6 @@ int THD::binlog_delete_row(TABLE* table, bool is_trans,
   DBUG_DUMP("table->read_set", (uchar*) table->read_set->bitmap, (table->s->fields + 7) / 8);
   size_t const len= pack_row(table, table->read_set, row_data, record);
 
-  /* Ensure that all events in a GTID group are in the same cache */
-  if (variables.option_bits & OPTION_GTID_BEGIN)
-    is_trans= 1;
-
   Rows_log_event* ev;
   if(binlog_should_compress(len))
     ev =
@@ -487,6 +487,7 @@ class MY_LOCALE;
 */
 
 struct Query_cache_block;
+class Query_cache;
 
 struct Query_cache_tls
 {
@@ -495,12 +496,14 @@ struct Query_cache_tls
     functions and methods to maintain proper locking.
   */
   Query_cache_block *first_query_block;
+  /* Query cache partition that owns 'first_query_block' */
+  Query_cache *partition;
   void set_first_query_block(Query_cache_block *first_query_block_arg)
   {
     first_query_block= first_query_block_arg;
   }
 
-  Query_cache_tls() :first_query_block(NULL) {}
+  Query_cache_tls() :first_query_block(NULL), partition(NULL) {}
 };
 
 /* SIGNAL / RESIGNAL / GET DIAGNOSTICS */
@@ -814,6 +817,8 @@ typedef struct system_variables
   uint column_compression_threshold;
   uint column_compression_zlib_level;
   uint in_subquery_conversion_threshold;
+  uint max_sort_threads;
+  uint join_cache_spill_partitions;
   ulonglong max_rowid_filter_size;
 
   vers_asof_timestamp_t vers_asof_timestamp;
@@ -893,6 +898,7 @@ typedef struct system_status_var
   ulong select_scan_count_;
   ulong update_scan_count;
   ulong delete_scan_count;
+  ulong join_cache_spills;          /* +1 when a BNLH join cache spills */
   ulong executed_triggers;
   ulong long_query_count;
   ulong filesort_merge_passes_;
@@ -900,6 +906,7 @@ typedef struct system_status_var
   ulong filesort_rows_;
   ulong filesort_scan_count_;
   ulong filesort_pq_sorts_;
+  ulong filesort_parallel_chunks_;
 
   /* Features used */
   ulong feature_custom_aggregate_functions; /* +1 when custom aggregate
@@ -2606,6 +2613,8 @@ class THD: public THD_count, /* this must be first */
                         const uchar *buf);
   int binlog_update_row(TABLE* table, bool is_transactional,
                         const uchar *old_data, const uchar *new_data);
+  void binlog_add_row_keys(TABLE *table, bool is_transactional,
+                           const uchar *record, bool all_columns);
   bool prepare_handlers_for_update(uint flag);
   bool binlog_write_annotated_row(Log_event_writer *writer);
   void binlog_prepare_for_row_logging();
@@ -7000,6 +7009,12 @@ inline int handler::ha_ft_read(uchar *buf)
   return error;
 }
 
+inline void handler::ha_rnd_next_batch_row()
+{
+  update_rows_read();
+  increment_statistics(&SSV::ha_read_rnd_next_count);
+}
+
 inline int handler::ha_rnd_pos_by_record(uchar *buf)
 {
   int error= rnd_pos_by_record(buf);
@@ -98,6 +98,7 @@
 
 #define MAX_SORT_MEMORY 2048*1024
 #define MIN_SORT_MEMORY 1024
+#define MAX_SORT_THREADS 64                     /* Max of @@max_sort_threads */
 
 /* Some portable defines */
 
@@ -198,6 +199,8 @@
 #define MIN_FILE_LENGTH_TO_USE_ROW_CACHE (10L*1024*1024)
 #define MIN_ROWS_TO_USE_TABLE_CACHE	 100
 #define MIN_ROWS_TO_USE_BULK_INSERT	 100
+/* Max number of rows read with one rnd_next_batch() call */
+#define RR_BATCH_MAX_ROWS		 64
 
 /**
   The following is used to decide if MySQL should use table scanning
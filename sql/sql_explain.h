@@ -629,6 +629,9 @@ class Explain_rowid_filter : public Sql_alloc
   /* Expected selectivity for the filter */
   double selectivity;
 
+  /* Whether the rowids are collected into a bloom filter */
+  bool bloom_filter;
+
   /* Tracker with the information about how rowid filter is executed */
   Rowid_filter_tracker *tracker;
 
@@ -35,6 +35,9 @@
 
 #define NO_MORE_RECORDS_IN_BUFFER  (uint)(-1)
 
+/* Size of the IO_CACHE buffers of the files of a spilled BNLH join */
+#define JOIN_CACHE_SPILL_BUFFER_SIZE  (IO_SIZE*4)
+
 static void save_or_restore_used_tabs(JOIN_TAB *join_tab, bool save);
 
 /*****************************************************************************
@@ -3140,8 +3143,7 @@ bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
     the calculated index of the hash entry for the given key  
 */
 
-inline
-uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
+static inline ulong join_key_hash_simple(uchar *key, uint key_len)
 {
   ulong nr= 1;
   ulong nr2= 4;
@@ -3152,7 +3154,13 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
     nr^= (ulong) ((((uint) nr & 63)+nr2)*((uint) *pos))+ (nr << 8);
     nr2+= 3;
   }
-  return nr % hash_entries;
+  return nr;
+}
+
+inline
+uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
+{
+  return join_key_hash_simple(key, key_len) % hash_entries;
 }
 
 
@@ -3187,6 +3195,32 @@ uint JOIN_CACHE_HASHED::get_hash_idx_complex(uchar *key, uint key_len)
 }
 
 
+/*
+  Get the hash value of a key that does not depend on the hash table size
+
+  SYNOPSIS
+    get_key_hash_value()
+      key             pointer to the key value
+      key_len         key value length
+
+  DESCRIPTION
+    The function calculates the same hash value as the hash function
+    used for the hash table of the join buffer does before the value
+    is reduced to the number of hash entries. Equal keys always get
+    equal hash values.
+
+  RETURN VALUE
+    the hash value of the given key
+*/
+
+ulong JOIN_CACHE_HASHED::get_key_hash_value(uchar *key, uint key_len)
+{
+  if (hash_func == &JOIN_CACHE_HASHED::get_hash_idx_complex)
+    return key_hashnr(ref_key_info, ref_used_key_parts, key);
+  return join_key_hash_simple(key, key_len);
+}
+
+
 /* 
   Compare two key entries in the hash table as sequence of bytes
 
@@ -3482,6 +3516,78 @@ void JOIN_TAB_SCAN::close()
 }
 
 
+/*
+  Initiate the iteration over the rows of join_tab from a probe file
+
+  SYNOPSIS
+    open()
+
+  DESCRIPTION
+    The function rewinds the probe file of a partition of a spilled
+    BNLH join so that the rows of join_tab written into it can be read
+    once more for the next refill of the join buffer.
+
+  RETURN VALUE
+    0            the initiation is a success
+    error code   otherwise
+*/
+
+int JOIN_TAB_SCAN_SPILL::open()
+{
+  save_or_restore_used_tabs(join_tab, FALSE);
+  rows_left= rows;
+  return reinit_io_cache(file, READ_CACHE, 0L, 0, 0);
+}
+
+
+/*
+  Read the next row of join_tab from a probe file
+
+  SYNOPSIS
+    next()
+
+  DESCRIPTION
+    The function reads the next row written into the probe file into
+    the record buffer of join_tab. The conditions pushed to join_tab
+    have been checked when the row was written.
+
+  RETURN VALUE
+    0            the next row has been successfully read
+    -1           there are no more rows in the file
+    1            a read error
+*/
+
+int JOIN_TAB_SCAN_SPILL::next()
+{
+  TABLE *table= join_tab->table;
+
+  if (!rows_left)
+    return -1;
+  rows_left--;
+  if (my_b_read(file, table->record[0], table->s->reclength))
+    return 1;
+  table->status= 0;
+  table->null_row= 0;
+  return 0;
+}
+
+
+/*
+  Perform finalizing actions for the iteration over a probe file
+
+  SYNOPSIS
+    close()
+
+  RETURN VALUE
+    none
+*/
+
+void JOIN_TAB_SCAN_SPILL::close()
+{
+  save_or_restore_used_tabs(join_tab, TRUE);
+}
+
+
 /*
   Prepare to iterate over the BNL join cache buffer to look for matches 
 
@@ -3698,7 +3804,24 @@ bool JOIN_CACHE_BNLH::prepare_look_for_matches(bool skip_last)
 {
   uchar *curr_matching_chain;
   last_matching_rec_ref_ptr= next_matching_rec_ref_ptr= 0;
-  if (!(curr_matching_chain= get_matching_chain_by_join_key()))
+  curr_matching_chain= get_matching_chain_by_join_key();
+  if (spill_state == SPILL_PROBE && !spill_error)
+  {
+    /*
+      The row of join_tab also has to be joined later with the records
+      from the build file of the partition of its join key, if any.
+    */
+    Spill_partition *part= spill_parts + get_spill_partition(key_buff);
+    if (part->build_rows)
+    {
+      TABLE *table= join_tab->table;
+      if (my_b_write(&part->probe, table->record[0], table->s->reclength))
+        spill_error= TRUE;
+      else
+        part->probe_rows++;
+    }
+  }
+  if (!curr_matching_chain)
     return 1;
   last_matching_rec_ref_ptr= get_next_rec_ref(curr_matching_chain); 
   return 0;
@@ -3815,13 +3938,371 @@ int JOIN_CACHE_BNLH::init(bool for_explain)
 {
   DBUG_ENTER("JOIN_CACHE_BNLH::init");
 
-  if (!(join_tab_scan= new JOIN_TAB_SCAN(join, join_tab)))
+  if (!(join_tab_scan= new JOIN_TAB_SCAN(join, join_tab)) ||
+      !(spill_scan= new JOIN_TAB_SCAN_SPILL(join, join_tab)))
     DBUG_RETURN(1);
 
   DBUG_RETURN(JOIN_CACHE_HASHED::init(for_explain));
 }
 
 
+/*
+  Check whether the BNLH join can be spilled to temporary files
+
+  SYNOPSIS
+    can_spill()
+
+  DESCRIPTION
+    The join can be spilled if @@join_cache_spill_partitions is not 0
+    and the partial join records can be restored from the saved rows
+    of the tables whose fields are stored in the join buffer.
+    This is not the case for linked caches, for records with blobs and
+    for tables whose rowids are needed, as well as when join_tab is an
+    inner table of an outer join or a semi-join, but not the first one.
+
+  RETURN VALUE
+    TRUE    the join can be spilled
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::can_spill()
+{
+  if (!spill_scan || !join->thd->variables.join_cache_spill_partitions ||
+      get_join_alg() != BNLH_JOIN_ALG || prev_cache || blobs ||
+      join_tab->bush_root_tab || join_tab->first_upper ||
+      join_tab->use_quick == 2 || join_tab->keep_current_rowid ||
+      join_tab->table->s->blob_fields)
+    return FALSE;
+  if (join_tab->first_inner && join_tab->first_inner != join_tab)
+    return FALSE;
+  if (join_tab->first_sj_inner_tab &&
+      join_tab->first_sj_inner_tab != join_tab)
+    return FALSE;
+  return TRUE;
+}
+
+
+/*
+  Start spilling the BNLH join to temporary files
+
+  SYNOPSIS
+    start_spill()
+
+  DESCRIPTION
+    The function is called when the join buffer has got full for the
+    first time. It chooses the number of partitions so that, judging by
+    the estimated number of partial join records, the build file of
+    each partition is expected to fit into the join buffer, but takes
+    not more than @@join_cache_spill_partitions of them. Then it creates
+    the temporary files of the partitions. The files are not opened
+    before anything has to be written into them.
+
+  RETURN VALUE
+    FALSE   the join is spilled from now on
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::start_spill()
+{
+  uint parts= join->thd->variables.join_cache_spill_partitions;
+  double need= 2 * (join_tab-1)->get_partial_join_cardinality() / records;
+  DBUG_ENTER("JOIN_CACHE_BNLH::start_spill");
+
+  if (need < parts)
+    parts= MY_MIN(parts, MY_MAX((uint) need + 1, 2));
+
+  if (!(spill_parts= (Spill_partition*)
+        my_malloc(key_memory_JOIN_CACHE, parts * sizeof(Spill_partition),
+                  MYF(MY_THREAD_SPECIFIC | MY_ZEROFILL))))
+    DBUG_RETURN(TRUE);
+  spill_part_count= parts;
+
+  for (Spill_partition *part= spill_parts; part < spill_parts + parts; part++)
+  {
+    if (open_cached_file(&part->build, mysql_tmpdir, TEMP_PREFIX,
+                         JOIN_CACHE_SPILL_BUFFER_SIZE, MYF(MY_WME)) ||
+        open_cached_file(&part->probe, mysql_tmpdir, TEMP_PREFIX,
+                         JOIN_CACHE_SPILL_BUFFER_SIZE, MYF(MY_WME)))
+    {
+      end_spill();
+      DBUG_RETURN(TRUE);
+    }
+  }
+  spill_error= FALSE;
+  spill_state= SPILL_BUILD;
+  status_var_increment(join->thd->status_var.join_cache_spills);
+  DBUG_PRINT("info", ("spilling to %u partitions", parts));
+  DBUG_RETURN(FALSE);
+}
+
+
+/*
+  Stop spilling the BNLH join and remove its temporary files
+
+  SYNOPSIS
+    end_spill()
+
+  RETURN VALUE
+    none
+*/
+
+void JOIN_CACHE_BNLH::end_spill()
+{
+  if (spill_parts)
+  {
+    for (uint i= 0; i < spill_part_count; i++)
+    {
+      close_cached_file(&spill_parts[i].build);
+      close_cached_file(&spill_parts[i].probe);
+    }
+    my_free(spill_parts);
+    spill_parts= 0;
+  }
+  spill_part_count= 0;
+  spill_state= SPILL_NONE;
+}
+
+
+/*
+  Get the partition of the spilled BNLH join for a join key
+
+  SYNOPSIS
+    get_spill_partition()
+      key     the join key value
+
+  DESCRIPTION
+    The bits of the hash value of the key are mixed before it is reduced
+    to the number of partitions, otherwise all keys of a partition could
+    fall into a few entries of the hash table of the join buffer.
+
+  RETURN VALUE
+    the number of the partition for the key
+*/
+
+uint JOIN_CACHE_BNLH::get_spill_partition(uchar *key)
+{
+  ulonglong nr= (ulonglong) get_key_hash_value(key, key_length) *
+                0x9E3779B97F4A7C15ULL;
+  return (uint) ((nr >> 32) % spill_part_count);
+}
+
+
+/*
+  Write the current partial join record into a build file
+
+  SYNOPSIS
+    write_spilled_prefix()
+      file    the build file of a partition
+
+  DESCRIPTION
+    The function saves the rows of the tables whose fields are stored
+    in the join buffer, as they are in the record buffers, together
+    with their null row flags and, if needed, their rowids.
+
+  RETURN VALUE
+    FALSE   the record has been written
+    TRUE    a write error
+*/
+
+bool JOIN_CACHE_BNLH::write_spilled_prefix(IO_CACHE *file)
+{
+  for (JOIN_TAB *tab= start_tab; tab != join_tab;
+       tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+  {
+    TABLE *table= tab->table;
+    if (my_b_write(file, (uchar*) &table->null_row, sizeof(table->null_row)) ||
+        my_b_write(file, table->record[0], table->s->reclength) ||
+        (tab->keep_current_rowid &&
+         my_b_write(file, table->file->ref, table->file->ref_length)))
+      return TRUE;
+  }
+  return FALSE;
+}
+
+
+/*
+  Read a partial join record from a build file into the record buffers
+
+  SYNOPSIS
+    read_spilled_prefix()
+      file    the build file of a partition
+
+  RETURN VALUE
+    FALSE   the record has been read
+    TRUE    a read error
+*/
+
+bool JOIN_CACHE_BNLH::read_spilled_prefix(IO_CACHE *file)
+{
+  for (JOIN_TAB *tab= start_tab; tab != join_tab;
+       tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+  {
+    TABLE *table= tab->table;
+    if (my_b_read(file, (uchar*) &table->null_row, sizeof(table->null_row)) ||
+        my_b_read(file, table->record[0], table->s->reclength) ||
+        (tab->keep_current_rowid &&
+         my_b_read(file, table->file->ref, table->file->ref_length)))
+      return TRUE;
+  }
+  return FALSE;
+}
+
+
+/*
+  Add a record into the buffer or into a build file of the BNLH cache
+
+  SYNOPSIS
+    put_record()
+
+  DESCRIPTION
+    While the join is spilled the function writes the partial join record
+    into the build file of the partition of its join key instead of the
+    join buffer. Otherwise it puts the record into the join buffer, and
+    if the buffer gets full for the first time and the join can be
+    spilled, it starts spilling the join rather than asking the caller
+    to join the records in the buffer.
+
+  RETURN VALUE
+    TRUE    if it has been decided that it should be the last record
+            in the join buffer,
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::put_record()
+{
+  if (spill_state == SPILL_BUILD)
+  {
+    TABLE_REF *ref= &join_tab->ref;
+    if (!spill_error)
+    {
+      cp_buffer_from_ref(join->thd, join_tab->table, ref);
+      Spill_partition *part= spill_parts + get_spill_partition(ref->key_buff);
+      if (write_spilled_prefix(&part->build))
+        spill_error= TRUE;
+      else
+        part->build_rows++;
+    }
+    return FALSE;
+  }
+
+  bool is_full= JOIN_CACHE_HASHED::put_record();
+  if (is_full && spill_state == SPILL_NONE && can_spill() && !start_spill())
+    return FALSE;
+  return is_full;
+}
+
+
+/*
+  Join the records of a partition of the spilled BNLH join
+
+  SYNOPSIS
+    join_spilled_partition()
+      part    the partition
+
+  DESCRIPTION
+    The function refills the join buffer with the records from the build
+    file of the partition and joins them with the rows of join_tab from
+    the probe file of the partition, as many times as the buffer gets
+    full.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state, except NESTED_LOOP_NO_MORE_ROWS.
+*/
+
+enum_nested_loop_state
+JOIN_CACHE_BNLH::join_spilled_partition(Spill_partition *part)
+{
+  enum_nested_loop_state rc= NESTED_LOOP_OK;
+
+  if (reinit_io_cache(&part->build, READ_CACHE, 0L, 0, 0))
+    return NESTED_LOOP_ERROR;
+  spill_scan->set_file(&part->probe, part->probe_rows);
+
+  for (ha_rows n= part->build_rows; n; n--)
+  {
+    if (read_spilled_prefix(&part->build))
+      return NESTED_LOOP_ERROR;
+    if (put_record())
+    {
+      rc= JOIN_CACHE_HASHED::join_records(FALSE);
+      if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+        return rc;
+    }
+  }
+  if (records)
+    rc= JOIN_CACHE_HASHED::join_records(FALSE);
+  return rc;
+}
+
+
+/*
+  Join the records of the BNLH cache, including the spilled ones
+
+  SYNOPSIS
+    join_records()
+      skip_last    do not find matches for the last record from the buffer
+
+  DESCRIPTION
+    If the join has not been spilled the function just joins the records
+    from the join buffer as JOIN_CACHE::join_records does. Otherwise it
+    joins the records left in the join buffer with the rows of join_tab
+    and at the same time writes these rows into the probe files of the
+    partitions. After this it joins the records of each partition whose
+    build file is not empty, and removes the temporary files.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state, except NESTED_LOOP_NO_MORE_ROWS.
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_records(bool skip_last)
+{
+  enum_nested_loop_state rc= NESTED_LOOP_ERROR;
+  DBUG_ENTER("JOIN_CACHE_BNLH::join_records");
+
+  if (spill_state != SPILL_BUILD)
+    DBUG_RETURN(JOIN_CACHE_HASHED::join_records(skip_last));
+
+  if (!spill_error)
+  {
+    spill_state= SPILL_PROBE;
+    rc= JOIN_CACHE_HASHED::join_records(skip_last);
+    if (spill_error)
+      rc= NESTED_LOOP_ERROR;
+  }
+
+  if (rc == NESTED_LOOP_OK || rc == NESTED_LOOP_NO_MORE_ROWS)
+  {
+    bool outer_join_first_inner= join_tab->is_first_inner_for_outer_join();
+    JOIN_TAB_SCAN *scan= join_tab_scan;
+    spill_state= SPILL_JOIN;
+    join_tab_scan= spill_scan;
+    for (uint i= 0; i < spill_part_count; i++)
+    {
+      Spill_partition *part= spill_parts + i;
+      /*
+        Without rows of join_tab the records of a partition can only
+        get null complements.
+      */
+      if (!part->build_rows || (!part->probe_rows && !outer_join_first_inner))
+        continue;
+      if (unlikely(join->thd->check_killed()))
+      {
+        rc= NESTED_LOOP_KILLED;
+        break;
+      }
+      rc= join_spilled_partition(part);
+      if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+        break;
+    }
+    join_tab_scan= scan;
+  }
+
+  end_spill();
+  reset(TRUE);
+  DBUG_RETURN(rc);
+}
+
+
 /* 
   Calculate the increment of the MRR buffer for a record write       
 
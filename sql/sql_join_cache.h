@@ -659,7 +659,7 @@ class JOIN_CACHE :public Sql_alloc
   }
      
   /* Join records from the join buffer with records from the next join table */ 
-  enum_nested_loop_state join_records(bool skip_last);
+  virtual enum_nested_loop_state join_records(bool skip_last);
 
   /* Add a comment on the join algorithm employed by the join cache */
   virtual bool save_explain_data(EXPLAIN_BKA_TYPE *explain);
@@ -668,7 +668,7 @@ class JOIN_CACHE :public Sql_alloc
 
   virtual ~JOIN_CACHE() {}
   void reset_join(JOIN *j) { join= j; }
-  void free()
+  virtual void free()
   { 
     my_free(buff);
     buff= 0;
@@ -972,6 +972,9 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* Search for a key in the hash table of the join buffer */
   bool key_search(uchar *key, uint key_len, uchar **key_ref_ptr);
 
+  /* Get the hash value of a key that does not depend on hash_entries */
+  ulong get_key_hash_value(uchar *key, uint key_len);
+
   /* Reallocate the join buffer of a hashed join cache */
   int realloc_buffer();
 
@@ -1086,6 +1089,41 @@ class JOIN_TAB_SCAN: public Sql_alloc
 
 };
 
+/*
+  The class JOIN_TAB_SCAN_SPILL is a companion class for the class
+  JOIN_CACHE_BNLH. It is used instead of JOIN_TAB_SCAN when the join
+  has been spilled to temporary files: it iterates over the rows of
+  join_tab written into the probe file of a partition rather than over
+  the table itself. The conditions pushed to join_tab have already been
+  checked for these rows.
+*/
+
+class JOIN_TAB_SCAN_SPILL: public JOIN_TAB_SCAN
+{
+  /* The file with the rows of join_tab to iterate over */
+  IO_CACHE *file;
+  /* The number of rows in the file */
+  ha_rows rows;
+  /* The number of rows that have not been read yet */
+  ha_rows rows_left;
+
+public:
+
+  JOIN_TAB_SCAN_SPILL(JOIN *j, JOIN_TAB *tab)
+    :JOIN_TAB_SCAN(j, tab), file(0), rows(0), rows_left(0) {}
+
+  /* Set the file to iterate over by the next calls of open() */
+  void set_file(IO_CACHE *f, ha_rows n) { file= f; rows= n; }
+
+  int open();
+
+  int next();
+
+  void close();
+
+};
+
+
 /*
   The class JOIN_CACHE_BNL is used when the BNL join algorithm is
   employed to perform a join operation   
@@ -1147,6 +1185,53 @@ class JOIN_CACHE_BNL :public JOIN_CACHE
 class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 {
 
+private:
+
+  /*
+    When the records of the join buffer do not fit into it and
+    @@join_cache_spill_partitions is not 0 a BNLH join cache does not
+    rescan join_tab for each refill of the buffer. Instead it joins
+    as a hybrid grace hash join:
+    - the records that are in the buffer when it gets full stay there,
+      the following partial join records are written to the build files
+      of partitions chosen by the hash value of their join keys
+      (SPILL_BUILD);
+    - join_tab is scanned once: its rows are joined with the records
+      in the buffer and written to the probe files of the partitions
+      chosen in the same way (SPILL_PROBE);
+    - for each partition the buffer is refilled from its build file and
+      joined with the rows from its probe file (SPILL_JOIN). If a build
+      file does not fit into the buffer only its probe file is rescanned
+      for each refill.
+  */
+  enum Spill_state { SPILL_NONE, SPILL_BUILD, SPILL_PROBE, SPILL_JOIN };
+
+  /* A pair of temporary files of a partition of the spilled join */
+  struct Spill_partition
+  {
+    IO_CACHE build;
+    IO_CACHE probe;
+    ha_rows build_rows;
+    ha_rows probe_rows;
+  };
+
+  Spill_state spill_state;
+  /* Array of spill_part_count partitions, allocated when spilling starts */
+  Spill_partition *spill_parts;
+  uint spill_part_count;
+  /* Set when writing into a probe file fails */
+  bool spill_error;
+  /* Iterator over the rows of a probe file used in the state SPILL_JOIN */
+  JOIN_TAB_SCAN_SPILL *spill_scan;
+
+  bool can_spill();
+  bool start_spill();
+  void end_spill();
+  uint get_spill_partition(uchar *key);
+  bool write_spilled_prefix(IO_CACHE *file);
+  bool read_spilled_prefix(IO_CACHE *file);
+  enum_nested_loop_state join_spilled_partition(Spill_partition *part);
+
 protected:
 
   /* 
@@ -1185,7 +1270,9 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab) : JOIN_CACHE_HASHED(j, tab) {}
+  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab)
+    : JOIN_CACHE_HASHED(j, tab), spill_state(SPILL_NONE), spill_parts(0),
+      spill_part_count(0), spill_error(0), spill_scan(0) {}
 
   /* 
     This constructor creates a linked BNLH join cache. The cache is to be 
@@ -1194,11 +1281,24 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-    : JOIN_CACHE_HASHED(j, tab, prev) {}
+    : JOIN_CACHE_HASHED(j, tab, prev), spill_state(SPILL_NONE),
+      spill_parts(0), spill_part_count(0), spill_error(0), spill_scan(0) {}
 
   /* Initialize the BNLH cache */       
   int init(bool for_explain);
 
+  /* Add a record into the buffer or into a build file of the BNLH cache */
+  bool put_record();
+
+  /* Join the records of the BNLH cache, including the spilled ones */
+  enum_nested_loop_state join_records(bool skip_last);
+
+  void free()
+  {
+    end_spill();
+    JOIN_CACHE_HASHED::free();
+  }
+
   enum Join_algorithm get_join_alg() { return BNLH_JOIN_ALG; }
 
   bool is_key_access() { return TRUE; }
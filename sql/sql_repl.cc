@@ -26,6 +26,7 @@
 #include "sql_repl.h"
 #include "log_event.h"
 #include "rpl_filter.h"
+#include "gtid_index.h"
 #include <my_dir.h>
 #include "debug_sync.h"
 #include "semisync_master.h"
@@ -1962,6 +1963,32 @@ send_event_to_slave(binlog_send_info *info, Log_event_type event_type,
     }
     if (!need_dummy)
       return NULL;
+    /* The writeset, if any, was removed */
+    len= packet->length();
+  }
+  else if (event_type == GTID_EVENT &&
+           mariadb_slave_capability < MARIA_SLAVE_CAPABILITY_WRITESET)
+  {
+    if (Gtid_log_event::strip_writeset(packet, ev_offset,
+                                       current_checksum_alg))
+    {
+      info->error= ER_MASTER_FATAL_ERROR_READING_BINLOG;
+      return "Failed to remove the writeset from GTID event: corrupt event.";
+    }
+    len= packet->length();
+  }
+
+  /*
+    A slave that does not know the compressed event group cannot be served
+    the events it holds either: they would not match the positions of the
+    binlog.
+  */
+  if (unlikely(event_type == TRANSACTION_PAYLOAD_EVENT) &&
+      mariadb_slave_capability < MARIA_SLAVE_CAPABILITY_TRANSACTION_PAYLOAD)
+  {
+    info->error= ER_MASTER_FATAL_ERROR_READING_BINLOG;
+    return "Slave does not support compressed event groups; disable "
+           "log_bin_compress_transactions on the master or upgrade the slave.";
   }
 
   /*
@@ -2044,6 +2071,42 @@ send_event_to_slave(binlog_send_info *info, Log_event_type event_type,
   return NULL;    /* Success */
 }
 
+/*
+  Use the GTID index of the binlog file to skip the event groups that come
+  before the slave position. Only the part of the file that is already
+  visible to dump threads is considered.
+
+  Like send_event_to_slave() does when it reaches the slave position in a
+  domain, a fake Gtid_list event is sent if the position of a domain lies
+  in the skipped part.
+*/
+static my_off_t gtid_index_start_pos(binlog_send_info *info,
+                                     const char *log_file_name)
+{
+  MY_STAT stat;
+  my_off_t max_pos, end_pos, pos;
+  char end_pos_file[FN_REFLEN];
+  uint32 count= info->gtid_state.count();
+
+  if (!mysql_file_stat(key_file_binlog, log_file_name, &stat, MYF(0)))
+    return BIN_LOG_HEADER_SIZE;
+  max_pos= (my_off_t) stat.st_size;
+
+  mysql_bin_log.lock_binlog_end_pos();
+  end_pos= mysql_bin_log.get_binlog_end_pos(end_pos_file);
+  mysql_bin_log.unlock_binlog_end_pos();
+  if (!strcmp(end_pos_file, log_file_name))
+    set_if_smaller(max_pos, end_pos);
+
+  pos= gtid_index_find_start_pos(log_file_name, max_pos, &info->gtid_state,
+                                 &info->until_binlog_state);
+  if (pos > BIN_LOG_HEADER_SIZE)
+    statistic_increment(binlog_gtid_index_hits, LOCK_status);
+  if (info->gtid_state.count() < count)
+    info->send_fake_gtid_list= true;
+  return pos;
+}
+
 static int check_start_offset(binlog_send_info *info,
                               const char *log_file_name,
                               my_off_t pos)
@@ -2204,6 +2267,9 @@ static int init_binlog_sender(binlog_send_info *info,
     return 1;
   }
 
+  if (info->using_gtid_state && !info->until_gtid_state)
+    *pos= gtid_index_start_pos(info, linfo->log_file_name);
+
   // set current pos too
   linfo->pos= *pos;
   // note: publish that we use file, before we open it
@@ -2905,6 +2971,7 @@ void mysql_binlog_send(THD* thd, char* log_ident, my_off_t pos,
       info->error= ER_MASTER_FATAL_ERROR_READING_BINLOG;
       goto err;
     }
+    use_binlog_dump_cache(&log);
 
     if (send_format_descriptor_event(info, &log, &linfo, pos))
     {
@@ -18628,9 +18628,18 @@ bool Create_tmp_table::finalize(THD *thd,
   DBUG_ASSERT(m_alloced_field_count >= share->fields);
   DBUG_ASSERT(m_alloced_field_count >= share->blob_fields);
 
-  /* If result table is small; use a heap */
+  /*
+    If result table is small; use a heap. Blobs are fine there as long as
+    no key is built over them, which a distinct key would do. A short
+    blob, like TINYTEXT, can also be a part of the group key.
+  */
+  bool blob_key= share->blob_fields && m_distinct;
+  for (ORDER *tmp= m_group; tmp && share->blob_fields && !blob_key;
+       tmp= tmp->next)
+    blob_key= (*tmp->item)->get_tmp_table_field()->flags & BLOB_FLAG;
+
   /* future: storage engine selection can be made dynamic? */
-  if (share->blob_fields || m_using_unique_constraint
+  if (blob_key || m_using_unique_constraint
       || (thd->variables.big_tables && !(m_select_options & SELECT_SMALL_RESULT))
       || (m_select_options & TMP_TABLE_FORCE_MYISAM)
       || thd->variables.tmp_memory_table_size == 0)
@@ -21555,6 +21564,10 @@ int join_init_read_record(JOIN_TAB *tab)
   tab->read_record.copy_field=     save_copy;
   tab->read_record.copy_field_end= save_copy_end;
 
+  /* Rows can be read in batches unless we need the rowid of each of them */
+  if (!tab->keep_current_rowid)
+    init_read_record_batch(&tab->read_record);
+
   if (need_unpacking)
   {
     tab->read_record.read_record_func_and_unpack_calls=
@@ -23971,8 +23984,8 @@ JOIN_TAB::remove_duplicates()
     thd->reset_killed();
 
   table->file->info(HA_STATUS_VARIABLE);
-  if (table->s->db_type() == heap_hton ||
-      (!table->s->blob_fields &&
+  if (!table->s->blob_fields &&
+      (table->s->db_type() == heap_hton ||
        ((ALIGN_SIZE(keylength) + HASH_OVERHEAD) * table->file->stats.records <
 	thd->variables.sortbuff_size)))
     error=remove_dup_with_hash_index(join->thd, table, field_count, first_field,
@@ -26512,6 +26525,8 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
     erf->quick= quick->get_explain(thd->mem_root);
     erf->selectivity= range_rowid_filter_info->selectivity;
     erf->rows= quick->records;
+    erf->bloom_filter= rowid_filter->get_container()->get_type() ==
+                       BLOOM_FILTER_CONTAINER;
     if (!(erf->tracker= new Rowid_filter_tracker(thd->lex->analyze_stmt)))
       return 1;
     rowid_filter->set_tracker(erf->tracker);
@@ -23,6 +23,7 @@
 #include "sql_class.h"
 
 class Field;
+class Filesort_tracker;
 struct TABLE;
 
 /* Defines used by filesort and uniques */
@@ -563,6 +564,13 @@ class Sort_param {
 
   uchar *unique_buff;
   bool not_killable;
+  /*
+    Maximum number of threads that filesort may use for sorting the
+    buffers and merging the sorted runs. 0 or 1 if all the work is done
+    by the connection thread.
+  */
+  uint max_threads;
+  Filesort_tracker *tracker;      // For timing the phases of filesort
   String tmp_buffer;
   // The fields below are used only by Unique class.
   qsort2_cmp compare;
@@ -537,6 +537,15 @@ Sys_binlog_cache_size(
        CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(IO_SIZE, SIZE_T_MAX), DEFAULT(32768), BLOCK_SIZE(IO_SIZE));
 
+static Sys_var_ulonglong Sys_binlog_dump_cache_size(
+       "binlog_dump_cache_size",
+       "Size of an in-memory copy of the most recently written part of the "
+       "binary log. Binlog dump threads that are close to the end of the "
+       "binary log read events from there instead of from the file. "
+       "0 disables the cache",
+       READ_ONLY GLOBAL_VAR(binlog_dump_cache_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, SIZE_T_MAX), DEFAULT(0), BLOCK_SIZE(IO_SIZE));
+
 static Sys_var_on_access_global<Sys_var_ulonglong,
                                 PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_FILE_CACHE_SIZE>
 Sys_binlog_file_cache_size(
@@ -1422,6 +1431,16 @@ Sys_log_bin_compress_min_len(
   GLOBAL_VAR(opt_bin_log_compress_min_len),
   CMD_LINE(OPT_ARG), VALID_RANGE(10, 1024), DEFAULT(256), BLOCK_SIZE(1));
 
+static Sys_var_on_access_global<Sys_var_mybool,
+                  PRIV_SET_SYSTEM_GLOBAL_VAR_LOG_BIN_COMPRESS_TRANSACTIONS>
+Sys_log_bin_compress_transactions(
+  "log_bin_compress_transactions",
+  "Compress the events of each transaction together into one binary log "
+  "event, with zstd, or with zlib if the server was built without zstd. "
+  "Transactions that do not get smaller are logged uncompressed",
+  GLOBAL_VAR(opt_bin_log_compress_transactions), CMD_LINE(OPT_ARG),
+  DEFAULT(FALSE));
+
 static Sys_var_on_access_global<Sys_var_mybool,
                     PRIV_SET_SYSTEM_GLOBAL_VAR_LOG_BIN_TRUST_FUNCTION_CREATORS>
 Sys_trust_function_creators(
@@ -2318,7 +2337,8 @@ Sys_var_slave_parallel_mode::global_value_ptr(THD *thd,
 
 /* The order here must match enum_slave_parallel_mode in mysqld.h. */
 static const char *slave_parallel_mode_names[] = {
-  "none", "minimal", "conservative", "optimistic", "aggressive", NULL
+  "none", "minimal", "conservative", "writeset", "optimistic", "aggressive",
+  NULL
 };
 export TYPELIB slave_parallel_mode_typelib = {
   array_elements(slave_parallel_mode_names)-1,
@@ -2335,7 +2355,9 @@ Sys_slave_parallel_mode(
        "--slave-parallel-threads. Possible values: \"optimistic\" tries to "
        "apply most transactional DML in parallel, and handles any conflicts "
        "with rollback and retry. \"conservative\" limits parallelism in an "
-       "effort to avoid any conflicts. \"aggressive\" tries to maximise the "
+       "effort to avoid any conflicts. \"writeset\" also applies in parallel "
+       "transactions that the master logged with non-overlapping writesets "
+       "(see --binlog-writeset-max-keys). \"aggressive\" tries to maximise the "
        "parallelism, possibly at the cost of increased conflict rate. "
        "\"minimal\" only parallelizes the commit steps of transactions. "
        "\"none\" disables parallel apply completely.",
@@ -2415,6 +2437,50 @@ Sys_binlog_commit_wait_usec(
        VALID_RANGE(0, ULONG_MAX), DEFAULT(100000), BLOCK_SIZE(1));
 
 
+static Sys_var_on_access_global<Sys_var_mybool,
+                            PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_COMMIT_PIPELINE>
+Sys_binlog_commit_pipeline(
+       "binlog_commit_pipeline",
+       "Sync the binlog for a group commit after the binlog lock is "
+       "released, so that the next group commit can write to the binlog "
+       "while the previous one is being synced. Only takes effect if "
+       "sync_binlog is non-zero.",
+       GLOBAL_VAR(opt_binlog_commit_pipeline), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
+
+static Sys_var_on_access_global<Sys_var_ulong,
+                            PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_WRITESET_MAX_KEYS>
+Sys_binlog_writeset_max_keys(
+       "binlog_writeset_max_keys",
+       "If non-zero, the GTID event of a row-based transaction records hashes "
+       "of the primary and unique keys of the rows it changed, so that a "
+       "slave with slave_parallel_mode=writeset can apply transactions that "
+       "do not change the same rows in parallel. Transactions that change "
+       "more than this many keys are logged without a writeset.",
+       GLOBAL_VAR(opt_binlog_writeset_max_keys), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, UINT_MAX16), DEFAULT(0), BLOCK_SIZE(1));
+
+static Sys_var_on_access_global<Sys_var_mybool,
+                            PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_GTID_INDEX>
+Sys_binlog_gtid_index(
+       "binlog_gtid_index",
+       "Write an index of the GTID positions next to each binlog file, so "
+       "that a slave connecting with a GTID position does not have to be "
+       "sent from the start of the binlog file. Takes effect from the next "
+       "binlog file.",
+       GLOBAL_VAR(opt_binlog_gtid_index), CMD_LINE(OPT_ARG), DEFAULT(TRUE));
+
+static Sys_var_on_access_global<Sys_var_ulong,
+                      PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_GTID_INDEX_SPAN_MIN>
+Sys_binlog_gtid_index_span_min(
+       "binlog_gtid_index_span_min",
+       "Minimum number of bytes of binlog between two entries of the binlog "
+       "GTID index.",
+       GLOBAL_VAR(opt_binlog_gtid_index_span_min), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 1024*1024*1024), DEFAULT(65536), BLOCK_SIZE(1));
+
+
 static bool fix_max_join_size(sys_var *self, THD *thd, enum_var_type type)
 {
   SV *sv= type == OPT_GLOBAL ? &global_system_variables : &thd->variables;
@@ -2467,6 +2533,14 @@ static Sys_var_ulong Sys_max_sort_length(
        SESSION_VAR(max_sort_length), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(8, 8192*1024L), DEFAULT(1024), BLOCK_SIZE(1));
 
+static Sys_var_uint Sys_max_sort_threads(
+       "max_sort_threads",
+       "Maximum number of threads that a single filesort may use to sort "
+       "its buffers and to merge the sorted runs in parallel. 1 means that "
+       "the connection thread does all the sorting",
+       SESSION_VAR(max_sort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, MAX_SORT_THREADS), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_max_sp_recursion_depth(
        "max_sp_recursion_depth",
        "Maximum stored procedure recursion depth",
@@ -3108,6 +3182,14 @@ static Sys_var_ulong Sys_query_cache_min_res_unit(
        BLOCK_SIZE(8), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
        ON_UPDATE(fix_qcache_min_res_unit));
 
+static Sys_var_uint Sys_query_cache_partitions(
+       "query_cache_partitions",
+       "Number of independently locked partitions the query cache is "
+       "split into. Statements are hashed to a partition, and table "
+       "invalidations are applied to all partitions",
+       READ_ONLY GLOBAL_VAR(query_cache_partitions), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 64), DEFAULT(1), BLOCK_SIZE(1));
+
 static const char *query_cache_type_names[]= { "OFF", "ON", "DEMAND", 0 };
 
 static bool check_query_cache_type(sys_var *self, THD *thd, set_var *var)
@@ -3297,6 +3379,17 @@ Slave_run_triggers_for_rbr(
        slave_run_triggers_for_rbr_names,
        DEFAULT(SLAVE_RUN_TRIGGERS_FOR_RBR_NO));
 
+static Sys_var_on_access_global<Sys_var_mybool,
+                               PRIV_SET_SYSTEM_GLOBAL_VAR_SLAVE_ROWS_HASH_SCAN>
+Sys_slave_rows_hash_scan(
+       "slave_rows_hash_scan",
+       "Apply row-based UPDATE and DELETE events on tables without a usable "
+       "key with one table scan per event, matching the table rows against "
+       "a hash of the before images of the event, instead of one table scan "
+       "per row",
+       GLOBAL_VAR(opt_slave_rows_hash_scan), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static const char *slave_type_conversions_name[]= {"ALL_LOSSY", "ALL_NON_LOSSY", 0};
 static Sys_var_on_access_global<Sys_var_set,
                               PRIV_SET_SYSTEM_GLOBAL_VAR_SLAVE_TYPE_CONVERSIONS>
@@ -6340,6 +6433,15 @@ static Sys_var_ulong Sys_join_cache_level(
        SESSION_VAR(join_cache_level), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(0, 8), DEFAULT(2), BLOCK_SIZE(1));
 
+static Sys_var_uint Sys_join_cache_spill_partitions(
+       "join_cache_spill_partitions",
+       "Maximum number of partitions into which a hashed join buffer "
+       "that gets full is spilled to temporary files, so that the joined "
+       "table is read only once. 0 means that the joined table is read "
+       "once for each refill of the join buffer",
+       SESSION_VAR(join_cache_spill_partitions), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 128), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_mrr_buffer_size(
        "mrr_buffer_size",
        "Size of buffer to use when using MRR with range access",
@@ -105,7 +105,6 @@ static const char *removed_variables[] =
 "innodb_merge_sort_block_size",
 "innodb_mirrored_log_groups",
 "innodb_mtflush_threads",
-"innodb_page_cleaners",
 "innodb_persistent_stats_root_page",
 "innodb_print_lock_wait_timeout_info",
 "innodb_purge_run_now",
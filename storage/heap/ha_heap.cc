@@ -611,6 +611,7 @@ static int heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   ha_rows max_rows;
   HP_KEYDEF *keydef;
   HA_KEYSEG *seg;
+  HP_BLOB_DESC *blob_desc;
   bool found_real_auto_increment= 0;
 
   bzero(hp_create_info, sizeof(*hp_create_info));
@@ -622,8 +623,16 @@ static int heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
                        MYF(MY_WME | MY_THREAD_SPECIFIC),
                        &keydef, keys * sizeof(HP_KEYDEF),
                        &seg, parts * sizeof(HA_KEYSEG),
+                       &blob_desc, share->blob_fields * sizeof(HP_BLOB_DESC),
                        NULL))
     return my_errno;
+  /* blob_field[] lists the blob columns in record order */
+  for (uint i= 0; i < share->blob_fields; i++)
+  {
+    Field_blob *field= (Field_blob*) table_arg->field[share->blob_field[i]];
+    blob_desc[i].offset= (uint) (field->ptr - table_arg->record[0]);
+    blob_desc[i].packlength= field->pack_length_no_ptr();
+  }
   for (key= 0; key < keys; key++)
   {
     KEY *pos= table_arg->key_info+key;
@@ -728,6 +737,8 @@ static int heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   hp_create_info->keys= share->keys;
   hp_create_info->reclength= share->reclength;
   hp_create_info->keydef= keydef;
+  hp_create_info->blobs= share->blob_fields;
+  hp_create_info->blob_descs= blob_desc;
   return 0;
 }
 
@@ -822,7 +833,8 @@ int ha_heap::find_unique_row(uchar *record, uint unique_idx)
         We compare it only by record in the index, so better to read all
         records.
       */
-      memcpy(record, file->current_ptr, (size_t) share->reclength);
+      if (hp_extract_record(file, record, file->current_ptr))
+        DBUG_RETURN(-1);
 
       DBUG_RETURN(0); // found and position set
     }
@@ -33,6 +33,14 @@ C_MODE_START
 #define HP_MIN_RECORDS_IN_BLOCK 16
 #define HP_MAX_RECORDS_IN_BLOCK 8192
 
+/*
+  Size of one blob continuation block: a pointer to the next block of
+  the chain followed by HP_BLOB_CHUNK_DATA bytes of blob data.
+*/
+
+#define HP_BLOB_CHUNK_LENGTH 256
+#define HP_BLOB_CHUNK_DATA (HP_BLOB_CHUNK_LENGTH - sizeof(uchar*))
+
 	/* Some extern variables */
 
 extern LIST *heap_open_list,*heap_share_list;
@@ -100,6 +108,14 @@ extern void hp_clear(HP_SHARE *info);
 extern void hp_clear_keys(HP_SHARE *info);
 extern uint hp_rb_pack_key(HP_KEYDEF *keydef, uchar *key, const uchar *old,
                            key_part_map keypart_map);
+extern int hp_write_blobs(HP_SHARE *share, const uchar *record,
+                          uchar **heads);
+extern void hp_store_blob_heads(HP_SHARE *share, uchar *pos, uchar **heads);
+extern void hp_free_blob_heads(HP_SHARE *share, uchar **heads);
+extern void hp_free_blobs(HP_SHARE *share, uchar *pos);
+extern int hp_extract_record(HP_INFO *info, uchar *record, const uchar *pos);
+extern int hp_blob_rec_cmp(HP_SHARE *share, const uchar *pos,
+                           const uchar *record);
 
 extern mysql_mutex_t THR_LOCK_heap;
 
@@ -0,0 +1,299 @@
+/* Copyright (c) 2021, MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/*
+  Storage of BLOB columns.
+
+  A stored record keeps the blob length as it is in the table record, but
+  the data pointer is replaced by a pointer to the first of a chain of
+  continuation blocks in HP_SHARE::blob_block. Each continuation block
+  starts with a pointer to the next block of the chain and holds up to
+  HP_BLOB_CHUNK_DATA bytes of data. Free continuation blocks are linked
+  from HP_SHARE::blob_del_link.
+
+  VARCHAR columns are not moved out of the record. They are usually key
+  parts, and the hash and tree key functions in hp_hash.c read key
+  columns directly from stored records at the offsets of the table
+  record (HA_KEYSEG::start). Storing VARCHAR data in chains saves memory
+  only if the stored record becomes shorter than reclength, which would
+  change those offsets for every key part and every record copy.
+*/
+
+#include "heapdef.h"
+
+static ulong hp_blob_length(uint packlength, const uchar *pos)
+{
+  switch (packlength) {
+  case 1:
+    return (ulong) *pos;
+  case 2:
+    return (ulong) uint2korr(pos);
+  case 3:
+    return (ulong) uint3korr(pos);
+  case 4:
+    return (ulong) uint4korr(pos);
+  default:
+    DBUG_ASSERT(0);
+  }
+  return 0;
+}
+
+
+	/* Find where to place a new continuation block */
+
+static uchar *next_free_chunk(HP_SHARE *share)
+{
+  ulong block_pos;
+  size_t length;
+
+  if (share->blob_del_link)
+  {
+    uchar *pos= share->blob_del_link;
+    share->blob_del_link= *((uchar**) pos);
+    return pos;
+  }
+  if (share->data_length + share->index_length >= share->max_table_size)
+  {
+    my_errno= HA_ERR_RECORD_FILE_FULL;
+    return NULL;
+  }
+  if (!(block_pos= share->blob_chunks % share->blob_block.records_in_block))
+  {
+    if (hp_get_new_block(share, &share->blob_block, &length))
+      return NULL;
+    share->data_length+= length;
+  }
+  share->blob_chunks++;
+  return ((uchar*) share->blob_block.level_info[0].last_blocks +
+          block_pos * share->blob_block.recbuffer);
+}
+
+
+static void free_chain(HP_SHARE *share, uchar *chunk)
+{
+  while (chunk)
+  {
+    uchar *next= *((uchar**) chunk);
+    *((uchar**) chunk)= share->blob_del_link;
+    share->blob_del_link= chunk;
+    chunk= next;
+  }
+}
+
+
+static int write_chain(HP_SHARE *share, const uchar *data, size_t length,
+                       uchar **head)
+{
+  uchar **link= head;
+
+  *head= NULL;
+  while (length)
+  {
+    size_t part= MY_MIN(length, HP_BLOB_CHUNK_DATA);
+    uchar *chunk;
+    if (!(chunk= next_free_chunk(share)))
+    {
+      free_chain(share, *head);
+      *head= NULL;
+      return my_errno;
+    }
+    *((uchar**) chunk)= NULL;
+    memcpy(chunk + sizeof(uchar*), data, part);
+    *link= chunk;
+    link= (uchar**) chunk;
+    data+= part;
+    length-= part;
+  }
+  return 0;
+}
+
+
+/*
+  Copy the blobs of a table record to new continuation block chains
+
+  SYNOPSIS
+    hp_write_blobs()
+    share               Heap table share
+    record              Table record with the blob data pointers
+    heads         OUT   First continuation block of each blob column
+
+  NOTE
+    The chains are not linked to any stored record. On success the caller
+    either stores them with hp_store_blob_heads() or releases them with
+    hp_free_blob_heads().
+
+  RETURN
+    0      OK
+    #      Error number; no blocks are kept in this case
+*/
+
+int hp_write_blobs(HP_SHARE *share, const uchar *record, uchar **heads)
+{
+  HP_BLOB_DESC *desc, *end;
+  DBUG_ENTER("hp_write_blobs");
+
+  for (desc= share->blob_descs, end= desc + share->blobs; desc < end;
+       desc++, heads++)
+  {
+    const uchar *data;
+    memcpy(&data, record + desc->offset + desc->packlength, sizeof(data));
+    if (write_chain(share, data,
+                    hp_blob_length(desc->packlength, record + desc->offset),
+                    heads))
+    {
+      /* Release the chains of the columns before this one */
+      while (desc-- > share->blob_descs)
+        free_chain(share, *--heads);
+      DBUG_RETURN(my_errno);
+    }
+  }
+  DBUG_RETURN(0);
+}
+
+
+void hp_store_blob_heads(HP_SHARE *share, uchar *pos, uchar **heads)
+{
+  HP_BLOB_DESC *desc, *end;
+  for (desc= share->blob_descs, end= desc + share->blobs; desc < end;
+       desc++, heads++)
+    memcpy(pos + desc->offset + desc->packlength, heads, sizeof(uchar*));
+}
+
+
+void hp_free_blob_heads(HP_SHARE *share, uchar **heads)
+{
+  uint i;
+  for (i= 0; i < share->blobs; i++)
+    free_chain(share, heads[i]);
+}
+
+
+	/* Release the continuation blocks of a stored record */
+
+void hp_free_blobs(HP_SHARE *share, uchar *pos)
+{
+  HP_BLOB_DESC *desc, *end;
+  for (desc= share->blob_descs, end= desc + share->blobs; desc < end; desc++)
+  {
+    uchar *chunk;
+    memcpy(&chunk, pos + desc->offset + desc->packlength, sizeof(chunk));
+    free_chain(share, chunk);
+  }
+}
+
+
+/*
+  Copy a stored record to a table record
+
+  SYNOPSIS
+    hp_extract_record()
+    info                Heap table handler
+    record        OUT   Table record
+    pos                 Stored record
+
+  NOTE
+    The blob data is collected in HP_INFO::blob_buff and the blob pointers
+    of 'record' point there; they stay valid until the next read through
+    the same handler.
+
+  RETURN
+    0      OK
+    #      Error number
+*/
+
+int hp_extract_record(HP_INFO *info, uchar *record, const uchar *pos)
+{
+  HP_SHARE *share= info->s;
+  HP_BLOB_DESC *desc, *end;
+  size_t total_length= 0;
+  uchar *to;
+
+  memcpy(record, pos, (size_t) share->reclength);
+  if (!share->blobs)
+    return 0;
+
+  end= share->blob_descs + share->blobs;
+  for (desc= share->blob_descs; desc < end; desc++)
+    total_length+= hp_blob_length(desc->packlength, pos + desc->offset);
+  if (total_length > info->blob_buff_length)
+  {
+    uchar *buff;
+    if (!(buff= (uchar*) my_realloc(hp_key_memory_HP_INFO, info->blob_buff,
+                                    total_length,
+                                    MYF(MY_ALLOW_ZERO_PTR |
+                                        (share->internal ?
+                                         MY_THREAD_SPECIFIC : 0)))))
+      return my_errno= HA_ERR_OUT_OF_MEM;
+    info->blob_buff= buff;
+    info->blob_buff_length= total_length;
+  }
+
+  for (desc= share->blob_descs, to= info->blob_buff; desc < end; desc++)
+  {
+    size_t length= hp_blob_length(desc->packlength, pos + desc->offset);
+    const uchar *chunk;
+    memcpy(&chunk, pos + desc->offset + desc->packlength, sizeof(chunk));
+    memcpy(record + desc->offset + desc->packlength, &to, sizeof(to));
+    while (length)
+    {
+      size_t part= MY_MIN(length, HP_BLOB_CHUNK_DATA);
+      memcpy(to, chunk + sizeof(uchar*), part);
+      to+= part;
+      length-= part;
+      memcpy(&chunk, chunk, sizeof(chunk));
+    }
+  }
+  return 0;
+}
+
+
+/*
+  Compare a stored record with a table record
+
+  RETURN
+    0   Records are equal
+    1   Records differ
+*/
+
+int hp_blob_rec_cmp(HP_SHARE *share, const uchar *pos, const uchar *record)
+{
+  HP_BLOB_DESC *desc, *end;
+  uint start= 0;
+
+  for (desc= share->blob_descs, end= desc + share->blobs; desc < end; desc++)
+  {
+    uint ptr_offset= desc->offset + desc->packlength;
+    size_t length= hp_blob_length(desc->packlength, pos + desc->offset);
+    const uchar *chunk, *data;
+
+    /* This also compares the blob lengths */
+    if (memcmp(pos + start, record + start, ptr_offset - start))
+      return 1;
+    memcpy(&chunk, pos + ptr_offset, sizeof(chunk));
+    memcpy(&data, record + ptr_offset, sizeof(data));
+    while (length)
+    {
+      size_t part= MY_MIN(length, HP_BLOB_CHUNK_DATA);
+      if (memcmp(chunk + sizeof(uchar*), data, part))
+        return 1;
+      data+= part;
+      length-= part;
+      memcpy(&chunk, chunk, sizeof(chunk));
+    }
+    start= ptr_offset + sizeof(uchar*);
+  }
+  return MY_TEST(memcmp(pos + start, record + start,
+                        share->reclength - start));
+}
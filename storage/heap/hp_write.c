@@ -44,6 +44,15 @@ int heap_write(HP_INFO *info, const uchar *record)
 #endif
   if (!(pos=next_free_record_pos(share)))
     DBUG_RETURN(my_errno);
+  if (share->blobs && hp_write_blobs(share, record, info->blob_heads))
+  {
+    /* No key is written yet, just give the position back */
+    share->deleted++;
+    *((uchar**) pos)=share->del_link;
+    share->del_link=pos;
+    pos[share->visible]= 0;
+    DBUG_RETURN(my_errno);
+  }
   share->changed=1;
 
   for (keydef = share->keydef, end = keydef + share->keys; keydef < end;
@@ -54,6 +63,8 @@ int heap_write(HP_INFO *info, const uchar *record)
   }
 
   memcpy(pos,record,(size_t) share->reclength);
+  if (share->blobs)
+    hp_store_blob_heads(share, pos, info->blob_heads);
   pos[share->visible]= 1;                     /* Mark record as not deleted */
   if (++share->records == share->blength)
     share->blength+= share->blength;
@@ -86,6 +97,8 @@ int heap_write(HP_INFO *info, const uchar *record)
       break;
     keydef--;
   } 
+  if (share->blobs)
+    hp_free_blob_heads(share, info->blob_heads);
 
   share->deleted++;
   *((uchar**) pos)=share->del_link;
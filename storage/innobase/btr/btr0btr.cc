@@ -1238,6 +1238,45 @@ void btr_free(const page_id_t page_id)
 	mtr.commit();
 }
 
+/** Remove all records from a persistent index tree, keeping the root page.
+This is used for rolling back TRX_UNDO_EMPTY.
+@param[in,out]	index	index tree */
+void btr_clear_index(dict_index_t* index)
+{
+	ut_ad(!index->table->is_temporary());
+	ut_ad(!index->is_spatial());
+
+	mtr_t	mtr;
+	mtr.start();
+	index->set_modified(mtr);
+	mtr_x_lock_index(index, &mtr);
+
+	buf_block_t*	root = btr_root_block_get(index, RW_X_LATCH, &mtr);
+
+	if (!root) {
+		mtr.commit();
+		return;
+	}
+
+	/* This frees the leaf segment, and the pages of the
+	non-leaf segment except the root page. */
+	btr_free_but_not_root(root, mtr.get_log_mode());
+
+	/* Create a new leaf segment. fseg_create() expects the page to be
+	of FIL_PAGE_TYPE_SYS, like in btr_create(). No space needs to be
+	reserved, because the inode of the freed leaf segment can be
+	reused. */
+	const uint16_t	type = fil_page_get_type(root->frame);
+	mtr.write<2>(*root, FIL_PAGE_TYPE + root->frame, FIL_PAGE_TYPE_SYS);
+	mtr.memset(root, PAGE_HEADER + PAGE_BTR_SEG_LEAF, FSEG_HEADER_SIZE, 0);
+	ut_a(fseg_create(index->table->space, PAGE_HEADER + PAGE_BTR_SEG_LEAF,
+			 &mtr, true, root));
+	mtr.write<2>(*root, FIL_PAGE_TYPE + root->frame, type);
+
+	btr_page_empty(root, buf_block_get_page_zip(root), index, 0, &mtr);
+	mtr.commit();
+}
+
 /** Read the last used AUTO_INCREMENT value from PAGE_ROOT_AUTO_INC.
 @param[in,out]	index	clustered index
 @return	the last used AUTO_INCREMENT value
@@ -67,6 +67,7 @@ Created 11/5/1995 Heikki Tuuri
 #include "sync0sync.h"
 #include "buf0dump.h"
 #include <map>
+#include <vector>
 #include <sstream>
 
 using st_::span;
@@ -1521,6 +1522,26 @@ bool buf_pool_t::create()
   ut_ad(is_initialised());
   mysql_mutex_init(buf_pool_mutex_key, &mutex, MY_MUTEX_INIT_FAST);
 
+  n_free_shards= srv_buf_pool_free_shards;
+  n_shard_free= 0;
+  if (n_free_shards > 1)
+  {
+    free_shards= static_cast<free_shard_t*>
+      (aligned_malloc(n_free_shards * sizeof *free_shards, CACHE_LINE_SIZE));
+    for (ulint i= 0; i < n_free_shards; i++)
+    {
+      free_shard_t &shard= free_shards[i];
+      mysql_mutex_init(buf_pool_free_shard_mutex_key, &shard.mutex,
+                       MY_MUTEX_INIT_FAST);
+      UT_LIST_INIT(shard.free, &buf_page_t::list);
+      shard.len= 0;
+      shard.hits= 0;
+      shard.refills= 0;
+    }
+  }
+  else
+    free_shards= nullptr;
+
   UT_LIST_INIT(LRU, &buf_page_t::LRU);
   UT_LIST_INIT(withdraw, &buf_page_t::list);
   withdraw_target= 0;
@@ -1557,7 +1578,7 @@ bool buf_pool_t::create()
   ut_d(lru_scan_itr.m_mutex= &mutex);
 
   io_buf.create((srv_n_read_io_threads + srv_n_write_io_threads) *
-                OS_AIO_N_PENDING_IOS_PER_THREAD);
+                OS_AIO_N_PENDING_IOS_PER_THREAD + srv_n_page_cleaners);
 
   /* FIXME: remove some of these variables */
   srv_buf_pool_curr_size= curr_pool_size;
@@ -1568,9 +1589,27 @@ bool buf_pool_t::create()
   buf_LRU_old_ratio_update(100 * 3 / 8, false);
   btr_search_sys_create();
   ut_ad(is_initialised());
+  register_io_buffers();
   return false;
 }
 
+void buf_pool_t::register_io_buffers() const
+{
+  if (!srv_thread_pool)
+    return;
+
+  std::vector<tpool::aio_buffer> bufs;
+  bufs.reserve(n_chunks);
+  for (const chunk_t *chunk= chunks; chunk != chunks + n_chunks; chunk++)
+    bufs.push_back(tpool::aio_buffer{chunk->mem, chunk->mem_size()});
+
+  /* This is only an optimization. It fails with other than io_uring,
+  or if the memory cannot be locked. */
+  if (!srv_thread_pool->register_buffers(bufs.data(), bufs.size()))
+    ib::info() << "Registered " << bufs.size()
+               << " buffer pool chunks for io_uring";
+}
+
 /** Clean up after successful create() */
 void buf_pool_t::close()
 {
@@ -1581,6 +1620,14 @@ void buf_pool_t::close()
   mysql_mutex_destroy(&mutex);
   mysql_mutex_destroy(&flush_list_mutex);
 
+  if (free_shards)
+  {
+    for (ulint i= 0; i < n_free_shards; i++)
+      mysql_mutex_destroy(&free_shards[i].mutex);
+    aligned_free(free_shards);
+    free_shards= nullptr;
+  }
+
   for (buf_page_t *bpage= UT_LIST_GET_LAST(LRU), *prev_bpage= nullptr; bpage;
        bpage= prev_bpage)
   {
@@ -1783,6 +1830,7 @@ inline bool buf_pool_t::withdraw_blocks()
 		ulint	count1 = 0;
 
 		mysql_mutex_lock(&mutex);
+		free_shards_drain();
 		block = reinterpret_cast<buf_block_t*>(
 			UT_LIST_GET_FIRST(free));
 		while (block != NULL
@@ -2181,6 +2229,9 @@ inline void buf_pool_t::resize()
 
 	chunk_t::map_reg = UT_NEW_NOKEY(chunk_t::map());
 
+	/* The registered I/O buffers must not refer to freed chunks */
+	srv_thread_pool->unregister_buffers();
+
 	/* add/delete chunks */
 
 	buf_resize_status("buffer pool resizing with chunks "
@@ -2316,6 +2367,8 @@ inline void buf_pool_t::resize()
 	chunk_t::map* chunk_map_old = chunk_t::map_ref;
 	chunk_t::map_ref = chunk_t::map_reg;
 
+	register_io_buffers();
+
 	/* set size */
 	ut_ad(UT_LIST_GET_LEN(withdraw) == 0);
   ulint s= curr_size;
@@ -4393,6 +4446,9 @@ void buf_pool_t::validate()
 	ulint		n_zip		= 0;
 
 	mysql_mutex_lock(&mutex);
+	/* Make the free list complete. No block can be moved back to
+	free_shards while we are holding mutex. */
+	free_shards_drain();
 
 	chunk_t* chunk = chunks;
 
@@ -4513,7 +4569,7 @@ void buf_pool_t::print()
 	ib::info()
 		<< "[buffer pool: size=" << curr_size
 		<< ", database pages=" << UT_LIST_GET_LEN(LRU)
-		<< ", free pages=" << UT_LIST_GET_LEN(free)
+		<< ", free pages=" << free_len()
 		<< ", modified database pages="
 		<< UT_LIST_GET_LEN(flush_list)
 		<< ", n pending decompressions=" << n_pend_unzip
@@ -4626,7 +4682,22 @@ void buf_stats_get_pool_info(buf_pool_info_t *pool_info)
 
 	pool_info->old_lru_len = buf_pool.LRU_old_len;
 
-	pool_info->free_list_len = UT_LIST_GET_LEN(buf_pool.free);
+	pool_info->free_list_len = buf_pool.free_len();
+
+	pool_info->n_free_shards = buf_pool.n_free_shards;
+	pool_info->free_shard_hits = 0;
+	pool_info->free_shard_refills = 0;
+
+	if (buf_pool.free_shards) {
+		/* The counters are updated while holding the shard
+		mutexes. We only read them. */
+		for (ulint i = 0; i < buf_pool.n_free_shards; i++) {
+			pool_info->free_shard_hits
+				+= buf_pool.free_shards[i].hits;
+			pool_info->free_shard_refills
+				+= buf_pool.free_shards[i].refills;
+		}
+	}
 
 	pool_info->flush_list_len = UT_LIST_GET_LEN(buf_pool.flush_list);
 
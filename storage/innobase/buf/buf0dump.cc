@@ -42,6 +42,7 @@ Created April 08, 2011 Vasil Dimov
 #include "ut0byte.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "mysql/service_wsrep.h" /* wsrep_recovery */
 #include <my_service_manager.h>
@@ -421,12 +422,14 @@ buf_load_throttle_if_needed(
 	ulint*	last_check_time,	/*!< in/out: milliseconds since epoch
 					of the last time we did check if
 					throttling is needed, we do the check
-					every srv_io_capacity IO ops. */
+					every capacity IO ops. */
 	ulint*	last_activity_count,
-	ulint	n_io)			/*!< in: number of IO ops done since
+	ulint	n_io,			/*!< in: number of IO ops done since
 					buffer pool load has started */
+	ulint	capacity)		/*!< in: IO ops per second allowed
+					while there is other activity */
 {
-	if (n_io % srv_io_capacity < srv_io_capacity - 1) {
+	if (n_io % capacity < capacity - 1) {
 		return;
 	}
 
@@ -436,7 +439,7 @@ buf_load_throttle_if_needed(
 		return;
 	}
 
-	/* srv_io_capacity IO operations have been performed by buffer pool
+	/* capacity IO operations have been performed by buffer pool
 	load since the last time we were here. */
 
 	/* If no other activity, then keep going without any delay. */
@@ -462,7 +465,7 @@ buf_load_throttle_if_needed(
 	   again.
 	5. There has been more other activity and thus we enter here.
 	6. Now last_check_time is recent and we sleep if necessary to prevent
-	   more than srv_io_capacity IO operations per second.
+	   more than capacity IO operations per second.
 	The deficiency is that we could have slept at 3., but for this we
 	would have to update last_check_time before the
 	"cur_activity_count == *last_activity_count" check and calling
@@ -476,6 +479,121 @@ buf_load_throttle_if_needed(
 	*last_activity_count = srv_get_activity_count();
 }
 
+/** Number of pages in the first buf_load() segment. Each subsequent
+segment is twice as large, up to BUF_LOAD_SEGMENT_MAX pages. */
+static constexpr ulint BUF_LOAD_SEGMENT_MIN = 1024;
+/** Maximum number of pages in a buf_load() segment */
+static constexpr ulint BUF_LOAD_SEGMENT_MAX = 65536;
+
+#ifdef UNIV_DEBUG
+/** Number of dump entries processed by buf_load() readers, for
+innodb_buffer_pool_load_pages_abort */
+static Atomic_counter<ulint> buf_load_n_processed;
+#endif
+
+/** A buf_load() reader, submitting asynchronous reads for a range
+of a segment that is sorted by (space, page) */
+struct buf_load_reader_t
+{
+	/** first page to read */
+	const page_id_t*	first;
+	/** end of the pages to read */
+	const page_id_t*	end;
+	/** the task that is executing read(), or nullptr */
+	tpool::waitable_task*	task;
+	/** reads per second that this reader may submit while there
+	is other activity */
+	ulint			capacity;
+	/** @see buf_load_throttle_if_needed() */
+	ulint			last_check_time;
+	/** @see buf_load_throttle_if_needed() */
+	ulint			last_activity_count;
+	/** number of pages processed by this reader */
+	ulint			n_io;
+
+	/** Submit the reads of the pages from first to end. */
+	void read();
+};
+
+void buf_load_reader_t::read()
+{
+	/* Avoid calling the expensive fil_space_t::get() for each
+	page within the same tablespace. The range is sorted by
+	(space, page), so all pages from a given tablespace are
+	consecutive, and adjacent pages will be submitted in order. */
+	ulint		cur_space_id = first->space();
+	fil_space_t*	space = fil_space_t::get(cur_space_id);
+	ulint		zip_size = space ? space->zip_size() : 0;
+
+	for (const page_id_t* p = first;
+	     p != end && !SHUTTING_DOWN() && !buf_load_abort_flag; p++) {
+
+#ifdef UNIV_DEBUG
+		/* Count every entry of the dump, also the ones that
+		will be skipped below. */
+		if (++buf_load_n_processed >= srv_buf_pool_load_pages_abort) {
+			buf_load_abort_flag = true;
+		}
+#endif
+
+		/* space_id for this iteration of the loop */
+		const ulint	this_space_id = p->space();
+
+		if (this_space_id == SRV_TMP_SPACE_ID) {
+			/* Ignore the innodb_temporary tablespace. */
+			continue;
+		}
+
+		if (this_space_id != cur_space_id) {
+			if (space) {
+				space->release();
+			}
+
+			cur_space_id = this_space_id;
+			space = fil_space_t::get(cur_space_id);
+
+			if (!space) {
+				continue;
+			}
+
+			zip_size = space->zip_size();
+		}
+
+		/* JAN: TODO: As we use background page read below,
+		if tablespace is encrypted we cant use it. */
+		if (!space || p->page_no() >= space->get_size() ||
+		    (space->crypt_data &&
+		     space->crypt_data->encryption != FIL_ENCRYPTION_OFF &&
+		     space->crypt_data->type != CRYPT_SCHEME_UNENCRYPTED)) {
+			continue;
+		}
+
+		if (space->is_stopping()) {
+			space->release();
+			space = nullptr;
+			continue;
+		}
+
+		space->reacquire();
+		buf_read_page_background(space, *p, zip_size, true);
+
+		buf_load_throttle_if_needed(
+			&last_check_time, &last_activity_count, n_io++,
+			capacity);
+	}
+
+	if (space) {
+		space->release();
+	}
+}
+
+/** Execute buf_load_reader_t::read() in a task.
+@param reader  buf_load_reader_t */
+static void buf_load_reader_task(void* reader)
+{
+	static_cast<buf_load_reader_t*>(reader)->read();
+}
+
 /*****************************************************************//**
 Perform a buffer pool load from the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -618,99 +736,102 @@ buf_load()
 		return;
 	}
 
-	if (!SHUTTING_DOWN()) {
-		std::sort(dump, dump + dump_n);
-	}
+	/* The dump was written in buf_pool.LRU order, starting from the
+	most recently used page. Load it in segments of increasing size,
+	so that the hottest pages will be loaded first. Each segment is
+	sorted by (space, page) and split between multiple readers. */
+	const ulint n_readers = std::max<ulint>(srv_n_read_io_threads, 1);
+	std::vector<buf_load_reader_t> readers(n_readers);
 
-	ulint		last_check_time = 0;
-	ulint		last_activity_cnt = 0;
+	for (buf_load_reader_t& r : readers) {
+		r.task = nullptr;
+		r.capacity = std::max<ulint>(srv_io_capacity / n_readers, 1);
+		r.last_check_time = 0;
+		r.last_activity_count = 0;
+		r.n_io = 0;
+	}
 
-	/* Avoid calling the expensive fil_space_t::get() for each
-	page within the same tablespace. dump[] is sorted by (space, page),
-	so all pages from a given tablespace are consecutive. */
-	ulint		cur_space_id = dump[0].space();
-	fil_space_t*	space = fil_space_t::get(cur_space_id);
-	ulint		zip_size = space ? space->zip_size() : 0;
+	ut_d(buf_load_n_processed = 0);
 
 	PSI_stage_progress*	pfs_stage_progress __attribute__((unused))
 		= mysql_set_stage(srv_stage_buffer_pool_load.m_key);
 	mysql_stage_set_work_estimated(pfs_stage_progress, dump_n);
 	mysql_stage_set_work_completed(pfs_stage_progress, 0);
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
-
-		/* space_id for this iteration of the loop */
-		const ulint	this_space_id = dump[i].space();
+	i = 0;
 
-		if (this_space_id == SRV_TMP_SPACE_ID) {
-			/* Ignore the innodb_temporary tablespace. */
-			continue;
+	for (ulint n_segment = BUF_LOAD_SEGMENT_MIN; i < dump_n;
+	     n_segment = std::min(2 * n_segment, BUF_LOAD_SEGMENT_MAX)) {
+		if (SHUTTING_DOWN() || buf_load_abort_flag) {
+			break;
 		}
 
-		if (this_space_id != cur_space_id) {
-			if (space) {
-				space->release();
-			}
+		page_id_t*	first = dump + i;
+		const ulint	n = std::min(n_segment, dump_n - i);
+		std::sort(first, first + n);
 
-			cur_space_id = this_space_id;
-			space = fil_space_t::get(cur_space_id);
+		for (ulint r = 0; r < n_readers; r++) {
+			readers[r].first = first + n * r / n_readers;
+			readers[r].end = first + n * (r + 1) / n_readers;
+		}
 
-			if (!space) {
+		bool	submitted = false;
+
+		for (ulint r = 1; r < n_readers; r++) {
+			if (readers[r].first == readers[r].end) {
 				continue;
 			}
-
-			zip_size = space->zip_size();
+			readers[r].task = new tpool::waitable_task(
+				buf_load_reader_task, &readers[r]);
+			srv_thread_pool->submit_task(readers[r].task);
+			submitted = true;
 		}
 
-		/* JAN: TODO: As we use background page read below,
-		if tablespace is encrypted we cant use it. */
-		if (!space || dump[i].page_no() >= space->get_size() ||
-		    (space->crypt_data &&
-		     space->crypt_data->encryption != FIL_ENCRYPTION_OFF &&
-		     space->crypt_data->type != CRYPT_SCHEME_UNENCRYPTED)) {
-			continue;
+		if (readers[0].first != readers[0].end) {
+			readers[0].read();
 		}
 
-		if (space->is_stopping()) {
-			space->release();
-			space = nullptr;
-			continue;
+		/* buf_load() runs in a task of srv_thread_pool. Allow the
+		thread pool to run the other readers while we are waiting
+		for them. */
+		if (submitted) {
+			tpool::tpool_wait_begin();
 		}
 
-		space->reacquire();
-		buf_read_page_background(space, dump[i], zip_size, true);
-
-		if (buf_load_abort_flag) {
-			if (space) {
-				space->release();
+		for (ulint r = 1; r < n_readers; r++) {
+			if (readers[r].task) {
+				readers[r].task->wait();
+				delete readers[r].task;
+				readers[r].task = nullptr;
 			}
-			buf_load_abort_flag = false;
-			ut_free(dump);
-			buf_load_status(
-				STATUS_INFO,
-				"Buffer pool(s) load aborted on request");
-			/* Premature end, set estimated = completed = i and
-			end the current stage event. */
-
-			mysql_stage_set_work_estimated(pfs_stage_progress, i);
-			mysql_stage_set_work_completed(pfs_stage_progress, i);
-
-			mysql_end_stage();
-			return;
 		}
 
-		buf_load_throttle_if_needed(
-			&last_check_time, &last_activity_cnt, i);
+		if (submitted) {
+			tpool::tpool_wait_end();
+		}
 
-#ifdef UNIV_DEBUG
-		if ((i+1) >= srv_buf_pool_load_pages_abort) {
-			buf_load_abort_flag = true;
+		if (SHUTTING_DOWN() || buf_load_abort_flag) {
+			break;
 		}
-#endif
+
+		i += n;
+		mysql_stage_set_work_completed(pfs_stage_progress, i);
 	}
 
-	if (space) {
-		space->release();
+	if (buf_load_abort_flag) {
+		buf_load_abort_flag = false;
+		ut_free(dump);
+		buf_load_status(
+			STATUS_INFO,
+			"Buffer pool(s) load aborted on request");
+		/* Premature end, set estimated = completed = i and
+		end the current stage event. */
+
+		mysql_stage_set_work_estimated(pfs_stage_progress, i);
+		mysql_stage_set_work_completed(pfs_stage_progress, i);
+
+		mysql_end_stage();
+		return;
 	}
 
 	ut_free(dump);
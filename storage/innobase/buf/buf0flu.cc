@@ -85,6 +85,12 @@ static struct
   ulint flush_time;
   /** number of adaptive flushing passes */
   ulint flush_pass;
+  /** number of pages submitted for writing by page cleaner workers */
+  Atomic_counter<ulint> worker_pages;
+  /** total time that page cleaner workers spent preparing and submitting
+  writes, in microseconds; this does not include the completion of
+  asynchronous writes */
+  Atomic_counter<ulint> worker_time;
 } page_cleaner;
 
 #ifdef UNIV_DEBUG
@@ -784,37 +790,20 @@ static void buf_release_freed_page(buf_page_t *bpage)
   mysql_mutex_unlock(&buf_pool.mutex);
 }
 
-/** Write a flushable page from buf_pool to a file.
-buf_pool.mutex must be held.
+/** Prepare and submit the write of a page that was io-fixed by
+buf_flush_page().
 @param bpage       buffer control block
 @param lru         true=buf_pool.LRU; false=buf_pool.flush_list
 @param space       tablespace
-@return whether the page was flushed and buf_pool.mutex was released */
-static bool buf_flush_page(buf_page_t *bpage, bool lru, fil_space_t *space)
+@return whether the write was submitted; if not, the page latch was
+released and the caller must reset the io_fix under buf_pool.mutex */
+static bool buf_flush_write(buf_page_t *bpage, bool lru, fil_space_t *space)
 {
-  ut_ad(bpage->in_file());
-  ut_ad(bpage->ready_for_flush());
-  ut_ad((space->purpose == FIL_TYPE_TEMPORARY) ==
-        (space == fil_system.temp_space));
-  ut_ad(space->purpose == FIL_TYPE_TABLESPACE ||
-        space->atomic_write_supported);
+  mysql_mutex_assert_not_owner(&buf_pool.mutex);
   ut_ad(space->referenced());
 
-  rw_lock_t *rw_lock;
-
-  if (bpage->state() != BUF_BLOCK_FILE_PAGE)
-    rw_lock= nullptr;
-  else
-  {
-    rw_lock= &reinterpret_cast<buf_block_t*>(bpage)->lock;
-    if (!rw_lock_sx_lock_nowait(rw_lock, BUF_IO_WRITE))
-      return false;
-  }
-
-  bpage->set_io_fix(BUF_IO_WRITE);
-  buf_flush_page_count++;
-  mysql_mutex_unlock(&buf_pool.mutex);
-  mysql_mutex_assert_not_owner(&buf_pool.flush_list_mutex);
+  rw_lock_t *rw_lock= bpage->state() == BUF_BLOCK_FILE_PAGE
+    ? &reinterpret_cast<buf_block_t*>(bpage)->lock : nullptr;
 
   /* We are holding rw_lock = buf_block_t::lock in SX mode except if
   this is a ROW_FORMAT=COMPRESSED page whose uncompressed page frame
@@ -856,8 +845,6 @@ static bool buf_flush_page(buf_page_t *bpage, bool lru, fil_space_t *space)
     {
       if (rw_lock)
         rw_lock_sx_unlock_gen(rw_lock, BUF_IO_WRITE);
-      mysql_mutex_lock(&buf_pool.mutex);
-      bpage->set_io_fix(BUF_IO_NONE);
       return false;
     }
   }
@@ -929,6 +916,175 @@ static bool buf_flush_page(buf_page_t *bpage, bool lru, fil_space_t *space)
   return true;
 }
 
+/** Number of queued pages per page cleaner worker after which
+buf_flush_batch_t::add() will write out the queued pages */
+static constexpr ulint BUF_FLUSH_WORKER_PAGES= 64;
+
+/** Pages of a flush batch that are assigned to a page cleaner worker */
+struct buf_flush_part_t
+{
+  /** io-fixed pages and their tablespaces, each holding a reference */
+  std::vector<std::pair<buf_page_t*,fil_space_t*>> pages;
+  /** the task that is executing write(), or nullptr */
+  tpool::waitable_task *task= nullptr;
+  /** true=buf_pool.LRU; false=buf_pool.flush_list */
+  bool lru;
+
+  /** Prepare and submit the writes of all pages. */
+  void write();
+};
+
+/** A flush batch whose page writes are distributed between
+innodb_page_cleaners workers. Only the thread that is running the
+batch (and has incremented buf_pool.n_flush_list or buf_pool.n_flush_LRU)
+may access the object. */
+struct buf_flush_batch_t
+{
+  /** the pages assigned to each worker */
+  std::vector<buf_flush_part_t> parts;
+  /** number of pages in parts[] */
+  ulint n_pending;
+
+  /** Queue a page for writing. buf_pool.mutex must not be held.
+  @param bpage  page that was io-fixed for writing by buf_flush_page()
+  @param space  tablespace */
+  void add(buf_page_t *bpage, fil_space_t *space);
+
+  /** Write out the queued pages. buf_pool.mutex must not be held. */
+  void write();
+};
+
+/** Pending flush_list and LRU batches, indexed by the "lru" flag */
+static buf_flush_batch_t buf_flush_batches[2];
+
+void buf_flush_part_t::write()
+{
+  const ulonglong start= my_interval_timer();
+
+  for (const auto &p : pages)
+  {
+    if (!buf_flush_write(p.first, lru, p.second))
+    {
+      mysql_mutex_lock(&buf_pool.mutex);
+      p.first->set_io_fix(BUF_IO_NONE);
+      mysql_mutex_unlock(&buf_pool.mutex);
+    }
+    p.second->release();
+  }
+
+  page_cleaner.worker_pages+= pages.size();
+  page_cleaner.worker_time+= (my_interval_timer() - start) / 1000;
+  pages.clear();
+}
+
+/** Execute buf_flush_part_t::write() in a page cleaner worker task.
+@param part  buf_flush_part_t */
+static void buf_flush_part_task(void *part)
+{
+  static_cast<buf_flush_part_t*>(part)->write();
+}
+
+void buf_flush_batch_t::add(buf_page_t *bpage, fil_space_t *space)
+{
+  mysql_mutex_assert_not_owner(&buf_pool.mutex);
+
+  if (parts.empty())
+  {
+    parts.resize(srv_n_page_cleaners);
+    for (auto &part : parts)
+      part.lru= this == &buf_flush_batches[true];
+  }
+
+  /* All pages of an extent are written by the same worker, so that
+  writes to adjacent pages will be submitted in ascending order. */
+  const page_id_t id= bpage->id();
+  space->reacquire();
+  parts[ut_fold_ulint_pair(id.space(), id.page_no() / FSP_EXTENT_SIZE) %
+        parts.size()].pages.emplace_back(bpage, space);
+
+  if (++n_pending >= parts.size() * BUF_FLUSH_WORKER_PAGES)
+    write();
+}
+
+void buf_flush_batch_t::write()
+{
+  mysql_mutex_assert_not_owner(&buf_pool.mutex);
+
+  bool submitted= false;
+
+  for (size_t i= 1; i < parts.size(); i++)
+  {
+    if (parts[i].pages.empty())
+      continue;
+    parts[i].task= new tpool::waitable_task(buf_flush_part_task, &parts[i]);
+    srv_thread_pool->submit_task(parts[i].task);
+    submitted= true;
+  }
+
+  parts[0].write();
+
+  /* An LRU batch may be run in a task of srv_thread_pool, for example
+  by buf_LRU_get_free_block() in a purge worker. Allow the thread pool
+  to run our worker tasks while we are waiting for them. */
+  if (submitted)
+    tpool::tpool_wait_begin();
+
+  for (size_t i= 1; i < parts.size(); i++)
+  {
+    if (parts[i].task)
+    {
+      parts[i].task->wait();
+      delete parts[i].task;
+      parts[i].task= nullptr;
+    }
+  }
+
+  if (submitted)
+    tpool::tpool_wait_end();
+
+  n_pending= 0;
+}
+
+/** Write a flushable page from buf_pool to a file.
+buf_pool.mutex must be held.
+@param bpage       buffer control block
+@param lru         true=buf_pool.LRU; false=buf_pool.flush_list
+@param space       tablespace
+@return whether the page was flushed and buf_pool.mutex was released */
+static bool buf_flush_page(buf_page_t *bpage, bool lru, fil_space_t *space)
+{
+  ut_ad(bpage->in_file());
+  ut_ad(bpage->ready_for_flush());
+  ut_ad((space->purpose == FIL_TYPE_TEMPORARY) ==
+        (space == fil_system.temp_space));
+  ut_ad(space->purpose == FIL_TYPE_TABLESPACE ||
+        space->atomic_write_supported);
+  ut_ad(space->referenced());
+
+  if (bpage->state() == BUF_BLOCK_FILE_PAGE &&
+      !rw_lock_sx_lock_nowait(&reinterpret_cast<buf_block_t*>(bpage)->lock,
+                              BUF_IO_WRITE))
+    return false;
+
+  bpage->set_io_fix(BUF_IO_WRITE);
+  buf_flush_page_count++;
+  mysql_mutex_unlock(&buf_pool.mutex);
+  mysql_mutex_assert_not_owner(&buf_pool.flush_list_mutex);
+
+  if (srv_n_page_cleaners > 1 && srv_thread_pool)
+  {
+    /* Let a page cleaner worker prepare and submit the write. */
+    buf_flush_batches[lru].add(bpage, space);
+    return true;
+  }
+
+  if (buf_flush_write(bpage, lru, space))
+    return true;
+  mysql_mutex_lock(&buf_pool.mutex);
+  bpage->set_io_fix(BUF_IO_NONE);
+  return false;
+}
+
 /** Check whether a page can be flushed from the buf_pool.
 @param id          page identifier
 @param fold        id.fold()
@@ -1149,7 +1305,7 @@ static ulint buf_free_from_unzip_LRU_list_batch(ulint max)
 
 	while (block
 	       && count < max
-	       && UT_LIST_GET_LEN(buf_pool.free) < srv_LRU_scan_depth
+	       && buf_pool.free_len() < srv_LRU_scan_depth
 	       && UT_LIST_GET_LEN(buf_pool.unzip_LRU)
 	       > UT_LIST_GET_LEN(buf_pool.LRU) / 10) {
 
@@ -1250,7 +1406,7 @@ static void buf_flush_LRU_list_batch(ulint max, flush_counters_t *n)
   for (buf_page_t *bpage= UT_LIST_GET_LAST(buf_pool.LRU);
        bpage && n->flushed + n->evicted < max &&
        UT_LIST_GET_LEN(buf_pool.LRU) > BUF_LRU_MIN_LEN &&
-       UT_LIST_GET_LEN(buf_pool.free) < free_limit;
+       buf_pool.free_len() < free_limit;
        ++scanned, bpage= buf_pool.lru_hp.get())
   {
     buf_page_t *prev= UT_LIST_GET_PREV(LRU, bpage);
@@ -1541,6 +1697,14 @@ ulint buf_flush_lists(ulint max_n, lsn_t lsn)
     ? buf_do_flush_list_batch(max_n, lsn)
     : buf_do_LRU_batch(max_n);
 
+  buf_flush_batch_t &batch= buf_flush_batches[!lsn];
+  if (batch.n_pending)
+  {
+    mysql_mutex_unlock(&buf_pool.mutex);
+    batch.write();
+    mysql_mutex_lock(&buf_pool.mutex);
+  }
+
   const auto n_flushing= --n_flush;
 
   buf_pool.try_LRU_scan= true;
@@ -1905,6 +2069,7 @@ static ulint page_cleaner_flush_pages_recommendation(ulint last_pages_in,
 	static	ulint		sum_pages = 0;
 	static	ulint		avg_page_rate = 0;
 	static	ulint		n_iterations = 0;
+	static	ulint		worker_page_rate = 0;
 	static	time_t		prev_time;
 	lsn_t			lsn_rate;
 	ulint			n_pages = 0;
@@ -1960,6 +2125,17 @@ static ulint page_cleaner_flush_pages_recommendation(ulint last_pages_in,
 		MONITOR_SET(MONITOR_FLUSH_ADAPTIVE_AVG_TIME, flush_tm);
 		MONITOR_SET(MONITOR_FLUSH_ADAPTIVE_AVG_PASS, flush_pass);
 
+		/* How many pages the page cleaner workers can prepare
+		(checksum, compress, encrypt) and submit per second */
+		if (const ulint worker_time = page_cleaner.worker_time) {
+			worker_page_rate = ulint(
+				double(page_cleaner.worker_pages) * 1000000.0
+				/ double(worker_time)
+				* double(srv_n_page_cleaners));
+			page_cleaner.worker_pages = 0;
+			page_cleaner.worker_time = 0;
+		}
+
 		prev_lsn = cur_lsn;
 		prev_time = curr_time;
 
@@ -2001,6 +2177,16 @@ static ulint page_cleaner_flush_pages_recommendation(ulint last_pages_in,
 		n_pages = srv_max_io_capacity;
 	}
 
+	/* Do not request more than the page cleaner workers can submit
+	in one second, so that the page cleaner will remain responsive
+	to furious flushing requests. This is a CPU limit: asynchronous
+	writes are not waited for, and the I/O rate is only limited by
+	innodb_io_capacity_max. */
+	if (worker_page_rate) {
+		n_pages = std::min(n_pages, std::max(worker_page_rate,
+						     ulint{srv_io_capacity}));
+	}
+
 	MONITOR_SET(MONITOR_FLUSH_N_TO_FLUSH_REQUESTED, n_pages);
 
 	MONITOR_SET(MONITOR_FLUSH_N_TO_FLUSH_BY_AGE, pages_for_lsn);
@@ -2015,7 +2201,8 @@ static ulint page_cleaner_flush_pages_recommendation(ulint last_pages_in,
 
 /******************************************************************//**
 page_cleaner thread tasked with flushing dirty pages from the buffer
-pools. As of now we'll have only one coordinator.
+pools. This is the coordinator; if innodb_page_cleaners>1, the page
+writes of each batch are prepared and submitted by worker tasks.
 @return a dummy parameter */
 static os_thread_ret_t DECLARE_THREAD(buf_flush_page_cleaner)(void*)
 {
@@ -2098,7 +2285,7 @@ static os_thread_ret_t DECLARE_THREAD(buf_flush_page_cleaner)(void*)
     Division by zero is not possible, because buf_pool.flush_list is
     guaranteed to be nonempty, and it is a subset of buf_pool.LRU. */
     const double dirty_pct= double(dirty_blocks) * 100.0 /
-      double(UT_LIST_GET_LEN(buf_pool.LRU) + UT_LIST_GET_LEN(buf_pool.free));
+      double(UT_LIST_GET_LEN(buf_pool.LRU) + buf_pool.free_len());
 
     if (dirty_pct < srv_max_dirty_pages_pct_lwm && !lsn_limit)
       continue;
@@ -51,6 +51,9 @@ allowed to point to either end of the LRU list. */
 
 static constexpr ulint BUF_LRU_OLD_TOLERANCE = 20;
 
+/** Maximum number of blocks to move to buf_pool.free_shards at a time */
+static constexpr ulint BUF_LRU_FREE_SHARD_BATCH = 32;
+
 /** The minimum amount of non-old blocks when the LRU_old list exists
 (that is, when there are more than BUF_LRU_OLD_MIN_LEN blocks).
 @see buf_LRU_old_adjust_len */
@@ -279,7 +282,103 @@ bool buf_LRU_scan_and_free_block(ulint limit)
     buf_LRU_free_from_common_LRU_list(limit);
 }
 
+/** Allocate a block from a free list shard without holding mutex.
+@return a block in state BUF_BLOCK_MEMORY
+@retval nullptr if the shard was empty */
+buf_block_t *buf_pool_t::free_shard_get()
+{
+  if (!free_shards)
+    return nullptr;
+  free_shard_t &shard= free_shards[get_rnd_value() % n_free_shards];
+  if (!shard.len)
+    return nullptr;
+
+  mysql_mutex_lock(&shard.mutex);
+  buf_block_t *block=
+    reinterpret_cast<buf_block_t*>(UT_LIST_GET_FIRST(shard.free));
+  if (block)
+  {
+    ut_ad(block->page.in_free_list);
+    ut_d(block->page.in_free_list= false);
+    ut_ad(!block->page.oldest_modification());
+    ut_ad(!block->page.in_LRU_list);
+    ut_a(!block->page.in_file());
+    UT_LIST_REMOVE(shard.free, &block->page);
+    shard.len= UT_LIST_GET_LEN(shard.free);
+    n_shard_free--;
+    shard.hits++;
+    /* No adaptive hash index entries may point to a free block. */
+    assert_block_ahi_empty(block);
+    /* The state is changed while holding shard.mutex, so that
+    validate() will see consistent counts after free_shards_drain(). */
+    block->page.set_state(BUF_BLOCK_MEMORY);
+  }
+  mysql_mutex_unlock(&shard.mutex);
+
+  if (block)
+    MEM_MAKE_ADDRESSABLE(block->frame, srv_page_size);
+  return block;
+}
+
+/** Move a batch of blocks from free to a free list shard. */
+void buf_pool_t::free_shard_refill()
+{
+  mysql_mutex_assert_owner(&mutex);
+  if (!free_shards || curr_size != old_size)
+    return;
+  /* Leave the majority of the blocks in free, so that threads that
+  find their shard empty do not have to resort to LRU eviction.
+  In total, the shards hold at most one batch each on average, and
+  never more blocks than are left in free. */
+  const ulint cached= n_shard_free;
+  const ulint cap= std::min(n_free_shards * BUF_LRU_FREE_SHARD_BATCH,
+                            free_len() / 2);
+  if (cached >= cap)
+    return;
+  ulint n= std::min(std::min(BUF_LRU_FREE_SHARD_BATCH, cap - cached),
+                    UT_LIST_GET_LEN(free) / (2 * n_free_shards));
+  if (!n)
+    return;
+  free_shard_t &shard= free_shards[get_rnd_value() % n_free_shards];
+  mysql_mutex_lock(&shard.mutex);
+  n_shard_free+= n;
+  shard.refills++;
+  do
+  {
+    buf_page_t *bpage= UT_LIST_GET_FIRST(free);
+    ut_ad(bpage->in_free_list);
+    UT_LIST_REMOVE(free, bpage);
+    UT_LIST_ADD_FIRST(shard.free, bpage);
+  }
+  while (--n);
+  shard.len= UT_LIST_GET_LEN(shard.free);
+  mysql_mutex_unlock(&shard.mutex);
+}
+
+/** Move all blocks from free_shards to free. */
+void buf_pool_t::free_shards_drain()
+{
+  mysql_mutex_assert_owner(&mutex);
+  if (!free_shards || !n_shard_free)
+    return;
+  for (ulint i= 0; i < n_free_shards; i++)
+  {
+    free_shard_t &shard= free_shards[i];
+    mysql_mutex_lock(&shard.mutex);
+    n_shard_free-= UT_LIST_GET_LEN(shard.free);
+    while (buf_page_t *bpage= UT_LIST_GET_FIRST(shard.free))
+    {
+      ut_ad(bpage->in_free_list);
+      UT_LIST_REMOVE(shard.free, bpage);
+      UT_LIST_ADD_LAST(free, bpage);
+    }
+    shard.len= 0;
+    mysql_mutex_unlock(&shard.mutex);
+  }
+}
+
 /** @return a buffer block from the buf_pool.free list
+(or buf_pool.free_shards if buf_pool.free is empty)
 @retval	NULL	if the free list is empty */
 buf_block_t* buf_LRU_get_free_only()
 {
@@ -287,6 +386,10 @@ buf_block_t* buf_LRU_get_free_only()
 
 	mysql_mutex_assert_owner(&buf_pool.mutex);
 
+	if (!UT_LIST_GET_LEN(buf_pool.free)) {
+		buf_pool.free_shards_drain();
+	}
+
 	block = reinterpret_cast<buf_block_t*>(
 		UT_LIST_GET_FIRST(buf_pool.free));
 
@@ -336,7 +439,7 @@ static void buf_LRU_check_size_of_non_data_objects()
   if (recv_recovery_is_on() || buf_pool.curr_size != buf_pool.old_size)
     return;
 
-  const auto s= UT_LIST_GET_LEN(buf_pool.free) + UT_LIST_GET_LEN(buf_pool.LRU);
+  const auto s= buf_pool.free_len() + UT_LIST_GET_LEN(buf_pool.LRU);
 
   if (s < buf_pool.curr_size / 20)
     ib::fatal() << "Over 95 percent of the buffer pool is"
@@ -387,8 +490,12 @@ This function is called from a user thread when it needs a clean
 block to read in a page. Note that we only ever get a block from
 the free list. Even when we flush a page or find a page in LRU scan
 we put it to free list to be used.
+* unless have_mutex:
+  * get a block from buf_pool.free_shards without buf_pool.mutex,
+    success:done
 * iteration 0:
-  * get a block from the buf_pool.free list, success:done
+  * get a block from the buf_pool.free list, success:move a batch of
+    blocks to buf_pool.free_shards, done
   * if buf_pool.try_LRU_scan is set
     * scan LRU up to 100 pages to free a clean block
     * success:retry the free list
@@ -411,6 +518,11 @@ buf_block_t* buf_LRU_get_free_block(bool have_mutex)
 		mysql_mutex_assert_owner(&buf_pool.mutex);
 		goto got_mutex;
 	}
+
+	if (buf_block_t* block = buf_pool.free_shard_get()) {
+		memset(&block->page.zip, 0, sizeof block->page.zip);
+		return block;
+	}
 loop:
 	mysql_mutex_lock(&buf_pool.mutex);
 got_mutex:
@@ -425,6 +537,7 @@ buf_block_t* buf_LRU_get_free_block(bool have_mutex)
 	/* If there is a block in the free list, take it */
 	if (buf_block_t* block = buf_LRU_get_free_only()) {
 		if (!have_mutex) {
+			buf_pool.free_shard_refill();
 			mysql_mutex_unlock(&buf_pool.mutex);
 		}
 		memset(&block->page.zip, 0, sizeof block->page.zip);
@@ -1367,6 +1480,7 @@ void buf_LRU_validate()
 
 	ut_a(buf_pool.LRU_old_len == old_len);
 
+	buf_pool.free_shards_drain();
 	CheckInFreeList::validate();
 
 	for (buf_page_t* bpage = UT_LIST_GET_FIRST(buf_pool.free);
@@ -104,6 +104,22 @@ static buf_page_t* buf_page_init_for_read(ulint mode, const page_id_t page_id,
 
   buf_page_t *bpage= nullptr;
   buf_block_t *block= nullptr;
+  const ulint fold= page_id.fold();
+  page_hash_latch *hash_lock= buf_pool.page_hash.lock_get(fold);
+
+  /* Read-ahead and concurrent misses of the same page may find the page
+  already in the buffer pool. Check that before allocating a block and
+  acquiring buf_pool.mutex, which every page that is read in still needs
+  for buf_pool.LRU. */
+  hash_lock->read_lock();
+  buf_page_t *hash_page= buf_pool.page_hash_get_low(page_id, fold);
+  if (hash_page && !buf_pool.watch_is_sentinel(*hash_page))
+  {
+    hash_lock->read_unlock();
+    goto func_exit_no_mutex;
+  }
+  hash_lock->read_unlock();
+
   if (!zip_size || unzip || recv_recovery_is_on())
   {
     block= buf_LRU_get_free_block(false);
@@ -119,16 +135,13 @@ static buf_page_t* buf_page_init_for_read(ulint mode, const page_id_t page_id,
     rw_lock_x_lock_gen(&block->lock, BUF_IO_READ);
   }
 
-  const ulint fold= page_id.fold();
-
   mysql_mutex_lock(&buf_pool.mutex);
 
   /* We must acquire hash_lock this early to prevent
   a race condition with buf_pool_t::watch_remove() */
-  page_hash_latch *hash_lock= buf_pool.page_hash.lock_get(fold);
   hash_lock->write_lock();
 
-  buf_page_t *hash_page= buf_pool.page_hash_get_low(page_id, fold);
+  hash_page= buf_pool.page_hash_get_low(page_id, fold);
   if (hash_page && !buf_pool.watch_is_sentinel(*hash_page))
   {
     /* The page is already in the buffer pool. */
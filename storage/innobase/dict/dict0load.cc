@@ -978,7 +978,8 @@ dict_sys_tables_rec_read(
 /** Load and check each non-predefined tablespace mentioned in SYS_TABLES.
 Search SYS_TABLES and check each tablespace mentioned that has not
 already been added to the fil_system.  If it is valid, add it to the
-file_system list.
+file_system list. With innodb_lazy_tablespace_open, the files will not
+be accessed until dict_load_tablespace().
 @return the highest space ID found. */
 static ulint dict_check_sys_tables()
 {
@@ -1059,12 +1060,29 @@ static ulint dict_check_sys_tables()
 
 		char*	filepath = fil_make_filepath(
 			NULL, table_name.m_name, IBD, false);
-
-		/* Check that the .ibd file exists. */
-		if (!fil_ibd_open(
+		const ulint fsp_flags = dict_tf_to_fsp_flags(flags);
+
+		if (srv_lazy_tablespace_open
+		    && !DICT_TF_HAS_DATA_DIR(flags)
+		    && !srv_encrypt_tables
+		    && fsp_flags != ULINT_UNDEFINED) {
+			/* Do not access the file before
+			dict_load_tablespace(). A DATA DIRECTORY
+			must be looked up from the .isl file below.
+			The ENCRYPTED attribute is only stored in the
+			first page, which the encryption threads would
+			need for every tablespace. */
+			if (!fil_ibd_register(space_id, fsp_flags,
+					      table_name, filepath)) {
+				ib::warn() << "Ignoring tablespace for "
+					<< table_name
+					<< " because it could not be"
+					" registered.";
+			}
+		} else if (!fil_ibd_open(
 			    false,
 			    FIL_TYPE_TABLESPACE,
-			    space_id, dict_tf_to_fsp_flags(flags),
+			    space_id, fsp_flags,
 			    table_name, filepath)) {
 			ib::warn() << "Ignoring tablespace for "
 				<< table_name
@@ -2400,7 +2418,31 @@ dict_load_tablespace(
 	table->space = fil_space_for_table_exists_in_mem(
 		table->space_id, table->name.m_name, table->flags);
 	if (table->space) {
-		return;
+		/* With innodb_lazy_tablespace_open, the file was not
+		accessed at startup. Open it and validate the first page. */
+		if (!srv_lazy_tablespace_open) {
+			return;
+		}
+
+		if (table->space->get_size()) {
+			/* fil_node_t::read_page0() replaced the flags
+			from SYS_TABLES with the ones in the file. */
+			const ulint tf = dict_tf_to_fsp_flags(table->flags)
+				& ~FSP_FLAGS_MEM_MASK;
+			const ulint sf = table->space->flags
+				& ~FSP_FLAGS_MEM_MASK;
+
+			if (fil_space_t::is_flags_equal(tf, sf)
+			    || fil_space_t::is_flags_equal(sf, tf)) {
+				return;
+			}
+		}
+
+		/* Forget the tablespace, like dict_check_sys_tables()
+		would have done at startup, and report the error below.
+		fil_ibd_open() will report a mismatch of the flags. */
+		fil_space_free(table->space_id, false);
+		table->space = NULL;
 	}
 
 	if (ignore_err == DICT_ERR_IGNORE_DROP) {
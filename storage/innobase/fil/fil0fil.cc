@@ -2715,6 +2715,33 @@ fil_ibd_open(
 	return space;
 }
 
+/** Register a file-per-table tablespace without accessing the file.
+The first page will be read and validated when the file is first opened.
+@param id         tablespace identifier
+@param flags      expected FSP_SPACE_FLAGS
+@param tablename  table name in the databasename/tablename format
+@param path       data file name
+@return tablespace
+@retval nullptr if the tablespace could not be created */
+fil_space_t *fil_ibd_register(ulint id, ulint flags,
+                              const table_name_t &tablename,
+                              const char *path)
+{
+  ut_ad(fil_space_t::is_valid_flags(flags & ~FSP_FLAGS_MEM_MASK, id));
+  ut_ad(!srv_encrypt_tables);
+
+  /* The encryption metadata will be read by fil_node_t::read_page0().
+  With innodb_encrypt_tables=OFF, FIL_ENCRYPTION_DEFAULT will not add
+  the tablespace to fil_system.rotation_list, so that ENCRYPTED=NO
+  tables will not be queued for encryption before that. */
+  fil_space_t *space= fil_space_t::create(tablename.m_name, id, flags,
+                                          FIL_TYPE_TABLESPACE, nullptr,
+                                          FIL_ENCRYPTION_DEFAULT);
+  if (space)
+    space->add(path, OS_FILE_CLOSED, 0, false, true);
+  return space;
+}
+
 /** Looks for a pre-existing fil_space_t with the given tablespace ID
 and, if found, returns the name and filepath in newly allocated buffers
 that the caller must free.
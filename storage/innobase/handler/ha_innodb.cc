@@ -393,6 +393,24 @@ static TYPELIB innodb_change_buffering_typelib = {
 	NULL
 };
 
+#ifdef __linux__
+/** Names of allowed values of innodb_linux_aio */
+static const char* innodb_linux_aio_names[] = {
+	"auto",		/* SRV_LINUX_AIO_AUTO */
+	"io_uring",	/* SRV_LINUX_AIO_IO_URING */
+	"aio",		/* SRV_LINUX_AIO_LIBAIO */
+	NullS
+};
+
+/** Enumeration of innodb_linux_aio */
+static TYPELIB innodb_linux_aio_typelib = {
+	array_elements(innodb_linux_aio_names) - 1,
+	"innodb_linux_aio_typelib",
+	innodb_linux_aio_names,
+	NULL
+};
+#endif
+
 /** Allowed values of innodb_instant_alter_column_allowed */
 const char* innodb_instant_alter_column_allowed_names[] = {
 	"never", /* compatible with MariaDB 5.5 to 10.2 */
@@ -517,6 +535,7 @@ performance schema instrumented if "UNIV_PFS_MUTEX"
 is defined */
 static PSI_mutex_info all_innodb_mutexes[] = {
 	PSI_KEY(buf_pool_mutex),
+	PSI_KEY(buf_pool_free_shard_mutex),
 	PSI_KEY(dict_foreign_err_mutex),
 	PSI_KEY(dict_sys_mutex),
 	PSI_KEY(recalc_pool_mutex),
@@ -545,7 +564,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	PSI_KEY(buf_dblwr_mutex),
 	PSI_KEY(trx_pool_mutex),
 	PSI_KEY(trx_pool_manager_mutex),
-	PSI_KEY(lock_mutex),
+	PSI_KEY(lock_rec_shard_mutex),
 	PSI_KEY(lock_wait_mutex),
 	PSI_KEY(trx_mutex),
 	PSI_KEY(srv_threads_mutex),
@@ -574,6 +593,7 @@ static PSI_rwlock_info all_innodb_rwlocks[] = {
 	PSI_RWLOCK_KEY(fts_cache_init_rw_lock),
 	PSI_RWLOCK_KEY(trx_i_s_cache_lock),
 	PSI_RWLOCK_KEY(trx_purge_latch),
+	PSI_RWLOCK_KEY(lock_latch),
 	PSI_RWLOCK_KEY(index_tree_rw_lock),
 };
 # endif /* UNIV_PFS_RWLOCK */
@@ -836,6 +856,11 @@ static MYSQL_THDVAR_BOOL(table_locks, PLUGIN_VAR_OPCMDARG,
   /* check_func */ NULL, /* update_func */ NULL,
   /* default */ TRUE);
 
+static MYSQL_THDVAR_BOOL(bulk_insert, PLUGIN_VAR_OPCMDARG,
+  "Buffer a multi-row INSERT or LOAD DATA into an empty table and build"
+  " the indexes in bulk, with a single undo log record for the table",
+  NULL, NULL, FALSE);
+
 static MYSQL_THDVAR_BOOL(strict_mode, PLUGIN_VAR_OPCMDARG,
   "Use strict mode when evaluating create options.",
   NULL, NULL, TRUE);
@@ -859,6 +884,12 @@ static MYSQL_THDVAR_STR(tmpdir,
   "Directory for temporary non-tablespace files.",
   innodb_tmpdir_validate, NULL, NULL);
 
+static MYSQL_THDVAR_ULONG(ddl_threads, PLUGIN_VAR_RQCMDARG,
+  "Number of threads for sorting the entries of non-unique secondary"
+  " indexes in ALTER TABLE. The clustered index is read, and each index"
+  " tree is loaded, by a single thread",
+  NULL, NULL, 1, 1, 64, 0);
+
 static SHOW_VAR innodb_status_variables[]= {
 #ifdef BTR_CUR_HASH_ADAPT
   {"adaptive_hash_hash_searches", &btr_cur_n_sea, SHOW_SIZE_T},
@@ -1550,6 +1581,16 @@ thd_innodb_tmpdir(
 	return(tmp_dir);
 }
 
+/** Get the number of threads for sorting index entries in ALTER TABLE.
+@param[in]	thd	thread handle
+@return	innodb_ddl_threads */
+ulint
+thd_ddl_threads(
+	THD*	thd)
+{
+	return(THDVAR(thd, ddl_threads));
+}
+
 /** Obtain the InnoDB transaction of a MySQL thread.
 @param[in,out]	thd	thread handle
 @return reference to transaction pointer */
@@ -2657,8 +2698,15 @@ static bool innobase_query_caching_table_check_low(
 		return false;
 	}
 
-	return !trx->read_view.is_open()
-		|| trx->read_view.low_limit_id()
+	if (!trx->read_view.is_open()) {
+		return true;
+	}
+
+	/* A commit sequence number snapshot may not see some
+	transactions below low_limit_id. */
+	return trx_sys.csn.enabled()
+		? trx->read_view.sees(table->query_cache_inv_trx_id)
+		: trx->read_view.low_limit_id()
 		>= table->query_cache_inv_trx_id;
 }
 
@@ -3506,10 +3554,8 @@ static int innodb_init_params()
 		srv_use_doublewrite_buf = FALSE;
 	}
 
-#ifdef LINUX_NATIVE_AIO
-	if (srv_use_native_aio) {
-		ib::info() << "Using Linux native AIO";
-	}
+#if defined LINUX_NATIVE_AIO || defined HAVE_URING
+	/* The AIO interface will be chosen and reported by os_aio_init() */
 #elif !defined _WIN32
 	/* Currently native AIO is supported only on windows and linux
 	and that also when the support is compiled in. In all other
@@ -9003,6 +9049,61 @@ ha_innobase::rnd_next(
 	DBUG_RETURN(error);
 }
 
+/** Read the next rows of a table scan.
+@param[out]	buf		buffer for max_rows rows in MySQL format
+@param[in]	max_rows	maximum number of rows to read
+@param[out]	rows		number of rows read
+@return 0, HA_ERR_END_OF_FILE, HA_ERR_WRONG_COMMAND or error number */
+int
+ha_innobase::rnd_next_batch(uchar* buf, uint max_rows, uint* rows)
+{
+	const ulint	stride = table->s->reclength;
+	int		error = 0;
+
+	DBUG_ENTER("rnd_next_batch");
+
+	/* Locking reads may have to unlock or update the returned
+	row, and the row prefetch cache is not used for them. */
+	if (m_prebuilt->select_lock_type != LOCK_NONE) {
+		DBUG_RETURN(HA_ERR_WRONG_COMMAND);
+	}
+
+	*rows = 0;
+
+	while (*rows < max_rows) {
+		/* Take the rows that row_search_mvcc() prefetched
+		without calling it again for each of them. At the start
+		of a scan the cache may still hold rows of an earlier
+		one. */
+		if (ulint n = m_start_of_scan
+		    ? 0 : row_sel_dequeue_cached_rows(
+			    buf + *rows * stride, stride,
+			    max_rows - *rows, m_prebuilt)) {
+			*rows += uint(n);
+			if (m_prebuilt->table->is_system_db) {
+				srv_stats.n_system_rows_read.add(
+					thd_get_thread_id(m_user_thd), n);
+			} else {
+				srv_stats.n_rows_read.add(
+					thd_get_thread_id(m_user_thd), n);
+			}
+			continue;
+		}
+
+		if ((error = rnd_next(buf + *rows * stride))) {
+			break;
+		}
+
+		++*rows;
+	}
+
+	if (*rows) {
+		table->status = 0;
+	}
+
+	DBUG_RETURN(error);
+}
+
 /**********************************************************************//**
 Fetches a row from the table based on a row reference.
 @return 0, HA_ERR_KEY_NOT_FOUND, or error code */
@@ -15111,7 +15212,11 @@ ha_innobase::extra(
 	case HA_EXTRA_INSERT_WITH_UPDATE:
 		thd_to_trx(ha_thd())->duplicates |= TRX_DUP_IGNORE;
 		break;
+	case HA_EXTRA_IGNORE_DUP_KEY:
+		m_prebuilt->ignore_dup_key = true;
+		break;
 	case HA_EXTRA_NO_IGNORE_DUP_KEY:
+		m_prebuilt->ignore_dup_key = false;
 		thd_to_trx(ha_thd())->duplicates &= ~TRX_DUP_IGNORE;
 		break;
 	case HA_EXTRA_WRITE_CAN_REPLACE:
@@ -15166,9 +15271,66 @@ ha_innobase::reset()
 	/* This is a statement level counter. */
 	m_prebuilt->autoinc_last_value = 0;
 
+	m_prebuilt->bulk_insert = false;
+	m_prebuilt->ignore_dup_key = false;
+
+	if (m_prebuilt->ins_node) {
+		row_ins_bulk_discard(m_prebuilt->ins_node);
+	}
+
 	return(0);
 }
 
+/** Start a bulk insert of several rows in one statement.
+If the table is empty, row_insert_for_mysql() may start buffering the rows
+(@see row_ins_bulk_start()).
+@param rows	estimated number of rows, or 0 if not known
+@param flags	flags (unused) */
+void ha_innobase::start_bulk_insert(ha_rows rows, uint flags)
+{
+	THD*	thd = ha_thd();
+
+	switch (thd_sql_command(thd)) {
+	case SQLCOM_INSERT:
+	case SQLCOM_INSERT_SELECT:
+	case SQLCOM_LOAD:
+		/* Triggers and the hash based unique keys would read
+		the table, which does not see the buffered rows. */
+		m_prebuilt->bulk_insert = THDVAR(thd, bulk_insert)
+			&& rows != 1
+			&& !table->s->long_unique_table
+			&& !table->triggers;
+		break;
+	default:
+		m_prebuilt->bulk_insert = false;
+	}
+}
+
+/** End a bulk insert, and build the indexes from the buffered rows.
+@return error code */
+int ha_innobase::end_bulk_insert()
+{
+	m_prebuilt->bulk_insert = false;
+
+	ins_node_t*	node = m_prebuilt->ins_node;
+
+	if (!node || !node->bulk) {
+		return(0);
+	}
+
+	dberr_t	err = row_ins_bulk_end(node, m_prebuilt->trx);
+
+	if (err == DB_SUCCESS) {
+		return(0);
+	}
+
+	int	error = convert_error_code_to_mysql(
+		err, m_prebuilt->table->flags, ha_thd());
+
+	my_errno = error;
+	return(error);
+}
+
 /******************************************************************//**
 MySQL calls this function at the start of each SQL statement inside LOCK
 TABLES. Inside LOCK TABLES the ::external_lock method does not work to
@@ -18696,6 +18858,11 @@ static MYSQL_SYSVAR_ULONG(flushing_avg_loops,
   "Number of iterations over which the background flushing is averaged.",
   NULL, NULL, 30, 1, 1000, 0);
 
+static MYSQL_SYSVAR_ULONG(page_cleaners, srv_n_page_cleaners,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of page cleaner workers that write the pages of a flush batch",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONG(max_purge_lag, srv_max_purge_lag,
   PLUGIN_VAR_RQCMDARG,
   "Desired maximum length of the purge queue (0 = no limit)",
@@ -18828,6 +18995,14 @@ static MYSQL_SYSVAR_ULONG(buffer_pool_chunk_size, srv_buf_pool_chunk_unit,
   NULL, NULL,
   128 * 1024 * 1024, 1024 * 1024, LONG_MAX, 1024 * 1024);
 
+static MYSQL_SYSVAR_ULONG(buffer_pool_free_shards, srv_buf_pool_free_shards,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of caches of the buffer pool free list from which blocks"
+  " can be allocated without holding the buffer pool mutex"
+  " (1 disables the caches). The LRU list and page eviction"
+  " are not sharded and still use the buffer pool mutex",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_STR(buffer_pool_filename, srv_buf_dump_filename,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_MEMALLOC,
   "Filename to/from which to dump/load the InnoDB buffer pool",
@@ -19016,6 +19191,13 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(fetch_cache_size, srv_fetch_cache_size,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum size in bytes of the rows that an index scan prefetches"
+  " into the row cache of a table handle. The number of prefetched"
+  " rows grows with the length of the scan up to this limit.",
+  NULL, NULL, 64 << 10, 0, 64 << 20, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -19031,6 +19213,11 @@ static MYSQL_SYSVAR_ULONG(read_io_threads, srv_n_read_io_threads,
   "Number of background read I/O threads in InnoDB.",
   NULL, NULL, 4, 1, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(recovery_threads, srv_n_recovery_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads for applying the redo log in crash recovery",
+  NULL, NULL, 4, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONG(write_io_threads, srv_n_write_io_threads,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Number of background write I/O threads in InnoDB.",
@@ -19082,6 +19269,13 @@ static MYSQL_SYSVAR_ULONG(open_files, innobase_open_files,
   "How many files at the maximum InnoDB keeps open at the same time.",
   NULL, NULL, 0, 0, LONG_MAX, 0);
 
+static MYSQL_SYSVAR_BOOL(lazy_tablespace_open, srv_lazy_tablespace_open,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Whether to defer opening and validating file-per-table tablespaces"
+  " from startup until their first access;"
+  " ignored when innodb_encrypt_tables is enabled",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(sync_spin_loops, srv_n_spin_wait_rounds,
   PLUGIN_VAR_RQCMDARG,
   "Count of spin-loop rounds in InnoDB mutexes (30 by default)",
@@ -19098,6 +19292,12 @@ static MYSQL_SYSVAR_BOOL(prefix_index_cluster_optimization,
   "Enable prefix optimization to sometimes avoid cluster index lookups.",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_BOOL(read_view_csn, srv_read_view_csn,
+  PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+  "Whether a read view is a commit sequence number instead of"
+  " a copy of the active transaction identifiers",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_STR(data_file_path, innobase_data_file_path,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Path to individual files and their sizes.",
@@ -19160,6 +19360,14 @@ static MYSQL_SYSVAR_BOOL(use_native_aio, srv_use_native_aio,
   "Use native AIO if supported on this platform.",
   NULL, NULL, TRUE);
 
+#ifdef __linux__
+static MYSQL_SYSVAR_ENUM(linux_aio, srv_linux_aio_method,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Which native AIO interface to use with innodb_use_native_aio=ON:"
+  " auto (io_uring if available, otherwise aio), io_uring, aio",
+  NULL, NULL, SRV_LINUX_AIO_AUTO, &innodb_linux_aio_typelib);
+#endif
+
 #ifdef HAVE_LIBNUMA
 static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
@@ -19488,6 +19696,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(autoextend_increment),
   MYSQL_SYSVAR(buffer_pool_size),
   MYSQL_SYSVAR(buffer_pool_chunk_size),
+  MYSQL_SYSVAR(buffer_pool_free_shards),
   MYSQL_SYSVAR(buffer_pool_filename),
   MYSQL_SYSVAR(buffer_pool_dump_now),
   MYSQL_SYSVAR(buffer_pool_dump_at_shutdown),
@@ -19520,6 +19729,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(use_atomic_writes),
   MYSQL_SYSVAR(fast_shutdown),
   MYSQL_SYSVAR(read_io_threads),
+  MYSQL_SYSVAR(recovery_threads),
   MYSQL_SYSVAR(write_io_threads),
   MYSQL_SYSVAR(file_per_table),
   MYSQL_SYSVAR(flush_log_at_timeout),
@@ -19549,12 +19759,14 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(adaptive_flushing),
   MYSQL_SYSVAR(flush_sync),
   MYSQL_SYSVAR(flushing_avg_loops),
+  MYSQL_SYSVAR(page_cleaners),
   MYSQL_SYSVAR(max_purge_lag),
   MYSQL_SYSVAR(max_purge_lag_delay),
   MYSQL_SYSVAR(max_purge_lag_wait),
   MYSQL_SYSVAR(old_blocks_pct),
   MYSQL_SYSVAR(old_blocks_time),
   MYSQL_SYSVAR(open_files),
+  MYSQL_SYSVAR(lazy_tablespace_open),
   MYSQL_SYSVAR(optimize_fulltext_only),
   MYSQL_SYSVAR(rollback_on_timeout),
   MYSQL_SYSVAR(ft_aux_table),
@@ -19577,15 +19789,22 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(status_file),
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(fetch_cache_size),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
   MYSQL_SYSVAR(table_locks),
+  MYSQL_SYSVAR(bulk_insert),
   MYSQL_SYSVAR(prefix_index_cluster_optimization),
+  MYSQL_SYSVAR(read_view_csn),
   MYSQL_SYSVAR(tmpdir),
+  MYSQL_SYSVAR(ddl_threads),
   MYSQL_SYSVAR(autoinc_lock_mode),
   MYSQL_SYSVAR(version),
   MYSQL_SYSVAR(use_native_aio),
+#ifdef __linux__
+  MYSQL_SYSVAR(linux_aio),
+#endif
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
 #endif /* HAVE_LIBNUMA */
@@ -19694,6 +19913,7 @@ i_s_innodb_cmp_per_index_reset,
 i_s_innodb_buffer_page,
 i_s_innodb_buffer_page_lru,
 i_s_innodb_buffer_stats,
+i_s_innodb_buffer_free_shards,
 i_s_innodb_metrics,
 i_s_innodb_ft_default_stopword,
 i_s_innodb_ft_deleted,
@@ -153,6 +153,8 @@ class ha_innobase final : public handler
 
 	int rnd_next(uchar *buf) override;
 
+	int rnd_next_batch(uchar* buf, uint max_rows, uint* rows) override;
+
 	int rnd_pos(uchar * buf, uchar *pos) override;
 
 	int ft_init() override;
@@ -174,6 +176,10 @@ class ha_innobase final : public handler
 
 	int reset() override;
 
+	void start_bulk_insert(ha_rows rows, uint flags) override;
+
+	int end_bulk_insert() override;
+
 	int external_lock(THD *thd, int lock_type) override;
 
 	int start_stmt(THD *thd, thr_lock_type lock_type) override;
@@ -3642,6 +3642,15 @@ static ST_FIELD_INFO	i_s_innodb_buffer_stats_fields_info[] =
 #define IDX_BUF_STATS_UNZIP_CUR		31
   Column("UNCOMPRESS_CURRENT", ULonglong(), NOT_NULL),
 
+#define IDX_BUF_STATS_FREE_SHARDS	32
+  Column("FREE_SHARDS", ULonglong(), NOT_NULL),
+
+#define IDX_BUF_STATS_FREE_SHARD_HITS	33
+  Column("FREE_SHARD_HITS", ULonglong(), NOT_NULL),
+
+#define IDX_BUF_STATS_FREE_SHARD_REFILLS 34
+  Column("FREE_SHARD_REFILLS", ULonglong(), NOT_NULL),
+
   CEnd()
 };
 } // namespace Show
@@ -3769,6 +3778,14 @@ static int i_s_innodb_stats_fill(THD *thd, TABLE_LIST * tables, Item *)
 
 	OK(fields[IDX_BUF_STATS_UNZIP_CUR]->store(info.unzip_cur, true));
 
+	OK(fields[IDX_BUF_STATS_FREE_SHARDS]->store(info.n_free_shards, true));
+
+	OK(fields[IDX_BUF_STATS_FREE_SHARD_HITS]->store(
+		   info.free_shard_hits, true));
+
+	OK(fields[IDX_BUF_STATS_FREE_SHARD_REFILLS]->store(
+		   info.free_shard_refills, true));
+
 	DBUG_RETURN(schema_table_store_record(thd, table));
 }
 
@@ -3842,6 +3859,137 @@ UNIV_INTERN struct st_maria_plugin	i_s_innodb_buffer_stats =
         STRUCT_FLD(maturity, MariaDB_PLUGIN_MATURITY_STABLE),
 };
 
+namespace Show {
+/* Fields of the dynamic table INNODB_BUFFER_POOL_FREE_SHARDS. */
+static ST_FIELD_INFO	i_s_innodb_buffer_free_shards_fields_info[] =
+{
+#define IDX_BUF_FREE_SHARD_POOL_ID	0
+  Column("POOL_ID", ULong(), NOT_NULL),
+
+#define IDX_BUF_FREE_SHARD_ID		1
+  Column("SHARD_ID", ULong(), NOT_NULL),
+
+#define IDX_BUF_FREE_SHARD_FREE		2
+  Column("FREE_BUFFERS", ULonglong(), NOT_NULL),
+
+#define IDX_BUF_FREE_SHARD_HITS		3
+  Column("HITS", ULonglong(), NOT_NULL),
+
+#define IDX_BUF_FREE_SHARD_REFILLS	4
+  Column("REFILLS", ULonglong(), NOT_NULL),
+
+  CEnd()
+};
+} // namespace Show
+
+/** Fill INFORMATION_SCHEMA.INNODB_BUFFER_POOL_FREE_SHARDS
+with one row for each innodb_buffer_pool_free_shards cache.
+@param[in,out]	thd	connection
+@param[in,out]	tables	tables to fill
+@return 0 on success, 1 on failure */
+static int i_s_innodb_free_shards_fill(THD *thd, TABLE_LIST *tables, Item *)
+{
+	DBUG_ENTER("i_s_innodb_free_shards_fill");
+
+	RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+	/* Only allow the PROCESS privilege holder to access the stats */
+	if (check_global_access(thd, PROCESS_ACL)) {
+		DBUG_RETURN(0);
+	}
+
+	TABLE*	table = tables->table;
+	Field**	fields = table->field;
+
+	/* The counters are updated while holding the shard mutexes.
+	We only read them. */
+	for (ulint i = 0; buf_pool.free_shards && i < buf_pool.n_free_shards;
+	     i++) {
+		const buf_pool_t::free_shard_t& shard
+			= buf_pool.free_shards[i];
+
+		OK(fields[IDX_BUF_FREE_SHARD_POOL_ID]->store(0, true));
+		OK(fields[IDX_BUF_FREE_SHARD_ID]->store(i, true));
+		OK(fields[IDX_BUF_FREE_SHARD_FREE]->store(shard.len, true));
+		OK(fields[IDX_BUF_FREE_SHARD_HITS]->store(shard.hits, true));
+		OK(fields[IDX_BUF_FREE_SHARD_REFILLS]->store(
+			   shard.refills, true));
+		OK(schema_table_store_record(thd, table));
+	}
+
+	DBUG_RETURN(0);
+}
+
+/*******************************************************************//**
+Bind the dynamic table INFORMATION_SCHEMA.INNODB_BUFFER_POOL_FREE_SHARDS.
+@return 0 on success, 1 on failure */
+static
+int
+i_s_innodb_buffer_free_shards_init(
+/*===============================*/
+	void*	p)	/*!< in/out: table schema object */
+{
+	ST_SCHEMA_TABLE*	schema;
+
+	DBUG_ENTER("i_s_innodb_buffer_free_shards_init");
+
+	schema = reinterpret_cast<ST_SCHEMA_TABLE*>(p);
+
+	schema->fields_info = Show::i_s_innodb_buffer_free_shards_fields_info;
+	schema->fill_table = i_s_innodb_free_shards_fill;
+
+	DBUG_RETURN(0);
+}
+
+UNIV_INTERN struct st_maria_plugin	i_s_innodb_buffer_free_shards =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	STRUCT_FLD(type, MYSQL_INFORMATION_SCHEMA_PLUGIN),
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	STRUCT_FLD(info, &i_s_info),
+
+	/* plugin name */
+	/* const char* */
+	STRUCT_FLD(name, "INNODB_BUFFER_POOL_FREE_SHARDS"),
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(author, plugin_author),
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(descr, "InnoDB Buffer Pool Free List Shards"),
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	STRUCT_FLD(license, PLUGIN_LICENSE_GPL),
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(init, i_s_innodb_buffer_free_shards_init),
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(deinit, i_s_common_deinit),
+
+	/* plugin version (for SHOW PLUGINS) */
+	/* unsigned int */
+	STRUCT_FLD(version, INNODB_VERSION_SHORT),
+
+	/* struct st_mysql_show_var* */
+	STRUCT_FLD(status_vars, NULL),
+
+	/* struct st_mysql_sys_var** */
+	STRUCT_FLD(system_vars, NULL),
+
+        /* Maria extension */
+	STRUCT_FLD(version_info, INNODB_VERSION_STR),
+        STRUCT_FLD(maturity, MariaDB_PLUGIN_MATURITY_STABLE),
+};
+
 /** These must correspond to the first values of buf_page_state */
 static const LEX_CSTRING page_state_values[] =
 {
@@ -362,6 +362,11 @@ btr_free_if_exists(
 @param[in]	page_id		root page id */
 void btr_free(const page_id_t page_id);
 
+/** Remove all records from a persistent index tree, keeping the root page.
+This is used for rolling back TRX_UNDO_EMPTY.
+@param[in,out]	index	index tree */
+void btr_clear_index(dict_index_t* index);
+
 /** Read the last used AUTO_INCREMENT value from PAGE_ROOT_AUTO_INC.
 @param[in,out]	index	clustered index
 @return	the last used AUTO_INCREMENT value
@@ -97,7 +97,13 @@ struct buf_pool_info_t
 	ulint	pool_size;		/*!< Buffer Pool size in pages */
 	ulint	lru_len;		/*!< Length of buf_pool.LRU */
 	ulint	old_lru_len;		/*!< buf_pool.LRU_old_len */
-	ulint	free_list_len;		/*!< Length of buf_pool.free list */
+	ulint	free_list_len;		/*!< Length of buf_pool.free list,
+					including buf_pool.free_shards */
+	ulint	n_free_shards;		/*!< innodb_buffer_pool_free_shards */
+	ulint	free_shard_hits;	/*!< blocks allocated from
+					buf_pool.free_shards */
+	ulint	free_shard_refills;	/*!< refills of
+					buf_pool.free_shards */
 	ulint	flush_list_len;		/*!< Length of buf_pool.flush_list */
 	ulint	n_pend_unzip;		/*!< buf_pool.n_pend_unzip, pages
 					pending decompress */
@@ -1464,6 +1470,10 @@ class buf_pool_t
   /** Resize from srv_buf_pool_old_size to srv_buf_pool_size. */
   inline void resize();
 
+  /** Register the page frames of all chunks as long-lived I/O buffers,
+  so that io_uring need not pin the pages for every request. */
+  void register_io_buffers() const;
+
   /** @return whether resize() is in progress */
   bool resize_in_progress() const
   {
@@ -1751,7 +1761,7 @@ class buf_pool_t
   bool running_out() const
   {
     return !recv_recovery_is_on() &&
-      UNIV_UNLIKELY(UT_LIST_GET_LEN(free) + UT_LIST_GET_LEN(LRU) <
+      UNIV_UNLIKELY(free_len() + UT_LIST_GET_LEN(LRU) <
                     std::min(curr_size, old_size) / 4);
   }
 
@@ -1972,6 +1982,33 @@ class buf_pool_t
 					/*!< base node of the free
 					block list */
 
+  /** A cache of free blocks that can be allocated without holding mutex
+  (innodb_buffer_pool_free_shards). The blocks are moved in batches
+  from free, and they are returned to free when a thread finds free
+  empty, or when the buffer pool is being shrunk or validated. */
+  struct MY_ALIGNED(CACHE_LINE_SIZE) free_shard_t
+  {
+    /** Protects the other members. May be acquired while holding
+    buf_pool.mutex, but buf_pool.mutex must not be acquired
+    while holding this. */
+    mysql_mutex_t mutex;
+    /** free blocks */
+    UT_LIST_BASE_NODE_T(buf_page_t) free;
+    /** UT_LIST_GET_LEN(free), for checking without holding mutex */
+    Atomic_relaxed<ulint> len;
+    /** number of blocks that were allocated from this shard */
+    Atomic_counter<ulint> hits;
+    /** number of times this shard was refilled */
+    Atomic_counter<ulint> refills;
+  };
+
+  /** free list shards, or nullptr if innodb_buffer_pool_free_shards=1 */
+  free_shard_t *free_shards;
+  /** number of elements in free_shards */
+  ulint n_free_shards;
+  /** total number of blocks in free_shards[].free */
+  Atomic_counter<ulint> n_shard_free;
+
 	UT_LIST_BASE_NODE_T(buf_page_t) withdraw;
 					/*!< base node of the withdraw
 					block list. It is only used during
@@ -2024,6 +2061,18 @@ class buf_pool_t
   /** Reserve a buffer. */
   buf_tmp_buffer_t *io_buf_reserve() { return io_buf.reserve(); }
 
+  /** @return the number of free blocks, including free_shards */
+  ulint free_len() const { return UT_LIST_GET_LEN(free) + n_shard_free; }
+
+  /** Allocate a block from a free list shard without holding mutex.
+  @return a block in state BUF_BLOCK_MEMORY
+  @retval nullptr if the shard was empty */
+  buf_block_t *free_shard_get();
+  /** Move a batch of blocks from free to a free list shard. */
+  void free_shard_refill();
+  /** Move all blocks from free_shards to free. */
+  void free_shards_drain();
+
   /** @return whether any I/O is pending */
   bool any_io_pending() const
   {
@@ -2107,7 +2156,10 @@ inline void buf_page_t::set_buf_fix_count(uint32_t count)
 
 inline void buf_page_t::set_state(buf_page_state state)
 {
-  mysql_mutex_assert_owner(&buf_pool.mutex);
+  /* buf_pool_t::free_shard_get() allocates a block while holding
+  the mutex of a free list shard instead. */
+  ut_ad(mysql_mutex_is_owner(&buf_pool.mutex) ||
+        (state_ == BUF_BLOCK_NOT_USED && state == BUF_BLOCK_MEMORY));
 #ifdef UNIV_DEBUG
   switch (state) {
   case BUF_BLOCK_REMOVE_HASH:
@@ -60,6 +60,7 @@ bool buf_LRU_free_page(buf_page_t *bpage, bool zip)
 bool buf_LRU_scan_and_free_block(ulint limit= ULINT_UNDEFINED);
 
 /** @return a buffer block from the buf_pool.free list
+(or buf_pool.free_shards if buf_pool.free is empty)
 @retval	NULL	if the free list is empty */
 buf_block_t* buf_LRU_get_free_only();
 
@@ -71,8 +72,12 @@ This function is called from a user thread when it needs a clean
 block to read in a page. Note that we only ever get a block from
 the free list. Even when we flush a page or find a page in LRU scan
 we put it to free list to be used.
+* unless have_mutex:
+  * get a block from buf_pool.free_shards without buf_pool.mutex,
+    success:done
 * iteration 0:
-  * get a block from the buf_pool.free list, success:done
+  * get a block from the buf_pool.free list, success:move a batch of
+    blocks to buf_pool.free_shards, done
   * if buf_pool.try_LRU_scan is set
     * scan LRU up to 100 pages to free a clean block
     * success:retry the free list
@@ -1644,6 +1644,18 @@ fil_ibd_open(
 	dberr_t*		err = NULL)
 	MY_ATTRIBUTE((warn_unused_result));
 
+/** Register a file-per-table tablespace without accessing the file.
+The first page will be read and validated when the file is first opened.
+@param id         tablespace identifier
+@param flags      expected FSP_SPACE_FLAGS
+@param tablename  table name in the databasename/tablename format
+@param path       data file name
+@return tablespace
+@retval nullptr if the tablespace could not be created */
+fil_space_t *fil_ibd_register(ulint id, ulint flags,
+                              const table_name_t &tablename,
+                              const char *path);
+
 enum fil_load_status {
 	/** The tablespace file(s) were found and valid. */
 	FIL_LOAD_OK,
@@ -276,6 +276,13 @@ const char*
 thd_innodb_tmpdir(
 	THD*	thd);
 
+/** Get the number of threads for sorting index entries in ALTER TABLE.
+@param[in]	thd	thread handle
+@return	innodb_ddl_threads */
+ulint
+thd_ddl_threads(
+	THD*	thd);
+
 /**********************************************************************//**
 Get the current setting of the table_cache_size global parameter. We do
 a dirty read because for one there is no synchronization object and
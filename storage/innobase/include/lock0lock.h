@@ -35,6 +35,7 @@ Created 5/7/1996 Heikki Tuuri
 #include "lock0types.h"
 #include "hash0hash.h"
 #include "srv0srv.h"
+#include "sync0rw.h"
 #include "ut0vec.h"
 #include "gis0rtree.h"
 #include "lock0prdt.h"
@@ -430,13 +431,23 @@ lock_table(
 	lock_mode	mode,	/*!< in: lock mode */
 	que_thr_t*	thr)	/*!< in: query thread */
 	MY_ATTRIBUTE((warn_unused_result));
+/** Try to acquire an exclusive table lock without waiting.
+@param[in,out]	table	table
+@param[in,out]	trx	transaction
+@return whether the lock was granted */
+bool
+lock_table_x_try(
+	dict_table_t*	table,
+	trx_t*		trx)
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
 /*********************************************************************//**
-Creates a table IX lock object for a resurrected transaction. */
+Creates a table IX or X lock object for a resurrected transaction. */
 void
-lock_table_ix_resurrect(
-/*====================*/
+lock_table_resurrect(
+/*=================*/
 	dict_table_t*	table,	/*!< in/out: table */
-	trx_t*		trx);	/*!< in/out: transaction */
+	trx_t*		trx,	/*!< in/out: transaction */
+	lock_mode	mode);	/*!< in: LOCK_IX or LOCK_X */
 
 /** Sets a lock on a table based on the given mode.
 @param[in]	table	table to lock
@@ -709,9 +720,24 @@ class lock_sys_t
   bool m_initialised;
 
 public:
-	MY_ALIGNED(CACHE_LINE_SIZE)
-	LockMutex	mutex;			/*!< Mutex protecting the
-						locks */
+  /** Latch protecting the locks. In exclusive mode, it protects
+  all locks (and is what lock_mutex_enter() acquires). In shared mode,
+  together with rec_shard(), it protects the record locks of one shard
+  of rec_hash: such a thread may only add record locks on behalf of
+  the transaction that it is executing, and it must not wait.
+  Table locks, lock waits, lock release and deadlock detection
+  require the exclusive mode. */
+  MY_ALIGNED(CACHE_LINE_SIZE) rw_lock_t latch;
+
+  /** Number of mutexes that partition rec_hash */
+  static constexpr ulint REC_SHARDS= 256;
+private:
+  /** Mutex protecting a shard of rec_hash cells */
+  struct MY_ALIGNED(CACHE_LINE_SIZE) rec_shard_t { LockMutex mutex; };
+  /** Mutexes protecting the shards of rec_hash when latch is S-latched */
+  rec_shard_t rec_shards[REC_SHARDS];
+public:
+
   /** record locks */
   hash_table_t rec_hash;
   /** predicate locks for SPATIAL INDEX */
@@ -775,7 +801,31 @@ class lock_sys_t
 
   /** @return the hash value for a page address */
   ulint hash(const page_id_t id) const
-  { ut_ad(mutex_own(&mutex)); return rec_hash.calc_hash(id.fold()); }
+  { ut_ad(is_latched()); return rec_hash.calc_hash(id.fold()); }
+
+  /** Get the mutex that protects the record locks on a page while
+  latch is held in shared mode. Pages that share a rec_hash cell
+  always share the mutex, so that each hash chain is covered by
+  exactly one mutex.
+  @param id   page identifier
+  @return the mutex of the rec_hash shard that the page belongs to */
+  LockMutex &rec_shard(const page_id_t id)
+  { return rec_shards[hash(id) % REC_SHARDS].mutex; }
+
+#ifdef UNIV_DEBUG
+  /** @return whether the current thread holds latch in any mode */
+  bool is_latched() const
+  {
+    return rw_lock_own_flagged(&latch, RW_LOCK_FLAG_X | RW_LOCK_FLAG_S);
+  }
+  /** @return whether the current thread may access the record locks
+  on a page */
+  bool is_rec_latched(const page_id_t id)
+  {
+    return rw_lock_own(&latch, RW_LOCK_X) ||
+      (rw_lock_own(&latch, RW_LOCK_S) && rec_shard(id).is_owned());
+  }
+#endif
 
   /** Get the first lock on a page.
   @param lock_hash   hash table to look at
@@ -925,23 +975,43 @@ lock_rec_free_all_from_discard_page(
 /** The lock system */
 extern lock_sys_t lock_sys;
 
-/** Test if lock_sys.mutex can be acquired without waiting. */
+/** Test if lock_sys.latch can be X-latched without waiting.
+@return 0 if the latch was acquired */
 #define lock_mutex_enter_nowait() 		\
-	(lock_sys.mutex.trylock(__FILE__, __LINE__))
+	(!rw_lock_x_lock_nowait(&lock_sys.latch))
 
-/** Test if lock_sys.mutex is owned. */
-#define lock_mutex_own() (lock_sys.mutex.is_owned())
+/** Test if lock_sys.latch is X-latched by the current thread. */
+#define lock_mutex_own() rw_lock_own(&lock_sys.latch, RW_LOCK_X)
 
-/** Acquire the lock_sys.mutex. */
+/** Acquire lock_sys.latch in exclusive mode. */
 #define lock_mutex_enter() do {			\
-	mutex_enter(&lock_sys.mutex);		\
+	rw_lock_x_lock(&lock_sys.latch);	\
 } while (0)
 
-/** Release the lock_sys.mutex. */
+/** Release lock_sys.latch from exclusive mode. */
 #define lock_mutex_exit() do {			\
-	lock_sys.mutex.exit();			\
+	rw_lock_x_unlock(&lock_sys.latch);	\
 } while (0)
 
+/** Protection of the record locks on one page: lock_sys.latch in
+shared mode and the rec_hash shard mutex of the page */
+class LockShardGuard
+{
+  LockMutex *m_mutex;
+public:
+  explicit LockShardGuard(const page_id_t id)
+  {
+    rw_lock_s_lock(&lock_sys.latch);
+    m_mutex= &lock_sys.rec_shard(id);
+    mutex_enter(m_mutex);
+  }
+  ~LockShardGuard()
+  {
+    mutex_exit(m_mutex);
+    rw_lock_s_unlock(&lock_sys.latch);
+  }
+};
+
 /** Test if lock_sys.wait_mutex is owned. */
 #define lock_wait_mutex_own() (lock_sys.wait_mutex.is_owned())
 
@@ -62,15 +62,15 @@ static inline void delete_log_file(const char* suffix)
   os_file_delete_if_exists(innodb_log_file_key, path.c_str(), nullptr);
 }
 
-/** Append a string to the log.
-@param[in]	str		string
+/** Reserve space for a string in the current block of the log buffer.
+The caller must copy the string to log_sys.buf + log_sys.buf_free
+as it was before the call.
 @param[in]	len		string length
 @param[out]	start_lsn	start LSN of the log record
 @return end lsn of the log record, zero if did not succeed */
 UNIV_INLINE
 lsn_t
-log_reserve_and_write_fast(
-	const void*	str,
+log_reserve_fast(
 	ulint		len,
 	lsn_t*		start_lsn);
 /***********************************************************************//**
@@ -480,6 +480,10 @@ struct log_t{
   MY_ALIGNED(CPU_LEVEL1_DCACHE_LINESIZE) mysql_mutex_t mutex;
   /** first free offset within the log buffer in use */
   size_t buf_free;
+  /** number of mini-transactions that have reserved space in buf
+  in mtr_t::finish_write() but not completed mtr_t::copy_log();
+  incremented while holding mutex */
+  std::atomic<size_t> pending_copies;
   /** recommended maximum size of buf, after which the buffer is flushed */
   size_t max_buf_free;
   /** mutex to serialize access to the flush list when we are putting
@@ -705,6 +709,11 @@ struct log_t{
   /** Shut down the redo log subsystem. */
   void close();
 
+  /** Wait until all space that was reserved in buf has been filled
+  by mtr_t::copy_log(). The caller must hold mutex, so that no more
+  space can be reserved. */
+  void wait_for_copies() const;
+
   /** Initiate a write of the log buffer to the file if needed.
   @param flush  whether to initiate a durable write */
   inline void initiate_write(bool flush)
@@ -315,6 +315,10 @@ struct recv_sys_t
   /** Apply buffered log to persistent data pages.
   @param last_batch     whether it is possible to write more redo log */
   void apply(bool last_batch);
+  /** Apply buffered log to some pages of the current batch.
+  @param ids    identifiers of the pages, in ascending order
+  @param n_ids  number of elements in ids[] */
+  void apply_pages(const page_id_t *ids, size_t n_ids);
 
 #ifdef UNIV_DEBUG
   /** whether all redo log in the current batch has been applied */
@@ -630,11 +630,16 @@ struct mtr_t {
   @return number of bytes to write in finish_write() */
   inline ulint prepare_write();
 
-  /** Append the redo log records to the redo log buffer.
+  /** Reserve space for the redo log records in the redo log buffer.
+  The records must be copied there by copy_log().
   @param len   number of bytes to write
   @return {start_lsn,flush_ahead} */
   inline std::pair<lsn_t,bool> finish_write(ulint len);
 
+  /** Copy the redo log records to the space that was reserved
+  by finish_write(). This may be invoked without holding log_sys.mutex. */
+  inline void copy_log();
+
   /** Release the resources */
   inline void release_resources();
 
@@ -694,6 +699,9 @@ struct mtr_t {
   /** LSN at commit time */
   lsn_t m_commit_lsn;
 
+  /** the space in log_sys.buf that was reserved by finish_write() */
+  byte *m_log_buf;
+
   /** set of freed page ids */
   range_set *m_freed_pages= nullptr;
 };
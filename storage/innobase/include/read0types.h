@@ -61,14 +61,36 @@ class ReadViewBase
   */
   trx_id_t m_low_limit_no;
 
+  /**
+    Check whether the changes by a transaction are visible
+    in a commit sequence number snapshot.
+    @param id  transaction id between m_up_limit_id and m_low_limit_id
+    @return whether the view sees the modifications of id
+  */
+  bool csn_visible(trx_id_t id) const;
+
 protected:
+  /**
+    The commit sequence number of the snapshot, or 0 if the view is
+    defined by m_ids (innodb_read_view_csn=OFF). The read sees the
+    transactions in [m_up_limit_id, m_low_limit_id) that were assigned
+    a commit sequence number not greater than this.
+  */
+  trx_id_t m_csn;
+
   bool empty() { return m_ids.empty(); }
 
-  /** @return the up limit id */
-  trx_id_t up_limit_id() const { return m_up_limit_id; }
+  /**
+    Creates a snapshot where exactly the transactions that have been
+    assigned a commit sequence number are seen in the view.
+  */
+  inline void snapshot_csn();
 
 public:
-  ReadViewBase(): m_low_limit_id(0) {}
+  ReadViewBase(): m_low_limit_id(0), m_csn(0) {}
+
+  /** @return the up limit id */
+  trx_id_t up_limit_id() const { return m_up_limit_id; }
 
 
   /**
@@ -78,6 +100,9 @@ class ReadViewBase
     all transaction ids below min(m_low_limit_id). These values effectively
     form oldest view.
 
+    A commit sequence number snapshot may not see some transactions
+    starting from its m_up_limit_id, so that is what is being appended.
+
     @param other    view to copy from
   */
   void append(const ReadViewBase &other)
@@ -85,7 +110,12 @@ class ReadViewBase
     ut_ad(&other != this);
     if (m_low_limit_no > other.m_low_limit_no)
       m_low_limit_no= other.m_low_limit_no;
-    if (m_low_limit_id > other.m_low_limit_id)
+    if (other.m_csn)
+    {
+      if (m_low_limit_id > other.m_up_limit_id)
+        m_low_limit_id= other.m_up_limit_id;
+    }
+    else if (m_low_limit_id > other.m_low_limit_id)
       m_low_limit_id= other.m_low_limit_id;
 
     trx_ids_t::iterator dst= m_ids.begin();
@@ -153,8 +183,11 @@ class ReadViewBase
       check_trx_id_sanity(id, name);
       return false;
     }
-    return id < m_up_limit_id ||
-           m_ids.empty() ||
+    if (id < m_up_limit_id)
+      return true;
+    if (m_csn)
+      return csn_visible(id);
+    return m_ids.empty() ||
            !std::binary_search(m_ids.begin(), m_ids.end(), id);
   }
 
@@ -278,6 +311,27 @@ class ReadView: public ReadViewBase
   }
 
 
+  /**
+    A wrapper around ReadViewBase::append() that also finds the oldest
+    commit sequence number snapshot.
+    Intended to be called by the purge coordinator task.
+
+    @param[in,out] to      view to append to
+    @param[in,out] min_csn minimum commit sequence number
+  */
+  void append_to(ReadViewBase *to, trx_id_t *min_csn) const
+  {
+    mutex_enter(&m_mutex);
+    if (is_open())
+    {
+      to->append(*this);
+      if (m_csn && m_csn < *min_csn)
+        *min_csn= m_csn;
+    }
+    mutex_exit(&m_mutex);
+  }
+
+
   /**
     Declare the object mostly unaccessible.
     innodb_monitor_set_option is operating also on freed transaction objects.
@@ -151,6 +151,41 @@ row_ins_step(
 /*=========*/
 	que_thr_t*	thr);	/*!< in: query thread */
 
+/** Start buffering the inserts of the current statement into an empty
+table, so that row_ins_bulk_end() can build the indexes with BtrBulk.
+This is only possible if the table is empty and the transaction can
+lock it exclusively without waiting. A single TRX_UNDO_EMPTY undo log
+record is written, which will empty the table on rollback.
+@param[in,out]	node		insert node
+@param[in]	thr		query thread
+@param[in]	mysql_table	MySQL table, for reporting duplicates
+@return whether the inserts will be buffered */
+bool
+row_ins_bulk_start(
+	ins_node_t*	node,
+	que_thr_t*	thr,
+	struct TABLE*	mysql_table)
+	MY_ATTRIBUTE((nonnull));
+
+/** Build the indexes from the inserts buffered since row_ins_bulk_start(),
+and stop buffering.
+@param[in,out]	node	insert node
+@param[in,out]	trx	transaction
+@return DB_SUCCESS or error code */
+dberr_t
+row_ins_bulk_end(
+	ins_node_t*	node,
+	trx_t*		trx)
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+
+/** Discard the inserts buffered since row_ins_bulk_start(), when the
+statement is going to be rolled back.
+@param[in,out]	node	insert node */
+void
+row_ins_bulk_discard(
+	ins_node_t*	node)
+	MY_ATTRIBUTE((nonnull));
+
 /* Insert node types */
 #define INS_SEARCHED	0	/* INSERT INTO ... SELECT ... */
 #define INS_VALUES	1	/* INSERT INTO ... VALUES ... */
@@ -164,6 +199,7 @@ row_ins_step(
 					inserted */
 
 struct row_prebuilt_t;
+struct row_merge_bulk_t;
 
 /** Insert node structure */
 struct ins_node_t
@@ -174,9 +210,11 @@ struct ins_node_t
 		row(NULL), table(table), select(NULL), values_list(NULL),
 		state(INS_NODE_SET_IX_LOCK), index(NULL),
 		entry_list(), entry(entry_list.end()),
-		trx_id(0), entry_sys_heap(mem_heap_create(128))
+		trx_id(0), entry_sys_heap(mem_heap_create(128)),
+		bulk(NULL)
 	{
 	}
+	~ins_node_t();
 	que_common_t common;	 /*!< node type: QUE_NODE_INSERT */
 	ulint		ins_type;/* INS_VALUES, INS_SEARCHED, or INS_DIRECT */
 	dtuple_t*	row;	/*!< row to insert */
@@ -205,6 +243,9 @@ struct ins_node_t
 				entry_list and sys fields are stored here;
 				if this is NULL, entry list should be created
 				and buffers for sys fields in row allocated */
+	/** inserts of the current statement into an empty table that
+	are being buffered, or NULL; @see row_ins_bulk_start() */
+	row_merge_bulk_t* bulk;
         void vers_update_end(row_prebuilt_t *prebuilt, bool history_row);
 };
 
@@ -55,6 +55,7 @@ Created 13/06/2005 Jan Lindstrom
 
 // Forward declaration
 struct ib_sequence_t;
+struct row_merge_workers_t;
 
 /** @brief Block size for I/O operations in merge sort.
 
@@ -384,6 +385,7 @@ row_merge_file_create(
 @param[in,out]	stage	performance schema accounting object, used by
 ALTER TABLE. If not NULL, stage->begin_phase_sort() will be called initially
 and then stage->inc() will be called for each record processed.
+@param[in,out]	workers	threads for merging runs, or NULL
 @return DB_SUCCESS or error code */
 dberr_t
 row_merge_sort(
@@ -398,7 +400,8 @@ row_merge_sort(
 	const double	pct_cost,
 	row_merge_block_t*	crypt_block,
 	ulint			space,
-	ut_stage_alter_t*	stage = NULL)
+	ut_stage_alter_t*	stage = NULL,
+	row_merge_workers_t*	workers = NULL)
 	MY_ATTRIBUTE((warn_unused_result));
 
 /*********************************************************************//**
@@ -459,4 +462,81 @@ row_merge_read_rec(
 	row_merge_block_t*	crypt_block, /*!< in: crypt buf or NULL */
 	ulint			space)	   /*!< in: space id */
 	MY_ATTRIBUTE((warn_unused_result));
+
+/** Inserts of one statement into an empty table, buffered so that the
+indexes can be built with BtrBulk when the statement ends.
+@see row_ins_bulk_start() */
+struct row_merge_bulk_t {
+	/** MySQL table, for reporting duplicates */
+	TABLE*				mysql_table;
+	/** sort buffer of each index, in the order of table->indexes */
+	std::vector<row_merge_buf_t*>	bufs;
+	/** sorted runs of each index that did not fit in the buffer */
+	std::vector<merge_file_t>	files;
+	/** temporary file for row_merge_sort() */
+	pfs_os_file_t			tmpfd;
+	/** externally stored columns of the clustered index records;
+	the BLOB pointer of a buffered record holds the offset and the
+	length of the column data in this file */
+	merge_file_t			blob_file;
+	/** buffer for merging the runs, 3 * srv_sort_buf_size bytes,
+	or NULL if not allocated yet */
+	row_merge_block_t*		block;
+	/** allocation of block */
+	ut_new_pfx_t			block_pfx;
+	/** DB_ROLL_PTR of the TRX_UNDO_EMPTY undo log record;
+	all the buffered records point to it */
+	roll_ptr_t			roll_ptr;
+	/** undo number of the TRX_UNDO_EMPTY undo log record; rolling
+	back to it empties all the indexes */
+	undo_no_t			undo_no;
+	/** largest AUTO_INCREMENT value of the buffered records */
+	ib_uint64_t			autoinc;
+};
+
+/** Create a buffer for the inserts of a statement into an empty table.
+@param[in]	table		table
+@param[in]	mysql_table	MySQL table, for reporting duplicates
+@param[in]	roll_ptr	DB_ROLL_PTR of the TRX_UNDO_EMPTY record
+@param[in]	undo_no		undo number of the TRX_UNDO_EMPTY record
+@return the buffer */
+row_merge_bulk_t*
+row_merge_bulk_create(
+	dict_table_t*	table,
+	TABLE*		mysql_table,
+	roll_ptr_t	roll_ptr,
+	undo_no_t	undo_no)
+	MY_ATTRIBUTE((warn_unused_result, nonnull));
+
+/** Buffer an index entry of an inserted row.
+@param[in,out]	bulk	buffered inserts
+@param[in]	i	position of the index in table->indexes
+@param[in,out]	entry	index entry; restored before returning
+@param[in,out]	trx	transaction
+@return DB_SUCCESS or error code */
+dberr_t
+row_merge_bulk_add(
+	row_merge_bulk_t*	bulk,
+	ulint			i,
+	dtuple_t*		entry,
+	trx_t*			trx)
+	MY_ATTRIBUTE((warn_unused_result, nonnull));
+
+/** Build the indexes of the table from the buffered inserts.
+@param[in,out]	bulk	buffered inserts
+@param[in,out]	trx	transaction
+@return DB_SUCCESS or error code */
+dberr_t
+row_merge_bulk_apply(
+	row_merge_bulk_t*	bulk,
+	trx_t*			trx)
+	MY_ATTRIBUTE((warn_unused_result, nonnull));
+
+/** Free the buffered inserts.
+@param[in,out]	bulk	buffered inserts */
+void
+row_merge_bulk_free(
+	row_merge_bulk_t*	bulk)
+	MY_ATTRIBUTE((nonnull));
+
 #endif /* row0merge.h */
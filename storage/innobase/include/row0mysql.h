@@ -562,7 +562,10 @@ struct mysql_row_templ_t {
 	ulint	is_virtual;		/*!< if a column is a virtual column */
 };
 
+/* Initial number of rows that are cached in fetch_cache */
 #define MYSQL_FETCH_CACHE_SIZE		8
+/* Maximum number of rows that are cached in fetch_cache */
+#define MYSQL_FETCH_CACHE_MAX_SIZE	4096
 /* After fetching this many rows, we start caching them in fetch_cache */
 #define MYSQL_FETCH_CACHE_THRESHOLD	4
 
@@ -632,6 +635,11 @@ struct row_prebuilt_t {
 					(VARCHAR can be off-page too) */
 	unsigned	versioned_write:1;/*!< whether this is
 					a versioned write */
+	unsigned	bulk_insert:1;	/*!< whether the next row_insert_for_mysql()
+					may start buffering the inserts of the
+					statement; @see row_ins_bulk_start() */
+	unsigned	ignore_dup_key:1;/*!< whether duplicate key errors
+					are ignored (INSERT IGNORE) */
 	mysql_row_templ_t* mysql_template;/*!< template used to transform
 					rows fast between MySQL and Innobase
 					formats; memory for this template
@@ -737,16 +745,24 @@ struct row_prebuilt_t {
 	ulint		n_rows_fetched;	/*!< number of rows fetched after
 					positioning the current cursor */
 	ulint		fetch_direction;/*!< ROW_SEL_NEXT or ROW_SEL_PREV */
-	byte*		fetch_cache[MYSQL_FETCH_CACHE_SIZE];
+	byte**		fetch_cache;
 					/*!< a cache for fetched rows if we
 					fetch many rows from the same cursor:
 					it saves CPU time to fetch them in a
 					batch; we reserve mysql_row_len
 					bytes for each such row; these
 					pointers point 4 bytes past the
-					allocated mem buf start, because
+					start of the row buffer, because
 					there is a 4 byte magic number at the
-					start and at the end */
+					start and at the end; NULL if the
+					cache has not been allocated */
+	ulint		fetch_cache_alloc;/*!< number of rows allocated
+					in fetch_cache */
+	ulint		fetch_cache_size;/*!< number of rows to cache in
+					a batch; starts at
+					MYSQL_FETCH_CACHE_SIZE and grows
+					with the length of the scan, see
+					innodb_fetch_cache_size */
 	bool		keep_other_fields_on_keyread; /*!< when using fetch
 					cache with HA_EXTRA_KEYREAD, don't
 					overwrite other fields in mysql row
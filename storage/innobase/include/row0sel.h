@@ -58,6 +58,10 @@ void
 sel_col_prefetch_buf_free(
 /*======================*/
 	sel_buf_t*	prefetch_buf);	/*!< in, own: prefetch buffer */
+
+/** Free the cache of prefetched MySQL rows of a table handle.
+@param[in,out]	prebuilt	prebuilt struct */
+void row_sel_prefetch_cache_free(row_prebuilt_t* prebuilt);
 /*********************************************************************//**
 Gets the plan node for the nth table in a join.
 @return plan node */
@@ -194,6 +198,19 @@ row_search_mvcc(
 	ulint		direction)
 	MY_ATTRIBUTE((warn_unused_result));
 
+/** Copy rows that an ongoing scan has already prefetched.
+@param[out]	buf		buffer for the rows in MySQL format
+@param[in]	stride		distance of consecutive rows in buf
+@param[in]	max_rows	maximum number of rows to copy
+@param[in,out]	prebuilt	prebuilt struct for the table handle
+@return number of rows copied to buf */
+ulint
+row_sel_dequeue_cached_rows(
+	byte*		buf,
+	ulint		stride,
+	ulint		max_rows,
+	row_prebuilt_t*	prebuilt);
+
 /********************************************************************//**
 Count rows in a R-Tree leaf level.
 @return DB_SUCCESS if successful */
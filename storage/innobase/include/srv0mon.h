@@ -412,6 +412,7 @@ enum monitor_id_t {
 	MONITOR_OLVD_SYSTEM_ROW_INSERTED,
 	MONITOR_OLVD_SYSTEM_ROW_DELETED,
 	MONITOR_OLVD_SYSTEM_ROW_UPDATED,
+	MONITOR_FETCH_CACHE_RESIZES,
 
 	/* Data DDL related counters */
 	MONITOR_MODULE_DDL_STATS,
@@ -245,6 +245,9 @@ extern my_bool	srv_file_per_table;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** innodb_fetch_cache_size; maximum size of the cache of prefetched rows
+of an index scan, in bytes */
+extern ulong	srv_fetch_cache_size;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -253,6 +256,20 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
+#ifdef __linux__
+/** Possible values of innodb_linux_aio */
+enum srv_linux_aio_t
+{
+	/** io_uring if available, otherwise libaio */
+	SRV_LINUX_AIO_AUTO,
+	/** io_uring */
+	SRV_LINUX_AIO_IO_URING,
+	/** libaio */
+	SRV_LINUX_AIO_LIBAIO
+};
+/** innodb_linux_aio: the native AIO interface to use on Linux */
+extern ulong	srv_linux_aio_method;
+#endif
 extern my_bool	srv_numa_interleave;
 
 /* Use atomic writes i.e disable doublewrite buffer */
@@ -291,6 +308,9 @@ extern my_bool	srv_undo_log_truncate;
 /* Enables or disables this prefix optimization.  Disabled by default. */
 extern my_bool	srv_prefix_index_cluster_optimization;
 
+/** innodb_read_view_csn: whether read views are commit sequence numbers */
+extern my_bool	srv_read_view_csn;
+
 /** Default size of UNDO tablespace (10MiB for innodb_page_size=16k) */
 constexpr ulint SRV_UNDO_TABLESPACE_SIZE_IN_PAGES= (10U << 20) /
   UNIV_PAGE_SIZE_DEF;
@@ -325,6 +345,8 @@ extern const ulint	srv_buf_pool_min_size;
 extern const ulint	srv_buf_pool_def_size;
 /** Requested buffer pool chunk size */
 extern ulong		srv_buf_pool_chunk_unit;
+/** innodb_buffer_pool_free_shards */
+extern ulong		srv_buf_pool_free_shards;
 /** Scan depth for LRU flush batch i.e.: number of blocks scanned*/
 extern ulong	srv_LRU_scan_depth;
 /** Whether or not to flush neighbors of a block */
@@ -349,6 +371,10 @@ extern my_bool	srv_random_read_ahead;
 extern ulong	srv_read_ahead_threshold;
 extern ulong	srv_n_read_io_threads;
 extern ulong	srv_n_write_io_threads;
+/** innodb_recovery_threads */
+extern ulong	srv_n_recovery_threads;
+/** innodb_page_cleaners */
+extern ulong	srv_n_page_cleaners;
 
 /* Defragmentation, Origianlly facebook default value is 100, but it's too high */
 #define SRV_DEFRAGMENT_FREQUENCY_DEFAULT 40
@@ -379,6 +405,8 @@ as enum type because the configure option takes unsigned integer type. */
 extern ulong	srv_innodb_stats_method;
 
 extern ulint	srv_max_n_open_files;
+/** innodb_lazy_tablespace_open */
+extern my_bool	srv_lazy_tablespace_open;
 
 extern double	srv_max_dirty_pages_pct;
 extern double	srv_max_dirty_pages_pct_lwm;
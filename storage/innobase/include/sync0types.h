@@ -144,9 +144,13 @@ V
 lock_sys_wait_mutex			Mutex protecting lock timeout data
 |
 V
-lock_sys_mutex				Mutex protecting lock_sys_t
+lock_sys_latch				Latch protecting lock_sys_t
 |
 V
+lock_sys rec_hash shard mutex		Mutex protecting a part of
+|					lock_sys.rec_hash while
+|					lock_sys_latch is S-latched
+V
 trx_sys.mutex				Mutex protecting trx_sys.trx_list
 |
 V
@@ -205,6 +209,7 @@ enum latch_level_t {
 	SYNC_RW_TRX_HASH_ELEMENT,
 	SYNC_READ_VIEW,
 	SYNC_TRX_SYS,
+	SYNC_LOCK_SYS_REC_SHARD,
 	SYNC_LOCK_SYS,
 	SYNC_LOCK_WAIT_SYS,
 
@@ -286,6 +291,7 @@ enum latch_id_t {
 	LATCH_ID_TRX_POOL_MANAGER,
 	LATCH_ID_TRX,
 	LATCH_ID_LOCK_SYS,
+	LATCH_ID_LOCK_SYS_REC_SHARD,
 	LATCH_ID_LOCK_SYS_WAIT,
 	LATCH_ID_TRX_SYS,
 	LATCH_ID_SRV_SYS_TASKS,
@@ -296,6 +296,10 @@ record */
 					fields of the record can change */
 #define	TRX_UNDO_DEL_MARK_REC	14	/* delete marking of a record; fields
 					do not change */
+#define	TRX_UNDO_EMPTY		15	/*!< inserts into an empty table
+					that are applied with BtrBulk at the
+					end of the statement; rollback empties
+					all the indexes of the table */
 #define	TRX_UNDO_CMPL_INFO_MULT	16U	/* compilation info is multiplied by
 					this and ORed to the type above */
 #define	TRX_UNDO_UPD_EXTERN	128U	/* This bit can be ORed to type_cmpl
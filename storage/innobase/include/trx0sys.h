@@ -842,6 +842,108 @@ class thread_safe_trx_ilist_t
   alignas(CACHE_LINE_SIZE) ilist<trx_t> trx_list;
 };
 
+/** Commit sequence numbers for innodb_read_view_csn.
+
+A read view is a commit sequence number (CSN): it sees exactly the
+transactions whose CSN is not greater than it. The CSN of a read-write
+transaction is looked up by transaction identifier in a ring of slots,
+or in an overflow map for those transactions that found their slot
+occupied. A slot may only be reused when its CSN is visible to all
+read views; a transaction that is found in neither place is therefore
+visible.
+
+A committing transaction writes its CSN through the pointer that
+register_rw() returned, so commit() never looks anything up. The
+limits for reusing slots are advanced by the purge coordinator and
+by the master task, see trx_sys_t::update_csn_limits(). */
+class trx_csn_t
+{
+  /** A transaction identifier and its CSN */
+  struct slot_t
+  {
+    /** transaction identifier, 0 if none, or LOCKED */
+    std::atomic<trx_id_t> id;
+    /** commit sequence number, or ACTIVE */
+    std::atomic<trx_id_t> csn;
+  };
+
+  /** slot_t::id of a slot that is being assigned */
+  static constexpr trx_id_t LOCKED= TRX_ID_MAX;
+  /** slot_t::csn of a transaction that has not been committed */
+  static constexpr trx_id_t ACTIVE= TRX_ID_MAX;
+  /** number of elements in m_slots */
+  static constexpr ulint N_SLOTS= 1U << 16;
+
+  /** the ring of slots, or nullptr if innodb_read_view_csn=OFF */
+  slot_t *m_slots;
+
+  /** the last allocated CSN */
+  MY_ALIGNED(CACHE_LINE_SIZE) std::atomic<trx_id_t> m_allocated;
+  /** the last CSN whose slot has been written; all preceding ones
+  have been written as well */
+  MY_ALIGNED(CACHE_LINE_SIZE) std::atomic<trx_id_t> m_published;
+
+  /** slots whose CSN is not greater than this may be reused */
+  MY_ALIGNED(CACHE_LINE_SIZE) std::atomic<trx_id_t> m_reuse_limit;
+  /** all transaction identifiers smaller than this are visible
+  to any new read view */
+  std::atomic<trx_id_t> m_up_limit_id;
+
+  /** smallest key in m_overflow, or TRX_ID_MAX */
+  MY_ALIGNED(CACHE_LINE_SIZE) std::atomic<trx_id_t> m_overflow_min;
+  /** latch protecting the structure of m_overflow; the values are
+  written without it */
+  mutable page_hash_latch m_overflow_latch;
+  /** CSN of transactions that could not be assigned a slot */
+  std::map<trx_id_t, std::atomic<trx_id_t>, std::less<trx_id_t>,
+           ut_allocator<std::pair<const trx_id_t, std::atomic<trx_id_t> > > >
+    m_overflow;
+
+  /** @return the slot of a transaction */
+  slot_t &slot(trx_id_t id) const { return m_slots[id % N_SLOTS]; }
+
+public:
+  trx_csn_t(): m_slots(nullptr) {}
+
+  /** @return whether innodb_read_view_csn=ON */
+  bool enabled() const { return m_slots != nullptr; }
+
+  /** Create the data structures if innodb_read_view_csn=ON. */
+  void create();
+  /** Free the data structures. */
+  void close();
+
+  /** Register a read-write transaction as active.
+  @param id  transaction identifier
+  @return where commit() will write the CSN of the transaction */
+  std::atomic<trx_id_t> *register_rw(trx_id_t id);
+  /** Assign the next CSN to a transaction, making it visible to
+  new read views.
+  @param entry  the return value of register_rw(), or nullptr if the
+  transaction is visible to all read views already */
+  void commit(std::atomic<trx_id_t> *entry);
+
+  /** @return the CSN of a new read view */
+  trx_id_t snapshot() const
+  { return m_published.load(std::memory_order_acquire); }
+  /** @return the up limit id of a new read view */
+  trx_id_t up_limit_id() const
+  { return m_up_limit_id.load(std::memory_order_acquire); }
+
+  /** Determine whether a read view sees a transaction.
+  @param id   transaction identifier
+  @param csn  CSN of the read view
+  @return whether the transaction was committed at or before csn */
+  bool visible(trx_id_t id, trx_id_t csn) const;
+
+  /** Advance the limits after the oldest view has been cloned.
+  @param up_limit_id  smallest transaction identifier that was active
+  when the view was created
+  @param oldest_csn   smallest CSN of any open read view, or of a read
+  view that will be created */
+  void purge_update(trx_id_t up_limit_id, trx_id_t oldest_csn);
+};
+
 /** The transaction system central memory data structure. */
 class trx_sys_t
 {
@@ -894,6 +996,9 @@ class trx_sys_t
 
   MY_ALIGNED(CACHE_LINE_SIZE) rw_trx_hash_t rw_trx_hash;
 
+  /** Commit sequence numbers for innodb_read_view_csn */
+  trx_csn_t csn;
+
 
 #ifdef WITH_WSREP
   /** Latest recovered XID during startup */
@@ -1072,6 +1177,8 @@ class trx_sys_t
   void register_rw(trx_t *trx)
   {
     trx->id= get_new_trx_id_no_refresh();
+    if (csn.enabled())
+      trx->csn_entry= csn.register_rw(trx->id);
     rw_trx_hash.insert(trx);
     refresh_rw_trx_hash_version();
   }
@@ -1086,6 +1193,11 @@ class trx_sys_t
 
   void deregister_rw(trx_t *trx)
   {
+    if (csn.enabled())
+    {
+      csn.commit(trx->csn_entry);
+      trx->csn_entry= nullptr;
+    }
     rw_trx_hash.erase(trx);
   }
 
@@ -1131,7 +1243,14 @@ class trx_sys_t
     in. This function is called by purge thread to determine whether it should
     purge the delete marked record or not.
   */
-  void clone_oldest_view(ReadViewBase *view) const;
+  void clone_oldest_view(ReadViewBase *view);
+
+
+  /**
+    Advances the limits of csn to the oldest open read view, so that
+    its slots can be reused without waiting for purge.
+  */
+  void update_csn_limits();
 
 
   /** @return the number of active views */
@@ -536,12 +536,14 @@ struct trx_lock_t {
 	unsigned	table_cached;
 
 	mem_heap_t*	lock_heap;	/*!< memory heap for trx_locks;
-					protected by lock_sys.mutex */
+					protected by lock_sys.latch, which
+					may be S-latched by the thread
+					serving the transaction */
 
 	trx_lock_list_t trx_locks;	/*!< locks requested by the transaction;
 					insertions are protected by trx->mutex
-					and lock_sys.mutex; removals are
-					protected by lock_sys.mutex */
+					and lock_sys.latch; removals are
+					protected by X-latched lock_sys.latch */
 
 	lock_list	table_locks;	/*!< All table locks requested by this
 					transaction, including AUTOINC locks */
@@ -725,6 +727,9 @@ struct trx_t : ilist_node<> {
 					lock_sys.mutex) */
 
 	trx_id_t	id;		/*!< transaction id */
+	/** the trx_sys.csn entry of a read-write transaction,
+	see trx_csn_t::register_rw() */
+	std::atomic<trx_id_t>*	csn_entry;
 
 	/** State of the trx from the point of view of concurrency control
 	and the valid state transitions.
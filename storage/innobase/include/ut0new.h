@@ -889,6 +889,7 @@ constexpr const char* const auto_event_names[] =
   "trx0roll",
   "trx0rseg",
   "trx0seg",
+  "trx0sys",
   "trx0trx",
   "trx0undo",
   "ut0list",
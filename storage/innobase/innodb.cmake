@@ -63,6 +63,13 @@ IF(UNIX)
       ADD_DEFINITIONS(-DLINUX_NATIVE_AIO=1)
       LINK_LIBRARIES(aio)
     ENDIF()
+    OPTION(WITH_URING "Use io_uring for asynchronous I/O if liburing is found" ON)
+    IF(WITH_URING)
+      FIND_PACKAGE(URING QUIET)
+      IF(URING_FOUND)
+        ADD_DEFINITIONS(-DHAVE_URING=1)
+      ENDIF()
+    ENDIF()
     IF(HAVE_LIBNUMA)
       LINK_LIBRARIES(numa)
     ENDIF()
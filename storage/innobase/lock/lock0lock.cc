@@ -42,6 +42,7 @@ Created 5/7/1996 Heikki Tuuri
 #include "row0mysql.h"
 #include "row0vers.h"
 #include "pars0pars.h"
+#include "sync0sync.h"
 
 #include <set>
 
@@ -455,7 +456,11 @@ void lock_sys_t::create(ulint n_cells)
 		(ut_zalloc_nokey(srv_max_n_threads * sizeof *waiting_threads));
 	last_slot = waiting_threads;
 
-	mutex_create(LATCH_ID_LOCK_SYS, &mutex);
+	rw_lock_create(lock_latch_key, &latch, SYNC_LOCK_SYS);
+
+	for (rec_shard_t& shard : rec_shards) {
+		mutex_create(LATCH_ID_LOCK_SYS_REC_SHARD, &shard.mutex);
+	}
 
 	mutex_create(LATCH_ID_LOCK_SYS_WAIT, &wait_mutex);
 
@@ -489,7 +494,9 @@ void lock_sys_t::resize(ulint n_cells)
 {
 	ut_ad(this == &lock_sys);
 
-	mutex_enter(&mutex);
+	/* The exclusive latch also protects the mapping of
+	rec_hash cells to rec_shards[] */
+	lock_mutex_enter();
 
 	hash_table_t old_hash(rec_hash);
 	rec_hash.create(n_cells);
@@ -508,7 +515,7 @@ void lock_sys_t::resize(ulint n_cells)
 	HASH_MIGRATE(&old_hash, &prdt_page_hash, lock_t, hash,
 		     lock_rec_lock_fold);
 	old_hash.free();
-	mutex_exit(&mutex);
+	lock_mutex_exit();
 }
 
 
@@ -528,7 +535,10 @@ void lock_sys_t::close()
 	prdt_hash.free();
 	prdt_page_hash.free();
 
-	mutex_destroy(&mutex);
+	rw_lock_free(&latch);
+	for (rec_shard_t& shard : rec_shards) {
+		mutex_destroy(&shard.mutex);
+	}
 	mutex_destroy(&wait_mutex);
 
 	for (ulint i = srv_max_n_threads; i--; ) {
@@ -913,7 +923,7 @@ lock_rec_has_expl(
 {
 	lock_t*	lock;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_sys.is_rec_latched(block->page.id()));
 	ut_ad((precise_mode & LOCK_MODE_MASK) == LOCK_S
 	      || (precise_mode & LOCK_MODE_MASK) == LOCK_X);
 	ut_ad(!(precise_mode & LOCK_INSERT_INTENTION));
@@ -962,7 +972,7 @@ lock_rec_other_has_expl_req(
 					are taken into account */
 {
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_sys.is_rec_latched(block->page.id()));
 	ut_ad(mode == LOCK_X || mode == LOCK_S);
 
 	/* Only GAP lock can be on SUPREMUM, and we are not looking for
@@ -1251,7 +1261,7 @@ lock_rec_create_low(
 	ulint		n_bits;
 	ulint		n_bytes;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_sys.is_rec_latched(page_id));
 	ut_ad(holds_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
@@ -1401,8 +1411,8 @@ lock_rec_create_low(
 	if (!holds_trx_mutex) {
 		trx_mutex_exit(trx);
 	}
-	MONITOR_INC(MONITOR_RECLOCK_CREATED);
-	MONITOR_INC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK);
 
 	return lock;
 }
@@ -1527,7 +1537,8 @@ lock_rec_find_similar_on_page(
 	lock_t*         lock,           /*!< in: lock_sys.get_first() */
 	const trx_t*    trx)            /*!< in: transaction */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(!lock || lock_sys.is_rec_latched(
+		      lock->un_member.rec_lock.page_id));
 
 	for (/* No op */;
 	     lock != NULL;
@@ -1569,7 +1580,7 @@ lock_rec_add_to_queue(
 					transaction mutex */
 {
 #ifdef UNIV_DEBUG
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_sys.is_rec_latched(block->page.id()));
 	ut_ad(caller_owns_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index)
 	      || dict_index_get_online_status(index) != ONLINE_INDEX_CREATION);
@@ -1662,6 +1673,101 @@ lock_rec_add_to_queue(
 		type_mode, block, heap_no, index, trx, caller_owns_trx_mutex);
 }
 
+/** Try to lock a record without waiting, while holding lock_sys.latch
+in shared mode and the rec_hash shard mutex of the page. This covers
+the common case where no conflicting lock exists, without serializing
+on the exclusive lock_sys.latch.
+@param[in]	impl	if true, no lock is set if no wait is necessary
+@param[in]	mode	lock mode: LOCK_X or LOCK_S possibly ORed to either
+			LOCK_GAP or LOCK_REC_NOT_GAP
+@param[in]	block	buffer block containing the record
+@param[in]	heap_no	heap number of record
+@param[in]	index	index of record
+@param[in,out]	trx	transaction
+@param[out]	err	DB_SUCCESS or DB_SUCCESS_LOCKED_REC
+@return whether the request was handled
+@retval false if the request has to be processed while holding
+lock_sys.latch in exclusive mode */
+static
+bool
+lock_rec_lock_try(
+	bool			impl,
+	unsigned		mode,
+	const buf_block_t*	block,
+	ulint			heap_no,
+	dict_index_t*		index,
+	trx_t*			trx,
+	dberr_t&		err)
+{
+#ifdef WITH_WSREP
+  /* Conflicts of Galera transactions may need to be resolved
+  by killing the holder of the lock. */
+  if (trx->is_wsrep())
+    return false;
+#endif /* WITH_WSREP */
+
+  const page_id_t id(block->page.id());
+  LockShardGuard g(id);
+
+  if (lock_table_has(trx, index->table,
+                     static_cast<lock_mode>(LOCK_MODE_MASK & mode)))
+  {
+    err= DB_SUCCESS;
+    return true;
+  }
+
+  lock_t *lock= lock_sys.get_first(id);
+  if (!lock)
+  {
+    /* No locks exist on the page. Note that we don't own the trx mutex. */
+    if (!impl)
+      lock_rec_create(
+#ifdef WITH_WSREP
+        NULL, NULL,
+#endif
+        mode, block, heap_no, index, trx, false);
+    err= DB_SUCCESS_LOCKED_REC;
+    return true;
+  }
+
+  err= DB_SUCCESS;
+  trx_mutex_enter(trx);
+  if (!lock_rec_get_next_on_page(lock) &&
+      lock->trx == trx &&
+      lock->type_mode == (ulint(mode) | LOCK_REC) &&
+      lock_rec_get_n_bits(lock) > heap_no)
+  {
+    /* The only lock on the page is a similar lock of ours */
+    if (!impl && !lock_rec_get_nth_bit(lock, heap_no))
+    {
+      lock_rec_set_nth_bit(lock, heap_no);
+      err= DB_SUCCESS_LOCKED_REC;
+    }
+  }
+  else if (!lock_rec_has_expl(mode, block, heap_no, trx))
+  {
+    const bool is_supremum= heap_no == PAGE_HEAP_NO_SUPREMUM;
+    for (lock= lock_rec_get_first(&lock_sys.rec_hash, block, heap_no); lock;
+         lock= lock_rec_get_next(heap_no, lock))
+    {
+      if (lock_rec_has_to_wait(true, trx, mode, lock, is_supremum))
+      {
+        trx_mutex_exit(trx);
+        return false;
+      }
+    }
+
+    if (!impl)
+    {
+      lock_rec_add_to_queue(LOCK_REC | mode, block, heap_no, index, trx,
+                            true);
+      err= DB_SUCCESS_LOCKED_REC;
+    }
+  }
+  trx_mutex_exit(trx);
+  return true;
+}
+
 /*********************************************************************//**
 Tries to lock the specified record in the mode requested. If not immediately
 possible, enqueues a waiting lock request. This is a low-level function
@@ -1698,6 +1804,12 @@ lock_rec_lock(
   ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
   DBUG_EXECUTE_IF("innodb_report_deadlock", return DB_DEADLOCK;);
 
+  if (lock_rec_lock_try(impl, mode, block, heap_no, index, trx, err))
+  {
+    MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+    return err;
+  }
+
   lock_mutex_enter();
   ut_ad((LOCK_MODE_MASK & mode) != LOCK_S ||
         lock_table_has(trx, index->table, LOCK_IS));
@@ -1924,7 +2036,7 @@ static void lock_rec_dequeue_from_page(lock_t* in_lock)
 	UT_LIST_REMOVE(in_lock->trx->lock.trx_locks, in_lock);
 
 	MONITOR_INC(MONITOR_RECLOCK_REMOVED);
-	MONITOR_DEC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_DEC(MONITOR_NUM_RECLOCK);
 
 	/* Check if waiting locks in the queue can now be granted:
 	grant locks if there are no conflicting locks ahead. Stop at
@@ -1974,7 +2086,7 @@ lock_rec_discard(
 	UT_LIST_REMOVE(trx_lock->trx_locks, in_lock);
 
 	MONITOR_INC(MONITOR_RECLOCK_REMOVED);
-	MONITOR_DEC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_DEC(MONITOR_NUM_RECLOCK);
 }
 
 /*************************************************************//**
@@ -3574,17 +3686,55 @@ lock_table(
 	return(err);
 }
 
+/** Try to acquire an exclusive table lock without waiting.
+@param[in,out]	table	table
+@param[in,out]	trx	transaction
+@return whether the lock was granted */
+bool
+lock_table_x_try(
+	dict_table_t*	table,
+	trx_t*		trx)
+{
+	ut_ad(!table->is_temporary());
+	ut_ad(!srv_read_only_mode);
+
+	if (lock_table_has(trx, table, LOCK_X)) {
+		return(true);
+	}
+
+	if (!trx->read_only && trx->rsegs.m_redo.rseg == 0) {
+		trx_set_rw_mode(trx);
+	}
+
+	lock_mutex_enter();
+
+	const bool granted = !lock_table_other_has_incompatible(
+		trx, LOCK_WAIT, table, LOCK_X);
+
+	if (granted) {
+		trx_mutex_enter(trx);
+		lock_table_create(table, LOCK_X, trx);
+		trx_mutex_exit(trx);
+	}
+
+	lock_mutex_exit();
+
+	return(granted);
+}
+
 /*********************************************************************//**
-Creates a table IX lock object for a resurrected transaction. */
+Creates a table IX or X lock object for a resurrected transaction. */
 void
-lock_table_ix_resurrect(
-/*====================*/
+lock_table_resurrect(
+/*=================*/
 	dict_table_t*	table,	/*!< in/out: table */
-	trx_t*		trx)	/*!< in/out: transaction */
+	trx_t*		trx,	/*!< in/out: transaction */
+	lock_mode	mode)	/*!< in: LOCK_IX or LOCK_X */
 {
 	ut_ad(trx->is_recovered);
+	ut_ad(mode == LOCK_IX || mode == LOCK_X);
 
-	if (lock_table_has(trx, table, LOCK_IX)) {
+	if (lock_table_has(trx, table, mode)) {
 		return;
 	}
 
@@ -3594,10 +3744,10 @@ lock_table_ix_resurrect(
 	other transactions have in the table lock queue. */
 
 	ut_ad(!lock_table_other_has_incompatible(
-		      trx, LOCK_WAIT, table, LOCK_IX));
+		      trx, LOCK_WAIT, table, mode));
 
 	trx_mutex_enter(trx);
-	lock_table_create(table, LOCK_IX, trx);
+	lock_table_create(table, mode, trx);
 	lock_mutex_exit();
 	trx_mutex_exit(trx);
 }
@@ -4807,7 +4957,6 @@ lock_rec_insert_check_and_lock(
 	ulint		heap_no = page_rec_get_heap_no(next_rec);
 	ut_ad(!rec_is_metadata(next_rec, *index));
 
-	lock_mutex_enter();
 	/* Because this code is invoked for a running transaction by
 	the thread that is serving the transaction, it is not necessary
 	to hold trx->mutex here. */
@@ -4817,13 +4966,16 @@ lock_rec_insert_check_and_lock(
 	BTR_NO_LOCKING_FLAG and skip the locking altogether. */
 	ut_ad(lock_table_has(trx, index->table, LOCK_IX));
 
-	lock = lock_rec_get_first(&lock_sys.rec_hash, block, heap_no);
+	{
+		/* Most inserts find no locks on the successor record.
+		Check that without the exclusive lock_sys.latch. */
+		LockShardGuard	g(block->page.id());
+		lock = lock_rec_get_first(&lock_sys.rec_hash, block, heap_no);
+	}
 
 	if (lock == NULL) {
 		/* We optimize CPU time usage in the simplest case */
 
-		lock_mutex_exit();
-
 		if (inherit_in && !dict_index_is_clust(index)) {
 			/* Update the page max trx id field */
 			page_update_max_trx_id(block,
@@ -4844,6 +4996,8 @@ lock_rec_insert_check_and_lock(
 
 	*inherit = true;
 
+	lock_mutex_enter();
+
 	/* If another transaction has an explicit lock request which locks
 	the gap, waiting or granted, on the successor, the insert has to wait.
 
@@ -98,6 +98,8 @@ void log_buffer_extend(ulong len)
 		" exceeds innodb_log_buffer_size="
 		<< srv_log_buffer_size << " / 2). Trying to extend it.";
 
+	log_sys.wait_for_copies();
+
 	byte* old_buf = log_sys.buf;
 	byte* old_flush_buf = log_sys.flush_buf;
 	const ulong old_buf_size = srv_log_buffer_size;
@@ -217,6 +219,24 @@ void log_t::create()
   log_block_set_first_rec_group(buf, LOG_BLOCK_HDR_SIZE);
 
   buf_free= LOG_BLOCK_HDR_SIZE;
+  pending_copies= 0;
+}
+
+/** Wait until all space that was reserved in buf has been filled
+by mtr_t::copy_log(). The caller must hold mutex, so that no more
+space can be reserved. */
+void log_t::wait_for_copies() const
+{
+  mysql_mutex_assert_owner(&mutex);
+
+  /* The copying is a memcpy() that does not wait for anything. */
+  for (ulint i= 0; pending_copies.load(std::memory_order_acquire); i++)
+  {
+    if (i < 64)
+      ut_delay(1);
+    else
+      os_thread_yield();
+  }
 }
 
 mapped_file_t::~mapped_file_t() noexcept
@@ -688,6 +708,10 @@ static void log_write(bool rotate_key)
 			      log_sys.get_lsn()));
 
 
+	/* Wait for mtr_t::commit() in other threads to fill the space
+	that they reserved. */
+	log_sys.wait_for_copies();
+
 	start_offset = log_sys.buf_next_to_write;
 	end_offset = log_sys.buf_free;
 
@@ -2592,6 +2592,98 @@ buf_block_t *recv_sys_t::recover_low(const page_id_t page_id)
   return block;
 }
 
+/** Pages of a recovery batch that are applied by one thread */
+struct recv_apply_part_t
+{
+  /** identifiers of the pages, in ascending order */
+  std::vector<page_id_t, ut_allocator<page_id_t> > ids;
+  /** the task that applies the log, or nullptr for the calling thread */
+  tpool::waitable_task *task= nullptr;
+};
+
+/** Determine which recovery thread applies the log to a page.
+All pages of a read-ahead area are assigned to the same thread,
+so that the thread can submit the reads in recv_read_in_area().
+@param page_id  page identifier
+@param n_parts  number of recovery threads
+@return the recovery thread, between 0 and n_parts - 1 */
+static ulint recv_apply_part(const page_id_t page_id, ulint n_parts)
+{
+  return ut_fold_ulint_pair(page_id.space(),
+                            page_id.page_no() / RECV_READ_AHEAD_AREA) %
+    n_parts;
+}
+
+/** Apply buffered log to the pages of a recv_apply_part_t.
+@param part  recv_apply_part_t */
+static void recv_apply_part_task(void *part)
+{
+  const recv_apply_part_t *p= static_cast<const recv_apply_part_t*>(part);
+  recv_sys.apply_pages(p->ids.data(), p->ids.size());
+}
+
+/** Apply buffered log to some pages of the current batch.
+@param ids    identifiers of the pages, in ascending order
+@param n_ids  number of elements in ids[] */
+void recv_sys_t::apply_pages(const page_id_t *ids, size_t n_ids)
+{
+  mtr_t mtr;
+  buf_block_t *free_block= buf_LRU_get_free_block(false);
+
+  mutex_enter(&mutex);
+
+  for (size_t i= 0; i < n_ids; i++)
+  {
+    const page_id_t page_id= ids[i];
+next_page:
+    map::iterator p= pages.find(page_id);
+
+    if (p == pages.end())
+      /* The log was applied when the page was read. */
+      continue;
+
+    page_recv_t &recs= p->second;
+    ut_ad(!recs.log.empty());
+
+    switch (recs.state) {
+    case page_recv_t::RECV_BEING_READ:
+    case page_recv_t::RECV_BEING_PROCESSED:
+      continue;
+    case page_recv_t::RECV_WILL_NOT_READ:
+      if (UNIV_LIKELY(!!recover_low(page_id, p, mtr, free_block)))
+      {
+        mutex_exit(&mutex);
+        free_block= buf_LRU_get_free_block(false);
+        mutex_enter(&mutex);
+      }
+      continue;
+    case page_recv_t::RECV_NOT_PROCESSED:
+      mtr.start();
+      mtr.set_log_mode(MTR_LOG_NO_REDO);
+      if (buf_block_t *block= buf_page_get_low(page_id, 0, RW_X_LATCH,
+                                               nullptr, BUF_GET_IF_IN_POOL,
+                                               __FILE__, __LINE__,
+                                               &mtr, nullptr, false))
+      {
+        buf_block_dbg_add_level(block, SYNC_NO_ORDER_CHECK);
+        recv_recover_page(block, mtr, p);
+        ut_ad(mtr.has_committed());
+        p->second.log.clear();
+        pages.erase(p);
+        continue;
+      }
+
+      mtr.commit();
+      recv_read_in_area(page_id);
+      /* If the page was not submitted for reading, look it up again. */
+      goto next_page;
+    }
+  }
+
+  mutex_exit(&mutex);
+  buf_pool.free_block(free_block);
+}
+
 /** Apply buffered log to persistent data pages.
 @param last_batch     whether it is possible to write more redo log */
 void recv_sys_t::apply(bool last_batch)
@@ -2645,57 +2737,32 @@ void recv_sys_t::apply(bool last_batch)
         trim(page_id_t(id + srv_undo_space_id_start, t.pages), t.lsn);
     }
 
-    buf_block_t *free_block= buf_LRU_get_free_block(false);
+    /* Partition the pages between the recovery threads. Each page is
+    applied by one thread, in ascending LSN order. */
+    const ulint n_parts= std::min<ulint>(srv_n_recovery_threads, n);
+    std::vector<recv_apply_part_t> parts(n_parts);
 
-    for (map::iterator p= pages.begin(); p != pages.end(); )
+    for (const auto &p : pages)
+      parts[recv_apply_part(p.first, n_parts)].ids.push_back(p.first);
+
+    mutex_exit(&mutex);
+
+    for (ulint i= 1; i < n_parts; i++)
     {
-      const page_id_t page_id= p->first;
-      page_recv_t &recs= p->second;
-      ut_ad(!recs.log.empty());
-
-      switch (recs.state) {
-      case page_recv_t::RECV_BEING_READ:
-      case page_recv_t::RECV_BEING_PROCESSED:
-        p++;
-        continue;
-      case page_recv_t::RECV_WILL_NOT_READ:
-        if (UNIV_LIKELY(!!recover_low(page_id, p, mtr, free_block)))
-        {
-          mutex_exit(&mutex);
-          free_block= buf_LRU_get_free_block(false);
-          mutex_enter(&mutex);
-next_page:
-          p= pages.lower_bound(page_id);
-        }
-        continue;
-      case page_recv_t::RECV_NOT_PROCESSED:
-        mtr.start();
-        mtr.set_log_mode(MTR_LOG_NO_REDO);
-        if (buf_block_t *block= buf_page_get_low(page_id, 0, RW_X_LATCH,
-                                                 nullptr, BUF_GET_IF_IN_POOL,
-                                                 __FILE__, __LINE__,
-                                                 &mtr, nullptr, false))
-        {
-          buf_block_dbg_add_level(block, SYNC_NO_ORDER_CHECK);
-          recv_recover_page(block, mtr, p);
-          ut_ad(mtr.has_committed());
-        }
-        else
-        {
-          mtr.commit();
-          recv_read_in_area(page_id);
-          break;
-        }
-        map::iterator r= p++;
-        r->second.log.clear();
-        pages.erase(r);
-        continue;
-      }
+      parts[i].task= new tpool::waitable_task(recv_apply_part_task,
+                                              &parts[i]);
+      srv_thread_pool->submit_task(parts[i].task);
+    }
 
-      goto next_page;
+    apply_pages(parts[0].ids.data(), parts[0].ids.size());
+
+    for (ulint i= 1; i < n_parts; i++)
+    {
+      parts[i].task->wait();
+      delete parts[i].task;
     }
 
-    buf_pool.free_block(free_block);
+    mutex_enter(&mutex);
 
     /* Wait until all the pages have been processed */
     while (!pages.empty())
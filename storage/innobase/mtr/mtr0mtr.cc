@@ -373,6 +373,7 @@ void mtr_t::start()
   ut_d(m_user_space_id= TRX_SYS_SPACE);
   m_user_space= nullptr;
   m_commit_lsn= 0;
+  m_log_buf= nullptr;
   m_freed_in_system_tablespace= m_trim_pages= false;
 }
 
@@ -401,8 +402,9 @@ void mtr_t::commit()
     ut_ad(!srv_read_only_mode || m_log_mode == MTR_LOG_NO_REDO);
 
     std::pair<lsn_t,bool> lsns;
+    const ulint len= prepare_write();
 
-    if (const ulint len= prepare_write())
+    if (len)
       lsns= finish_write(len);
     else
       lsns= { m_commit_lsn, false };
@@ -447,6 +449,14 @@ void mtr_t::commit()
     if (m_made_dirty)
       mysql_mutex_unlock(&log_sys.flush_order_mutex);
 
+    /* Other threads may be reserving space or copying their log
+    while we copy ours. Any write of the log buffer will wait for us.
+    The next mini-transaction that makes pages dirty acquires
+    flush_order_mutex while holding log_sys.mutex, so we must not
+    hold flush_order_mutex while copying. */
+    if (len)
+      copy_log();
+
     m_memo.for_each_block_in_reverse(CIterate<ReleaseLatches>());
 
     if (lsns.second)
@@ -491,6 +501,7 @@ void mtr_t::commit_files(lsn_t checkpoint_lsn)
 	}
 
 	finish_write(m_log.size());
+	copy_log();
 	srv_stats.log_write_requests.inc();
 	release_resources();
 
@@ -669,7 +680,8 @@ static void log_margin_checkpoint_age(ulint len)
 }
 
 
-/** Open the log for log_write_low(). The log must be closed with log_close().
+/** Open the log for log_reserve_low(). The log must be closed with
+log_close().
 @param len length of the data to be written
 @return start lsn of the log record */
 static lsn_t log_reserve_and_open(size_t len)
@@ -703,8 +715,9 @@ static lsn_t log_reserve_and_open(size_t len)
   return log_sys.get_lsn();
 }
 
-/** Append data to the log buffer. */
-static void log_write_low(const void *str, size_t size)
+/** Reserve space in the log buffer.
+@param size  number of bytes to be copied by log_copy_low() */
+static void log_reserve_low(size_t size)
 {
   mysql_mutex_assert_owner(&log_sys.mutex);
   const ulint trailer_offset= log_sys.trailer_offset();
@@ -721,10 +734,7 @@ static void log_write_low(const void *str, size_t size)
       len= trailer_offset - log_sys.buf_free % OS_FILE_LOG_BLOCK_SIZE;
     }
 
-    memcpy(log_sys.buf + log_sys.buf_free, str, len);
-
     size-= len;
-    str= static_cast<const char*>(str) + len;
 
     byte *log_block= static_cast<byte*>(ut_align_down(log_sys.buf +
                                                       log_sys.buf_free,
@@ -754,6 +764,37 @@ static void log_write_low(const void *str, size_t size)
   while (size);
 }
 
+/** Copy data to space that was reserved by log_reserve_low(),
+skipping the log block headers and trailers.
+@param buf   position in the log buffer
+@param str   data to copy
+@param size  length of str, in bytes
+@return the position after the data */
+static byte *log_copy_low(byte *buf, const void *str, size_t size)
+{
+  const ulint trailer_offset= log_sys.trailer_offset();
+
+  for (;;)
+  {
+    const size_t offset= ut_align_offset(buf, OS_FILE_LOG_BLOCK_SIZE);
+    ut_ad(offset >= LOG_BLOCK_HDR_SIZE);
+    ut_ad(offset < trailer_offset);
+    const size_t len= std::min(size, trailer_offset - offset);
+
+    memcpy(buf, str, len);
+    buf+= len;
+    size-= len;
+    str= static_cast<const char*>(str) + len;
+
+    if (offset + len == trailer_offset)
+      /* Skip the trailer of this block and the header of the next one. */
+      buf+= log_sys.framing_size();
+
+    if (!size)
+      return buf;
+  }
+}
+
 /** Close the log at mini-transaction commit.
 @return whether buffer pool flushing is needed */
 static bool log_close(lsn_t lsn)
@@ -799,14 +840,17 @@ static bool log_close(lsn_t lsn)
   return true;
 }
 
-/** Write the block contents to the REDO log */
-struct mtr_write_log
+/** Copy the block contents to the reserved space in the redo log buffer */
+struct mtr_copy_log
 {
-  /** Append a block to the redo log buffer.
-  @return whether the appending should continue */
-  bool operator()(const mtr_buf_t::block_t *block) const
+  /** the current position in log_sys.buf */
+  byte *buf;
+
+  /** Copy a block to the redo log buffer.
+  @return whether the copying should continue */
+  bool operator()(const mtr_buf_t::block_t *block)
   {
-    log_write_low(block->begin(), block->used());
+    buf= log_copy_low(buf, block->begin(), block->used());
     return true;
   }
 };
@@ -871,28 +915,43 @@ inline std::pair<lsn_t,bool> mtr_t::finish_write(ulint len)
 	lsn_t start_lsn;
 
 	if (m_log.is_small()) {
-		const mtr_buf_t::block_t* front = m_log.front();
-		ut_ad(len <= front->used());
-
-		m_commit_lsn = log_reserve_and_write_fast(front->begin(), len,
-							  &start_lsn);
+		ut_ad(len <= m_log.front()->used());
+		m_log_buf = log_sys.buf + log_sys.buf_free;
+		m_commit_lsn = log_reserve_fast(len, &start_lsn);
 
 		if (m_commit_lsn) {
+			log_sys.pending_copies.fetch_add(
+				1, std::memory_order_relaxed);
 			return std::make_pair(start_lsn, false);
 		}
 	}
 
-	/* Open the database log for log_write_low */
+	/* Open the database log for log_reserve_low */
 	start_lsn = log_reserve_and_open(len);
 
-	mtr_write_log write_log;
-	m_log.for_each_block(write_log);
+	m_log_buf = log_sys.buf + log_sys.buf_free;
+	log_reserve_low(len);
+	log_sys.pending_copies.fetch_add(1, std::memory_order_relaxed);
 	m_commit_lsn = log_sys.get_lsn();
 	bool flush = log_close(m_commit_lsn);
 
 	return std::make_pair(start_lsn, flush);
 }
 
+/** Copy the redo log records to the space that was reserved
+by finish_write(). This may be invoked without holding log_sys.mutex. */
+inline void mtr_t::copy_log()
+{
+	ut_ad(m_log_buf);
+
+	mtr_copy_log copy_log = { m_log_buf };
+	m_log.for_each_block(copy_log);
+	ut_d(m_log_buf = NULL);
+
+	/* Let log_t::wait_for_copies() observe the copied data. */
+	log_sys.pending_copies.fetch_sub(1, std::memory_order_release);
+}
+
 /** Find out whether a block was X-latched by the mini-transaction */
 struct FindBlockX
 {
@@ -1454,7 +1454,7 @@ os_file_create_func(
 
 				if (!os_file_lock(file, name)) {
 					*success = true;
-					return(file);
+					goto func_exit;
 				}
 			}
 
@@ -1468,6 +1468,12 @@ os_file_create_func(
 	}
 #endif /* USE_FILE_LOCK */
 
+func_exit:
+	if (*success && purpose == OS_FILE_AIO && srv_thread_pool) {
+		/* Put the file into the io_uring registered file table */
+		srv_thread_pool->bind(file);
+	}
+
 	return(file);
 }
 
@@ -1658,6 +1664,8 @@ os_file_get_last_error.
 @return true if success */
 bool os_file_close_func(os_file_t file)
 {
+  if (srv_thread_pool)
+    srv_thread_pool->unbind(file);
   int ret= close(file);
 
   if (!ret)
@@ -4035,20 +4043,50 @@ bool os_aio_init(ulint n_reader_threads, ulint n_writer_threads, ulint)
   int max_events = max_read_events + max_write_events;
 	int ret;
 
+#ifdef HAVE_URING
+	if (srv_use_native_aio
+	    && srv_linux_aio_method != SRV_LINUX_AIO_LIBAIO) {
+		if (!srv_thread_pool->configure_aio(
+			    true, max_events,
+			    tpool::aio_implementation::OS_IO_URING)) {
+			ib::info() << "Using liburing";
+			goto created;
+		}
+		if (srv_linux_aio_method == SRV_LINUX_AIO_IO_URING) {
+			ib::warn() << "io_uring is not available;"
+				" falling back to innodb_linux_aio=aio";
+		}
+	}
+#elif defined __linux__
+	if (srv_use_native_aio
+	    && srv_linux_aio_method == SRV_LINUX_AIO_IO_URING) {
+		ib::warn() << "InnoDB was built without liburing;"
+			" falling back to innodb_linux_aio=aio";
+	}
+#endif
 #if LINUX_NATIVE_AIO
 	if (srv_use_native_aio && !is_linux_native_aio_supported())
 		srv_use_native_aio = false;
 #endif
-	ret = srv_thread_pool->configure_aio(srv_use_native_aio, max_events);
+	ret = srv_thread_pool->configure_aio(
+		srv_use_native_aio, max_events,
+		tpool::aio_implementation::OS_IO_LIBAIO);
+#ifdef LINUX_NATIVE_AIO
+	if (!ret && srv_use_native_aio) {
+		ib::info() << "Using Linux native AIO";
+	}
+#endif
 	if(ret) {
 		ut_a(srv_use_native_aio);
 		srv_use_native_aio = false;
-#ifdef LINUX_NATIVE_AIO
-		ib::info() << "Linux native AIO disabled";
-#endif
+		ib::warn() << "Native AIO could not be initialized;"
+			" falling back to simulated AIO";
 		ret = srv_thread_pool->configure_aio(srv_use_native_aio, max_events);
 		DBUG_ASSERT(!ret);
 	}
+#ifdef HAVE_URING
+created:
+#endif
 	read_slots = new io_slots(max_read_events, (uint)n_reader_threads);
 	write_slots = new io_slots(max_write_events, (uint)n_writer_threads);
 	return true;
@@ -176,6 +176,38 @@ inline void ReadViewBase::snapshot(trx_t *trx)
   std::sort(m_ids.begin(), m_ids.end());
   m_up_limit_id= m_ids.empty() ? m_low_limit_id : m_ids.front();
   ut_ad(m_up_limit_id <= m_low_limit_id);
+  m_csn= 0;
+}
+
+
+/**
+  Creates a snapshot where exactly the transactions that have been
+  assigned a commit sequence number are seen in the view.
+
+  Unlike snapshot(), this does not iterate trx_sys.rw_trx_hash.
+  The purge coordinator publishes trx_sys.csn.up_limit_id() after the
+  commit sequence numbers of all transactions below it were assigned,
+  so it must be read before trx_sys.csn.snapshot(). Transaction
+  identifiers starting from trx_sys.get_max_trx_id() will be assigned
+  a commit sequence number after the snapshot.
+*/
+inline void ReadViewBase::snapshot_csn()
+{
+  const trx_id_t up_limit_id= trx_sys.csn.up_limit_id();
+  m_csn= trx_sys.csn.snapshot();
+  m_low_limit_id= trx_sys.get_max_trx_id();
+  m_up_limit_id= std::min(up_limit_id, m_low_limit_id);
+  m_low_limit_no= m_up_limit_id;
+  m_ids.clear();
+}
+
+
+bool ReadViewBase::csn_visible(trx_id_t id) const
+{
+  ut_ad(m_csn);
+  ut_ad(id >= m_up_limit_id);
+  ut_ad(id < m_low_limit_id);
+  return trx_sys.csn.visible(id, m_csn);
 }
 
 
@@ -221,7 +253,16 @@ void ReadView::open(trx_t *trx)
   else if (likely(!srv_read_only_mode))
   {
     m_creator_trx_id= trx->id;
-    if (trx_is_autocommit_non_locking(trx) && empty() &&
+    if (trx_sys.csn.enabled())
+    {
+      /* m_mutex ensures that the purge coordinator either sees
+      this view or has already advanced trx_sys.csn.snapshot(). */
+      mutex_enter(&m_mutex);
+      snapshot_csn();
+      m_open.store(true, std::memory_order_relaxed);
+      mutex_exit(&m_mutex);
+    }
+    else if (trx_is_autocommit_non_locking(trx) && empty() &&
         low_limit_id() == trx_sys.get_max_trx_id())
       m_open.store(true, std::memory_order_relaxed);
     else
@@ -242,11 +283,39 @@ void ReadView::open(trx_t *trx)
   in. This function is called by purge thread to determine whether it should
   purge the delete marked record or not.
 */
-void trx_sys_t::clone_oldest_view(ReadViewBase *view) const
+void trx_sys_t::clone_oldest_view(ReadViewBase *view)
 {
+  if (csn.enabled())
+  {
+    /* Any read view that is opened after this will see
+    transactions up to at least oldest_csn. */
+    trx_id_t oldest_csn= csn.snapshot();
+    view->snapshot(nullptr);
+    const trx_id_t up_limit_id= view->up_limit_id();
+    trx_list.for_each([view, &oldest_csn](const trx_t &trx) {
+                        trx.read_view.append_to(view, &oldest_csn);
+                      });
+    csn.purge_update(up_limit_id, oldest_csn);
+    return;
+  }
+
   view->snapshot(nullptr);
   /* Find oldest view. */
   trx_list.for_each([view](const trx_t &trx) {
                       trx.read_view.append_to(view);
 		    });
 }
+
+
+/**
+  Advances the limits of csn to the oldest open read view, so that
+  its slots can be reused without waiting for purge.
+
+  Called by the master task once per second.
+*/
+void trx_sys_t::update_csn_limits()
+{
+  ut_ad(csn.enabled());
+  ReadViewBase view;
+  clone_oldest_view(&view);
+}
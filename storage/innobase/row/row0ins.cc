@@ -36,9 +36,11 @@ Created 4/20/1996 Heikki Tuuri
 #include "row0upd.h"
 #include "row0sel.h"
 #include "row0log.h"
+#include "row0merge.h"
 #include "rem0cmp.h"
 #include "lock0lock.h"
 #include "log0log.h"
+#include "log0crypt.h"
 #include "eval0eval.h"
 #include "data0data.h"
 #include "buf0lru.h"
@@ -3461,6 +3463,51 @@ row_ins_index_entry_set_vals(
 	return(DB_SUCCESS);
 }
 
+/** Buffer the index entry of node->index for row_ins_bulk_end().
+@param[in,out]	node	insert node
+@param[in,out]	trx	transaction
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_ins_bulk_add(
+	ins_node_t*	node,
+	trx_t*		trx)
+{
+	dict_index_t*		index = node->index;
+	dtuple_t*		entry = *node->entry;
+	row_merge_bulk_t*	bulk = node->bulk;
+
+	if (dict_index_is_clust(index)) {
+		/* All the records point to the TRX_UNDO_EMPTY record,
+		which carries the insert flag. */
+		dfield_t* r = dtuple_get_nth_field(
+			entry, index->db_roll_ptr());
+		ut_ad(r->len == DATA_ROLL_PTR_LEN);
+		trx_write_roll_ptr(static_cast<byte*>(r->data),
+				   bulk->roll_ptr);
+
+		if (unsigned ai = index->table->persistent_autoinc) {
+			const dfield_t* dfield = dtuple_get_nth_field(
+				entry, ai - 1);
+			if (!dfield_is_null(dfield)) {
+				bulk->autoinc = std::max(
+					bulk->autoinc,
+					row_parse_int(
+						static_cast<const byte*>(
+							dfield->data),
+						dfield->len,
+						dfield->type.mtype,
+						dfield->type.prtype
+						& DATA_UNSIGNED));
+			}
+		}
+	}
+
+	return(row_merge_bulk_add(
+		       bulk, ulint(node->entry - node->entry_list.begin()),
+		       entry, trx));
+}
+
 /***********************************************************//**
 Inserts a single index entry to the table.
 @return DB_SUCCESS if operation successfully completed, else error
@@ -3487,7 +3534,11 @@ row_ins_index_entry_step(
 
 	ut_ad(dtuple_check_typed(*node->entry));
 
-	err = row_ins_index_entry(node->index, *node->entry, thr);
+	if (node->bulk) {
+		err = row_ins_bulk_add(node, thr_get_trx(thr));
+	} else {
+		err = row_ins_index_entry(node->index, *node->entry, thr);
+	}
 
 	DEBUG_SYNC_C_IF_THD(thr_get_trx(thr)->mysql_thd,
 			    "after_row_ins_index_entry_step");
@@ -3785,3 +3836,161 @@ row_ins_step(
 
 	return(thr);
 }
+
+/** Check if an index tree is empty.
+@param[in,out]	index	index tree
+@param[in]	prepare	whether to reinitialize an empty root page
+			for PageBulk::init()
+@return whether the index tree is empty */
+static
+bool
+row_ins_index_is_empty(
+	dict_index_t*	index,
+	bool		prepare)
+{
+	mtr_t	mtr;
+
+	mtr.start();
+
+	if (prepare) {
+		index->set_modified(mtr);
+		mtr_x_lock_index(index, &mtr);
+	}
+
+	buf_block_t*	root = btr_root_block_get(
+		index, prepare ? RW_X_LATCH : RW_S_LATCH, &mtr);
+	const bool	empty = root && page_is_leaf(root->frame)
+		&& !page_get_n_recs(root->frame);
+
+	if (empty && prepare
+	    && page_dir_get_n_heap(root->frame) != PAGE_HEAP_NO_USER_LOW) {
+		/* Discard the garbage of purged records. */
+		btr_page_empty(root, buf_block_get_page_zip(root), index, 0,
+			       &mtr);
+	}
+
+	mtr.commit();
+
+	return(empty);
+}
+
+/** Start buffering the inserts of the current statement into an empty
+table, so that row_ins_bulk_end() can build the indexes with BtrBulk.
+This is only possible if the table is empty and the transaction can
+lock it exclusively without waiting. A single TRX_UNDO_EMPTY undo log
+record is written, which will empty the table on rollback.
+@param[in,out]	node		insert node
+@param[in]	thr		query thread
+@param[in]	mysql_table	MySQL table, for reporting duplicates
+@return whether the inserts will be buffered */
+bool
+row_ins_bulk_start(
+	ins_node_t*	node,
+	que_thr_t*	thr,
+	TABLE*		mysql_table)
+{
+	dict_table_t*	table = node->table;
+	trx_t*		trx = thr_get_trx(thr);
+	dict_index_t*	clust = dict_table_get_first_index(table);
+
+	ut_ad(!node->bulk);
+
+	/* The buffered records are not checked against FOREIGN KEY
+	constraints, and the BLOB file and the merge files are not
+	encrypted. */
+	if (srv_read_only_mode || table->is_temporary()
+	    || table->no_rollback() || table->skip_alter_undo
+	    || table->versioned() || table->is_instant()
+	    || dict_table_has_fts_index(table)
+	    || (trx->check_foreigns && !table->foreign_set.empty())
+	    || trx->duplicates || trx->is_wsrep()
+	    || log_tmp_is_encrypted()) {
+		return(false);
+	}
+
+	for (dict_index_t* index = clust; index != NULL;
+	     index = dict_table_get_next_index(index)) {
+		if (index->is_corrupted() || dict_index_is_spatial(index)
+		    || dict_index_is_online_ddl(index)
+		    || !row_ins_index_is_empty(index, false)) {
+			return(false);
+		}
+	}
+
+	if (!lock_table_x_try(table, trx)) {
+		return(false);
+	}
+
+	/* Now that no other transaction can modify the table, check
+	again that it is empty. */
+	for (dict_index_t* index = clust; index != NULL;
+	     index = dict_table_get_next_index(index)) {
+		if (!row_ins_index_is_empty(index, true)) {
+			return(false);
+		}
+	}
+
+	roll_ptr_t	roll_ptr;
+	const undo_no_t	undo_no = trx->undo_no;
+
+	if (trx_undo_report_row_operation(thr, clust, NULL, NULL, 0, NULL,
+					  NULL, &roll_ptr) != DB_SUCCESS) {
+		return(false);
+	}
+
+	node->bulk = row_merge_bulk_create(table, mysql_table, roll_ptr,
+					   undo_no);
+
+	return(true);
+}
+
+/** Build the indexes from the inserts buffered since row_ins_bulk_start(),
+and stop buffering. On failure, the table is emptied again.
+@param[in,out]	node	insert node
+@param[in,out]	trx	transaction
+@return DB_SUCCESS or error code */
+dberr_t
+row_ins_bulk_end(
+	ins_node_t*	node,
+	trx_t*		trx)
+{
+	ut_ad(node->bulk);
+
+	trx->op_info = "building indexes";
+
+	dberr_t	err = row_merge_bulk_apply(node->bulk, trx);
+
+	if (err != DB_SUCCESS) {
+		/* The indexes before the failing one have already been
+		built. The rollback of the statement would not empty them,
+		because the statement savepoint follows the TRX_UNDO_EMPTY
+		record (see row_insert_for_mysql()). Roll back that record,
+		so that no index keeps any of the inserted rows. */
+		trx_savept_t	savept = { node->bulk->undo_no };
+		trx->rollback(&savept);
+	}
+
+	trx->op_info = "";
+
+	row_ins_bulk_discard(node);
+
+	return(err);
+}
+
+/** Discard the inserts buffered since row_ins_bulk_start(), when the
+statement is going to be rolled back.
+@param[in,out]	node	insert node */
+void
+row_ins_bulk_discard(
+	ins_node_t*	node)
+{
+	if (node->bulk) {
+		row_merge_bulk_free(node->bulk);
+		node->bulk = NULL;
+	}
+}
+
+ins_node_t::~ins_node_t()
+{
+	row_ins_bulk_discard(this);
+}
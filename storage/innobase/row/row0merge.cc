@@ -257,7 +257,8 @@ class index_tuple_info_t {
 
 /** Insert sorted data tuples to the index.
 @param[in]	index		index to be inserted
-@param[in]	old_table	old table
+@param[in]	old_table	old table, or NULL when inserting the records
+buffered by row_merge_bulk_add()
 @param[in]	fd		file descriptor
 @param[in,out]	block		file buffer
 @param[in]	row_buf		row_buf the sorted data tuples,
@@ -266,6 +267,8 @@ or NULL if fd, block will be used instead
 @param[in,out]	stage		performance schema accounting object, used by
 ALTER TABLE. If not NULL stage->begin_phase_insert() will be called initially
 and then stage->inc() will be called for each record that is processed.
+@param[in]	blob_file	off-page columns written by
+row_merge_bulk_add(), if old_table is NULL
 @return DB_SUCCESS or error number */
 static	MY_ATTRIBUTE((warn_unused_result))
 dberr_t
@@ -279,11 +282,12 @@ row_merge_insert_index_tuples(
 	const ib_uint64_t	table_total_rows, /*!< in: total rows of old table */
 	const double		pct_progress,	/*!< in: total progress
 						percent until now */
-	const double		pct_cost, /*!< in: current progress percent
-					  */
+	const double		pct_cost, /*!< in: current progress percent,
+					  or 0 to not report progress */
 	row_merge_block_t*	crypt_block, /*!< in: crypt buf or NULL */
 	ulint			space,	   /*!< in: space id */
-	ut_stage_alter_t*	stage = NULL);
+	ut_stage_alter_t*	stage = NULL,
+	const merge_file_t*	blob_file = NULL);
 
 /******************************************************//**
 Encode an index record. */
@@ -1514,6 +1518,325 @@ row_merge_file_create_if_needed(
 	return(file->fd != OS_FILE_CLOSED);
 }
 
+/** Kind of work done by a row_merge_worker_t */
+enum row_merge_job_t
+{
+	/** sort a buffer and write it as a run of the merge file */
+	ROW_MERGE_JOB_SPILL,
+	/** merge pairs of runs of the merge file */
+	ROW_MERGE_JOB_MERGE,
+	/** sort the merge file of an index and build the index */
+	ROW_MERGE_JOB_BUILD
+};
+
+/** A thread that helps row_merge_build_indexes(), with its own buffers.
+@see innodb_ddl_threads */
+struct row_merge_worker_t
+{
+	/** the task that runs the job */
+	tpool::waitable_task*	task;
+	/** whether the task was submitted and not waited for */
+	bool			busy;
+	/** 3 buffers of srv_sort_buf_size */
+	row_merge_block_t*	block;
+	/** allocation of block */
+	ut_new_pfx_t		block_pfx;
+	/** encryption buffers like block, or NULL */
+	row_merge_block_t*	crypt_block;
+	/** allocation of crypt_block */
+	ut_new_pfx_t		crypt_pfx;
+	/** location for temporary files */
+	const char*		path;
+	/** temporary file for ROW_MERGE_JOB_BUILD */
+	pfs_os_file_t		tmpfd;
+	/** the job */
+	row_merge_job_t		job;
+	/** outcome of the job */
+	dberr_t			err;
+
+	/** transaction of the ALTER TABLE */
+	trx_t*			trx;
+	/** tablespace ID for encryption */
+	ulint			space;
+	/** ROW_MERGE_JOB_SPILL: the sort buffer to write and free */
+	row_merge_buf_t*	buf;
+	/** ROW_MERGE_JOB_SPILL, ROW_MERGE_JOB_MERGE: the output */
+	merge_file_t		of;
+	/** ROW_MERGE_JOB_MERGE, ROW_MERGE_JOB_BUILD: the index */
+	row_merge_dup_t		dup;
+	/** ROW_MERGE_JOB_MERGE: the input;
+	ROW_MERGE_JOB_BUILD: the file to sort */
+	merge_file_t*		file;
+	/** ROW_MERGE_JOB_MERGE: first blocks of the input runs */
+	const ulint*		in_offset;
+	/** ROW_MERGE_JOB_MERGE: first blocks of the output runs */
+	ulint*			run_offset;
+	/** ROW_MERGE_JOB_MERGE: number of input runs */
+	ulint			n_run;
+	/** ROW_MERGE_JOB_MERGE: first output run to produce */
+	ulint			first;
+	/** ROW_MERGE_JOB_MERGE: end of the output runs to produce */
+	ulint			last;
+	/** ROW_MERGE_JOB_BUILD: the table that is being rebuilt */
+	const dict_table_t*	old_table;
+};
+
+/** Threads that help row_merge_build_indexes() */
+struct row_merge_workers_t
+{
+	/** number of elements in worker[] */
+	ulint			n;
+	/** the workers */
+	row_merge_worker_t*	worker;
+	/** the worker for the next row_merge_spill() */
+	ulint			next;
+};
+
+static
+dberr_t
+row_merge_runs(
+	trx_t*			trx,
+	const row_merge_dup_t*	dup,
+	const merge_file_t*	file,
+	row_merge_block_t*	block,
+	row_merge_block_t*	crypt_block,
+	ulint			space,
+	const ulint*		in_offset,
+	ulint			n_run,
+	ulint			first,
+	ulint			last,
+	merge_file_t*		of,
+	ulint*			run_offset,
+	ut_stage_alter_t*	stage);
+
+static
+dberr_t
+row_merge_build_index(
+	row_merge_worker_t*	w);
+
+/** Run the job of a worker.
+@param[in,out]	arg	row_merge_worker_t */
+static
+void
+row_merge_worker_run(
+	void*	arg)
+{
+	row_merge_worker_t*	w = static_cast<row_merge_worker_t*>(arg);
+
+	switch (w->job) {
+	case ROW_MERGE_JOB_SPILL:
+		row_merge_buf_sort(w->buf, NULL);
+		row_merge_buf_write(w->buf, &w->of, w->block);
+
+		if (!row_merge_write(w->of.fd, w->of.offset, w->block,
+				     w->crypt_block, w->space)) {
+			w->err = DB_TEMP_FILE_WRITE_FAIL;
+		}
+
+		row_merge_buf_free(w->buf);
+		w->buf = NULL;
+		return;
+	case ROW_MERGE_JOB_MERGE:
+		w->err = row_merge_runs(w->trx, &w->dup, w->file, w->block,
+					w->crypt_block, w->space,
+					w->in_offset, w->n_run,
+					w->first, w->last, &w->of,
+					w->run_offset, NULL);
+		return;
+	case ROW_MERGE_JOB_BUILD:
+		w->err = row_merge_build_index(w);
+		return;
+	}
+
+	ut_error;
+}
+
+/** Submit the job of a worker.
+@param[in,out]	w	idle worker
+@param[in]	job	the job, whose parameters have been set in w */
+static
+void
+row_merge_worker_submit(
+	row_merge_worker_t*	w,
+	row_merge_job_t		job)
+{
+	ut_ad(!w->busy);
+	w->job = job;
+	w->err = DB_SUCCESS;
+	w->busy = true;
+	srv_thread_pool->submit_task(w->task);
+}
+
+/** Wait for a worker to complete its job.
+@param[in,out]	w	worker
+@return the outcome of the job */
+static
+dberr_t
+row_merge_worker_wait(
+	row_merge_worker_t*	w)
+{
+	if (w->busy) {
+		w->task->wait();
+		w->busy = false;
+	}
+
+	return(w->err);
+}
+
+/** Wait for all workers to complete their jobs.
+@param[in,out]	workers	worker threads
+@return the outcome of the first failed job, or DB_SUCCESS */
+static
+dberr_t
+row_merge_workers_wait(
+	row_merge_workers_t*	workers)
+{
+	dberr_t	err = DB_SUCCESS;
+
+	for (ulint i = 0; i < workers->n; i++) {
+		dberr_t	e = row_merge_worker_wait(&workers->worker[i]);
+
+		if (err == DB_SUCCESS) {
+			err = e;
+		}
+	}
+
+	return(err);
+}
+
+/** Free the worker threads.
+@param[in,out]	workers	worker threads, none of which are busy */
+static
+void
+row_merge_workers_free(
+	row_merge_workers_t*	workers)
+{
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+
+	for (ulint i = 0; i < workers->n; i++) {
+		row_merge_worker_t*	w = &workers->worker[i];
+
+		ut_ad(!w->busy);
+		ut_ad(!w->buf);
+
+		delete w->task;
+		row_merge_file_destroy_low(w->tmpfd);
+
+		if (w->block) {
+			alloc.deallocate_large(w->block, &w->block_pfx);
+		}
+
+		if (w->crypt_block) {
+			alloc.deallocate_large(w->crypt_block, &w->crypt_pfx);
+		}
+	}
+
+	ut_free(workers->worker);
+	ut_free(workers);
+}
+
+/** Create the worker threads of row_merge_build_indexes().
+@param[in]	n	number of threads to create, besides the caller
+@param[in,out]	trx	transaction of the ALTER TABLE
+@param[in]	space	tablespace ID for encryption
+@param[in]	path	location for creating temporary files
+@return the worker threads
+@retval NULL if out of memory */
+static
+row_merge_workers_t*
+row_merge_workers_create(
+	ulint		n,
+	trx_t*		trx,
+	ulint		space,
+	const char*	path)
+{
+	ut_ad(n > 0);
+
+	row_merge_workers_t*	workers = static_cast<row_merge_workers_t*>(
+		ut_malloc_nokey(sizeof *workers));
+
+	if (!workers) {
+		return(NULL);
+	}
+
+	workers->n = n;
+	workers->next = 0;
+	workers->worker = static_cast<row_merge_worker_t*>(
+		ut_zalloc_nokey(n * sizeof *workers->worker));
+
+	if (!workers->worker) {
+		ut_free(workers);
+		return(NULL);
+	}
+
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	const bool			encrypted = log_tmp_is_encrypted();
+
+	for (ulint i = 0; i < n; i++) {
+		row_merge_worker_t*	w = &workers->worker[i];
+
+		w->tmpfd = OS_FILE_CLOSED;
+		w->trx = trx;
+		w->space = space;
+		w->path = path;
+		w->task = new tpool::waitable_task(row_merge_worker_run, w);
+		w->block = alloc.allocate_large(3 * srv_sort_buf_size,
+						&w->block_pfx);
+
+		if (!w->block
+		    || (encrypted
+			&& !(w->crypt_block = alloc.allocate_large(
+				     3 * srv_sort_buf_size,
+				     &w->crypt_pfx)))) {
+			workers->n = i + 1;
+			row_merge_workers_free(workers);
+			return(NULL);
+		}
+	}
+
+	return(workers);
+}
+
+/** Hand over a full sort buffer of a non-unique index to a worker thread,
+which will sort it and write it as a new run at the end of the merge file.
+@param[in,out]	workers	worker threads
+@param[in]	buf	sort buffer, to be freed by the worker
+@param[in,out]	file	merge file
+@param[out]	spare	an empty sort buffer to continue with
+@return the outcome of the previous job of the worker */
+static
+dberr_t
+row_merge_spill(
+	row_merge_workers_t*	workers,
+	row_merge_buf_t*	buf,
+	merge_file_t*		file,
+	row_merge_buf_t**	spare)
+{
+	ut_ad(buf->n_tuples);
+	ut_ad(!dict_index_is_unique(buf->index));
+	ut_ad(!(buf->index->type & DICT_FTS));
+	ut_ad(file->fd != OS_FILE_CLOSED);
+
+	row_merge_worker_t*	w = &workers->worker[workers->next];
+
+	workers->next = (workers->next + 1) % workers->n;
+
+	dberr_t	err = row_merge_worker_wait(w);
+
+	if (err != DB_SUCCESS) {
+		return(err);
+	}
+
+	w->buf = buf;
+	w->of.fd = file->fd;
+	w->of.offset = file->offset++;
+	w->of.n_rec = 0;
+	row_merge_worker_submit(w, ROW_MERGE_JOB_SPILL);
+
+	*spare = row_merge_buf_create(buf->index);
+	return(DB_SUCCESS);
+}
+
 /** Copy the merge data tuple from another merge data tuple.
 @param[in]	mtuple		source merge data tuple
 @param[in,out]	prev_mtuple	destination merge data tuple
@@ -1619,6 +1942,10 @@ row_geo_field_is_valid(
 
 /** Reads clustered index of the table and create temporary files
 containing the index entries for the indexes to be built.
+The clustered index is scanned by the calling thread only: the cursor,
+the online log and the TABLE used for virtual columns and for reporting
+are not shared. The workers only take over the sorting and writing of
+full buffers of non-unique indexes.
 @param[in]	trx		transaction
 @param[in,out]	table		MySQL table object, for reporting erroneous
 				records
@@ -1652,6 +1979,8 @@ stage->inc() will be called for each page read.
 @param[in]	eval_table	mysql table used to evaluate virtual column
 				value, see innobase_get_computed_value().
 @param[in]	allow_not_null	allow null to not-null conversion
+@param[in,out]	workers		threads for sorting the buffers of
+non-unique indexes, or NULL
 @return DB_SUCCESS or error */
 static MY_ATTRIBUTE((warn_unused_result))
 dberr_t
@@ -1679,7 +2008,8 @@ row_merge_read_clustered_index(
 	double 			pct_cost,
 	row_merge_block_t*	crypt_block,
 	struct TABLE*		eval_table,
-	bool			allow_not_null)
+	bool			allow_not_null,
+	row_merge_workers_t*	workers)
 {
 	dict_index_t*		clust_index;	/* Clustered index */
 	mem_heap_t*		row_heap = NULL;/* Heap memory to create
@@ -2306,6 +2636,7 @@ row_merge_read_clustered_index(
 		for (ulint k = 0, i = 0; i < n_index; i++, skip_sort = false) {
 			row_merge_buf_t*	buf	= merge_buf[i];
 			ulint			rows_added = 0;
+			bool			spilled = false;
 
 			if (dict_index_is_spatial(buf->index)) {
 				if (!row) {
@@ -2547,6 +2878,33 @@ row_merge_read_clustered_index(
 							= key_numbers[i];
 						break;
 					}
+				} else if (workers
+					   && !(buf->index->type & DICT_FTS)
+					   && (row != NULL
+					       || file->fd != OS_FILE_CLOSED
+					       || clust_temp_file)) {
+					/* Let a worker thread sort the
+					buffer and write it to the file,
+					while we continue the scan. */
+					if (!row_merge_file_create_if_needed(
+						file, tmpfd,
+						buf->n_tuples, path)) {
+						err = DB_OUT_OF_MEMORY;
+						trx->error_key_num = i;
+						break;
+					}
+
+					err = row_merge_spill(
+						workers, buf, file,
+						&merge_buf[i]);
+
+					if (err != DB_SUCCESS) {
+						trx->error_key_num = i;
+						break;
+					}
+
+					buf = merge_buf[i];
+					spilled = true;
 				} else {
 					row_merge_buf_sort(buf, NULL);
 				}
@@ -2578,7 +2936,10 @@ row_merge_read_clustered_index(
 			/* Secondary index and clustered index which is
 			not in sorted order can use the temporary file.
 			Fulltext index should not use the temporary file. */
-			if (!skip_sort && !(buf->index->type & DICT_FTS)) {
+			if (spilled) {
+				/* buf is the empty spare buffer */
+			} else if (!skip_sort
+				   && !(buf->index->type & DICT_FTS)) {
 				/* In case we can have all rows in sort buffer,
 				we can insert directly into the index without
 				temporary file if clustered index does not uses
@@ -2784,6 +3145,16 @@ row_merge_read_clustered_index(
 #ifdef FTS_INTERNAL_DIAG_PRINT
 	DEBUG_FTS_SORT_PRINT("FTS_SORT: Complete Tokenization\n");
 #endif
+	if (workers) {
+		/* Wait for the buffers that were handed over by
+		row_merge_spill() to be written. */
+		dberr_t	spill_err = row_merge_workers_wait(workers);
+
+		if (err == DB_SUCCESS) {
+			err = spill_err;
+		}
+	}
+
 	for (ulint i = 0; i < n_index; i++) {
 		row_merge_buf_free(merge_buf[i]);
 	}
@@ -3086,6 +3457,81 @@ row_merge_blocks_copy(
 		    != NULL);
 }
 
+/** Merge pairs of runs of a merge file, or copy the last run.
+Output run j is the merge of input runs j and n_run / 2 + j, or a copy
+of input run n_run - 1 if j == n_run / 2.
+@param[in]	trx		transaction
+@param[in]	dup		descriptor of index being created
+@param[in]	file		input file
+@param[in,out]	block		3 buffers
+@param[in,out]	crypt_block	encryption buffer
+@param[in]	space		tablespace ID for encryption
+@param[in]	in_offset	first block of each input run, and the
+end of the input file
+@param[in]	n_run		number of input runs
+@param[in]	first		first output run to produce
+@param[in]	last		end of the output runs to produce
+@param[in,out]	of		output file; of->offset is where to write
+@param[out]	run_offset	first block of each output run
+@param[in,out]	stage		performance schema accounting object, or NULL
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_merge_runs(
+	trx_t*			trx,
+	const row_merge_dup_t*	dup,
+	const merge_file_t*	file,
+	row_merge_block_t*	block,
+	row_merge_block_t*	crypt_block,
+	ulint			space,
+	const ulint*		in_offset,
+	ulint			n_run,
+	ulint			first,
+	ulint			last,
+	merge_file_t*		of,
+	ulint*			run_offset,
+	ut_stage_alter_t*	stage)
+{
+	const ulint	n_half = n_run / 2;
+
+	for (ulint j = first; j < last; j++) {
+		if (trx_is_interrupted(trx)) {
+			return(DB_INTERRUPTED);
+		}
+
+		/* Remember the offset number for this run */
+		run_offset[j] = of->offset;
+
+		ulint	foffs0 = in_offset[j];
+
+		if (j < n_half) {
+			ulint	foffs1 = in_offset[n_half + j];
+
+			dberr_t	error = row_merge_blocks(
+				dup, file, block, &foffs0, &foffs1, of,
+				stage, crypt_block, space);
+
+			if (error != DB_SUCCESS) {
+				return(error);
+			}
+		} else {
+			/* Copy the last run. */
+			ut_ad(j == n_half);
+			ut_ad(n_run & 1);
+
+			foffs0 = in_offset[n_run - 1];
+
+			if (!row_merge_blocks_copy(dup->index, file, block,
+						   &foffs0, of, stage,
+						   crypt_block, space)) {
+				return(DB_CORRUPTION);
+			}
+		}
+	}
+
+	return(DB_SUCCESS);
+}
+
 /** Merge disk files.
 @param[in]	trx		transaction
 @param[in]	dup		descriptor of index being created
@@ -3095,11 +3541,13 @@ row_merge_blocks_copy(
 @param[in,out]	num_run		Number of runs that remain to be merged
 @param[in,out]	run_offset	Array that contains the first offset number
 for each merge run
+@param[out]	in_offset	work area of num_run + 1 elements
 @param[in,out]	stage		performance schema accounting object, used by
-@param[in,out]	crypt_block	encryption buffer
-@param[in]	space		tablespace ID for encryption
 ALTER TABLE. If not NULL stage->inc() will be called for each record
 processed.
+@param[in,out]	crypt_block	encryption buffer
+@param[in]	space		tablespace ID for encryption
+@param[in,out]	workers		threads for merging runs, or NULL
 @return DB_SUCCESS or error code */
 static
 dberr_t
@@ -3111,18 +3559,20 @@ row_merge(
 	pfs_os_file_t*		tmpfd,
 	ulint*			num_run,
 	ulint*			run_offset,
+	ulint*			in_offset,
 	ut_stage_alter_t*	stage,
 	row_merge_block_t*	crypt_block,
-	ulint			space)
+	ulint			space,
+	row_merge_workers_t*	workers)
 {
-	ulint		foffs0;	/*!< first input offset */
-	ulint		foffs1;	/*!< second input offset */
 	dberr_t		error;	/*!< error code */
 	merge_file_t	of;	/*!< output file */
-	const ulint	ihalf	= run_offset[*num_run / 2];
-				/*!< half the input file */
-	ulint		n_run	= 0;
-				/*!< num of runs generated from this merge */
+	const ulint	n_run	= *num_run;
+				/*!< number of input runs */
+	const ulint	n_half	= n_run / 2;
+				/*!< number of runs in the first half */
+	const ulint	n_out	= n_run - n_half;
+				/*!< number of output runs */
 
 	MEM_CHECK_ADDRESSABLE(&block[0], 3 * srv_sort_buf_size);
 
@@ -3130,7 +3580,8 @@ row_merge(
 		MEM_CHECK_ADDRESSABLE(&crypt_block[0], 3 * srv_sort_buf_size);
 	}
 
-	ut_ad(ihalf < file->offset);
+	ut_ad(n_half);
+	ut_ad(run_offset[n_half] < file->offset);
 
 	of.fd = *tmpfd;
 	of.offset = 0;
@@ -3144,76 +3595,75 @@ row_merge(
 		      POSIX_FADV_SEQUENTIAL | POSIX_FADV_NOREUSE);
 #endif /* POSIX_FADV_SEQUENTIAL */
 
-	/* Merge blocks to the output file. */
-	foffs0 = 0;
-	foffs1 = ihalf;
+	memcpy(in_offset, run_offset, n_run * sizeof *in_offset);
+	in_offset[n_run] = file->offset;
 
-	MEM_UNDEFINED(run_offset, *num_run * sizeof *run_offset);
+	MEM_UNDEFINED(run_offset, n_run * sizeof *run_offset);
 
-	for (; foffs0 < ihalf && foffs1 < file->offset; foffs0++, foffs1++) {
+	/* Split the output runs between this thread and the workers.
+	An output run takes at most as many blocks as its input runs.
+	Each worker writes its runs starting from the sum of the input
+	sizes of the preceding runs, so that they do not overlap. */
+	const ulint	n_chunk = workers
+		? std::min<ulint>(workers->n + 1, n_out) : 1;
+	ulint		out_end = 0;
+	ulint		j = 0;
 
-		if (trx_is_interrupted(trx)) {
-			return(DB_INTERRUPTED);
-		}
+	for (ulint c = 1; c < n_chunk; c++) {
+		row_merge_worker_t*	w = &workers->worker[c - 1];
+		const ulint		first = c * n_out / n_chunk;
 
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
+		for (; j < first; j++) {
+			out_end += in_offset[j + 1] - in_offset[j];
 
-		error = row_merge_blocks(dup, file, block,
-					 &foffs0, &foffs1, &of, stage,
-					 crypt_block, space);
-
-		if (error != DB_SUCCESS) {
-			return(error);
+			if (j < n_half) {
+				out_end += in_offset[n_half + j + 1]
+					- in_offset[n_half + j];
+			}
 		}
 
+		w->dup = *dup;
+		w->file = file;
+		w->in_offset = in_offset;
+		w->run_offset = run_offset;
+		w->n_run = n_run;
+		w->first = first;
+		w->last = (c + 1) * n_out / n_chunk;
+		w->of.fd = *tmpfd;
+		w->of.offset = out_end;
+		w->of.n_rec = 0;
+		row_merge_worker_submit(w, ROW_MERGE_JOB_MERGE);
 	}
 
-	/* Copy the last blocks, if there are any. */
+	error = row_merge_runs(trx, dup, file, block, crypt_block, space,
+			       in_offset, n_run, 0, n_out / n_chunk,
+			       &of, run_offset, stage);
 
-	while (foffs0 < ihalf) {
+	for (ulint c = 1; c < n_chunk; c++) {
+		row_merge_worker_t*	w = &workers->worker[c - 1];
+		dberr_t			err = row_merge_worker_wait(w);
 
-		if (UNIV_UNLIKELY(trx_is_interrupted(trx))) {
-			return(DB_INTERRUPTED);
+		if (error == DB_SUCCESS) {
+			error = err;
 		}
 
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
+		of.n_rec += w->of.n_rec;
+		of.offset = w->of.offset;
 
-		if (!row_merge_blocks_copy(dup->index, file, block,
-					   &foffs0, &of, stage,
-					   crypt_block, space)) {
-			return(DB_CORRUPTION);
+		if (stage != NULL) {
+			stage->inc(ulint(w->of.n_rec));
 		}
 	}
 
-	ut_ad(foffs0 == ihalf);
-
-	while (foffs1 < file->offset) {
-
-		if (trx_is_interrupted(trx)) {
-			return(DB_INTERRUPTED);
-		}
-
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
-
-		if (!row_merge_blocks_copy(dup->index, file, block,
-					   &foffs1, &of, stage,
-					   crypt_block, space)) {
-			return(DB_CORRUPTION);
-		}
+	if (error != DB_SUCCESS) {
+		return(error);
 	}
 
-	ut_ad(foffs1 == file->offset);
-
 	if (UNIV_UNLIKELY(of.n_rec != file->n_rec)) {
 		return(DB_CORRUPTION);
 	}
 
-	ut_ad(n_run <= *num_run);
-
-	*num_run = n_run;
+	*num_run = n_out;
 
 	/* Each run can contain one or more offsets. As merge goes on,
 	the number of runs (to merge) will reduce until we have one
@@ -3243,6 +3693,7 @@ row_merge(
 @param[in,out]	stage	performance schema accounting object, used by
 ALTER TABLE. If not NULL, stage->begin_phase_sort() will be called initially
 and then stage->inc() will be called for each record processed.
+@param[in,out]	workers	threads for merging runs, or NULL
 @return DB_SUCCESS or error code */
 dberr_t
 row_merge_sort(
@@ -3260,9 +3711,9 @@ row_merge_sort(
 	const double		pct_cost, /*!< in: current progress percent */
 	row_merge_block_t*	crypt_block, /*!< in: crypt buf or NULL */
 	ulint			space,	   /*!< in: space id */
-	ut_stage_alter_t* 	stage)
+	ut_stage_alter_t* 	stage,
+	row_merge_workers_t*	workers)
 {
-	const ulint	half	= file->offset / 2;
 	ulint		num_runs;
 	ulint*		run_offset;
 	dberr_t		error	= DB_SUCCESS;
@@ -3286,12 +3737,17 @@ row_merge_sort(
 
 	total_merge_sort_count = ulint(ceil(log2(double(num_runs))));
 
-	/* "run_offset" records each run's first offset number */
-	run_offset = (ulint*) ut_malloc_nokey(file->offset * sizeof(ulint));
+	/* "run_offset" records each run's first offset number, followed
+	by a work area for row_merge() */
+	run_offset = (ulint*) ut_malloc_nokey((2 * num_runs + 1)
+					      * sizeof(ulint));
 
-	/* This tells row_merge() where to start for the first round
-	of merge. */
-	run_offset[half] = half;
+	ulint*	in_offset = run_offset + num_runs;
+
+	/* Initially, each block is a run. */
+	for (ulint i = 0; i < num_runs; i++) {
+		run_offset[i] = i;
+	}
 
 	/* The file should always contain at least one byte (the end
 	of file marker).  Thus, it must be at least one block. */
@@ -3302,8 +3758,8 @@ row_merge_sort(
 	sol10-64 in buildbot.
 	*/
 #ifndef UNIV_SOLARIS
-	/* Progress report only for "normal" indexes. */
-	if (!(dup->index->type & DICT_FTS)) {
+	/* Progress report only for "normal" indexes of ALTER TABLE. */
+	if (update_progress && !(dup->index->type & DICT_FTS)) {
 		thd_progress_init(trx->mysql_thd, 1);
 	}
 #endif /* UNIV_SOLARIS */
@@ -3320,14 +3776,14 @@ row_merge_sort(
 		show processlist progress field */
 		/* Progress report only for "normal" indexes. */
 #ifndef UNIV_SOLARIS
-		if (!(dup->index->type & DICT_FTS)) {
+		if (update_progress && !(dup->index->type & DICT_FTS)) {
 			thd_progress_report(trx->mysql_thd, file->offset - num_runs, file->offset);
 		}
 #endif /* UNIV_SOLARIS */
 
 		error = row_merge(trx, dup, file, block, tmpfd,
-				  &num_runs, run_offset, stage,
-				  crypt_block, space);
+				  &num_runs, run_offset, in_offset, stage,
+				  crypt_block, space, workers);
 
 		if(update_progress) {
 			merge_count++;
@@ -3350,7 +3806,7 @@ row_merge_sort(
 
 	/* Progress report only for "normal" indexes. */
 #ifndef UNIV_SOLARIS
-	if (!(dup->index->type & DICT_FTS)) {
+	if (update_progress && !(dup->index->type & DICT_FTS)) {
 		thd_progress_end(trx->mysql_thd);
 	}
 #endif /* UNIV_SOLARIS */
@@ -3424,6 +3880,51 @@ row_merge_copy_blobs(
 	}
 }
 
+/** Copy the off-page columns that row_merge_bulk_add() wrote to a file
+to the data tuple. Instead of a BLOB pointer, the last bytes of such a
+column hold the offset and the length of the data in the file.
+@param[in]	blob_file	file written by row_merge_bulk_add()
+@param[in,out]	tuple		data tuple
+@param[in,out]	heap		memory heap
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_merge_bulk_read_blobs(
+	const merge_file_t&	blob_file,
+	dtuple_t*		tuple,
+	mem_heap_t*		heap)
+{
+	for (ulint i = 0; i < dtuple_get_n_fields(tuple); i++) {
+		dfield_t*	field = dtuple_get_nth_field(tuple, i);
+
+		if (!dfield_is_ext(field)) {
+			continue;
+		}
+
+		const byte*	data = static_cast<const byte*>(
+			dfield_get_data(field));
+		const ulint	local_len = dfield_get_len(field)
+			- BTR_EXTERN_FIELD_REF_SIZE;
+		const os_offset_t offset = mach_read_from_8(data + local_len);
+		const ulint	len = ulint(mach_read_from_8(
+					data + local_len + 8));
+		byte*		buf = static_cast<byte*>(
+			mem_heap_alloc(heap, local_len + len));
+
+		memcpy(buf, data, local_len);
+
+		if (os_file_read_no_error_handling(
+			    IORequestRead, blob_file.fd, buf + local_len,
+			    offset, len, 0) != DB_SUCCESS) {
+			return(DB_CORRUPTION);
+		}
+
+		dfield_set_data(field, buf, local_len + len);
+	}
+
+	return(DB_SUCCESS);
+}
+
 /** Convert a merge record to a typed data tuple. Note that externally
 stored fields are not copied to heap.
 @param[in,out]	index	index on the table
@@ -3445,7 +3946,8 @@ row_merge_mtuple_to_dtuple(
 
 /** Insert sorted data tuples to the index.
 @param[in]	index		index to be inserted
-@param[in]	old_table	old table
+@param[in]	old_table	old table, or NULL when inserting the records
+buffered by row_merge_bulk_add()
 @param[in]	fd		file descriptor
 @param[in,out]	block		file buffer
 @param[in]	row_buf		row_buf the sorted data tuples,
@@ -3454,6 +3956,8 @@ or NULL if fd, block will be used instead
 @param[in,out]	stage		performance schema accounting object, used by
 ALTER TABLE. If not NULL stage->begin_phase_insert() will be called initially
 and then stage->inc() will be called for each record that is processed.
+@param[in]	blob_file	off-page columns written by
+row_merge_bulk_add(), if old_table is NULL
 @return DB_SUCCESS or error number */
 static	MY_ATTRIBUTE((warn_unused_result))
 dberr_t
@@ -3467,11 +3971,12 @@ row_merge_insert_index_tuples(
 	const ib_uint64_t	table_total_rows, /*!< in: total rows of old table */
 	const double		pct_progress,	/*!< in: total progress
 						percent until now */
-	const double		pct_cost, /*!< in: current progress percent
-					  */
+	const double		pct_cost, /*!< in: current progress percent,
+					  or 0 to not report progress */
 	row_merge_block_t*	crypt_block, /*!< in: crypt buf or NULL */
 	ulint			space,	   /*!< in: space id */
-	ut_stage_alter_t*	stage)
+	ut_stage_alter_t*	stage,
+	const merge_file_t*	blob_file)
 {
 	const byte*		b;
 	mem_heap_t*		heap;
@@ -3572,9 +4077,10 @@ row_merge_insert_index_tuples(
 				mrec, index, offsets, tuple_heap);
 		}
 
-		old_index	= dict_table_get_first_index(old_table);
+		old_index	= old_table
+			? dict_table_get_first_index(old_table) : NULL;
 
-		if (dict_index_is_clust(index)
+		if (dict_index_is_clust(index) && old_index
 		    && dict_index_is_online_ddl(old_index)) {
 			error = row_log_table_get_error(old_index);
 			if (error != DB_SUCCESS) {
@@ -3582,7 +4088,14 @@ row_merge_insert_index_tuples(
 			}
 		}
 
-		if (dict_index_is_clust(index) && dtuple_get_n_ext(dtuple)) {
+		if (!dict_index_is_clust(index) || !dtuple_get_n_ext(dtuple)) {
+		} else if (!old_table) {
+			error = row_merge_bulk_read_blobs(
+				*blob_file, dtuple, tuple_heap);
+			if (error != DB_SUCCESS) {
+				break;
+			}
+		} else {
 			/* Off-page columns can be fetched safely
 			when concurrent modifications to the table
 			are disabled. (Purge can process delete-marked
@@ -3627,7 +4140,7 @@ row_merge_insert_index_tuples(
 
 		/* Increment innodb_onlineddl_pct_progress status variable */
 		inserted_rows++;
-		if(inserted_rows % 1000 == 0) {
+		if (pct_cost > 0 && inserted_rows % 1000 == 0) {
 			/* Update progress for each 1000 rows */
 			curr_progress = (inserted_rows >= table_total_rows ||
 				table_total_rows <= 0) ?
@@ -4327,6 +4840,39 @@ row_merge_drop_table(
 			trx, SQLCOM_DROP_TABLE, false, false));
 }
 
+/** Sort the merge file of a non-unique secondary index and build the
+index, in a worker thread.
+@param[in,out]	w	worker
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_merge_build_index(
+	row_merge_worker_t*	w)
+{
+	ut_ad(!dict_index_is_unique(w->dup.index));
+
+	if (!row_merge_tmpfile_if_needed(&w->tmpfd, w->path)) {
+		return(DB_OUT_OF_MEMORY);
+	}
+
+	dberr_t	error = row_merge_sort(w->trx, &w->dup, w->file, w->block,
+				       &w->tmpfd, false, 0, 0,
+				       w->crypt_block, w->space);
+
+	if (error == DB_SUCCESS) {
+		BtrBulk	btr_bulk(w->dup.index, w->trx);
+
+		error = row_merge_insert_index_tuples(
+			w->dup.index, w->old_table, w->file->fd, w->block,
+			NULL, &btr_bulk, w->file->n_rec, 0, 0,
+			w->crypt_block, w->space);
+
+		error = btr_bulk.finish(error);
+	}
+
+	return(error);
+}
+
 /** Build indexes on a table by reading a clustered index, creating a temporary
 file containing index entries, merge sorting these index entries and inserting
 sorted index entries to indexes.
@@ -4390,6 +4936,9 @@ row_merge_build_indexes(
 	fts_psort_t*		psort_info = NULL;
 	fts_psort_t*		merge_info = NULL;
 	bool			fts_psort_initiated = false;
+	row_merge_workers_t*	workers = NULL;
+	row_merge_worker_t**	builder = NULL;
+	bool			parallel_build = false;
 
 	double total_static_cost = 0;
 	double total_dynamic_cost = 0;
@@ -4457,6 +5006,13 @@ row_merge_build_indexes(
 		merge_files[i].n_rec = 0;
 	}
 
+	if (ulint n_workers = thd_ddl_threads(trx->mysql_thd) - 1) {
+		/* If this fails, we will proceed on one thread. */
+		workers = row_merge_workers_create(
+			n_workers, trx, new_table->space_id,
+			thd_innodb_tmpdir(trx->mysql_thd));
+	}
+
 	total_static_cost = COST_BUILD_INDEX_STATIC
 		* static_cast<double>(n_indexes) + COST_READ_CLUSTERED_INDEX;
 	total_dynamic_cost = COST_BUILD_INDEX_DYNAMIC
@@ -4524,7 +5080,7 @@ row_merge_build_indexes(
 		fts_sort_idx, psort_info, merge_files, key_numbers,
 		n_indexes, defaults, add_v, col_map, add_autoinc,
 		sequence, block, skip_pk_sort, &tmpfd, stage,
-		pct_cost, crypt_block, eval_table, allow_not_null);
+		pct_cost, crypt_block, eval_table, allow_not_null, workers);
 
 	stage->end_phase_read_pk();
 
@@ -4546,6 +5102,53 @@ row_merge_build_indexes(
 
 	DEBUG_SYNC_C("row_merge_after_scan");
 
+	if (workers) {
+		/* Let the workers sort and build non-unique secondary
+		indexes, while this thread builds the first one and the
+		remaining indexes. Duplicates are reported via the shared
+		TABLE, so unique indexes are built by this thread only. */
+		builder = static_cast<row_merge_worker_t**>(
+			ut_zalloc_nokey(n_indexes * sizeof *builder));
+		bool	own = false;
+		const char* path = thd_innodb_tmpdir(trx->mysql_thd);
+		ulint	n_busy = 0;
+
+		for (ulint k = 0, i = 0; builder && i < n_indexes; i++) {
+			if (dict_index_is_spatial(indexes[i])) {
+				continue;
+			}
+
+			merge_file_t*	file = &merge_files[k++];
+
+			if (file->fd == OS_FILE_CLOSED
+			    || (indexes[i]->type & DICT_FTS)
+			    || dict_index_is_unique(indexes[i])) {
+				continue;
+			}
+
+			if (!own) {
+				own = true;
+				continue;
+			}
+
+			if (n_busy == workers->n) {
+				break;
+			}
+
+			row_merge_worker_t*	w = &workers->worker[n_busy++];
+			w->dup.index = indexes[i];
+			w->dup.table = table;
+			w->dup.col_map = col_map;
+			w->dup.n_dup = 0;
+			w->file = file;
+			w->old_table = old_table;
+			w->path = path;
+			builder[i] = w;
+			row_merge_worker_submit(w, ROW_MERGE_JOB_BUILD);
+			parallel_build = true;
+		}
+	}
+
 	/* Now we have files containing index entries ready for
 	sorting and inserting. */
 
@@ -4577,6 +5180,18 @@ row_merge_build_indexes(
 #ifdef FTS_INTERNAL_DIAG_PRINT
 			DEBUG_FTS_SORT_PRINT("FTS_SORT: Complete Insert\n");
 #endif
+		} else if (builder && builder[i]) {
+			error = row_merge_worker_wait(builder[i]);
+
+			pct_progress += (COST_BUILD_INDEX_STATIC +
+					 (total_dynamic_cost
+					  * static_cast<double>(
+						  merge_files[k].offset)
+					  / static_cast<double>(
+						  total_index_blocks)))
+				/ (total_static_cost + total_dynamic_cost)
+				* 100;
+			onlineddl_pct_progress = (ulint) (pct_progress * 100);
 		} else if (merge_files[k].fd != OS_FILE_CLOSED) {
 			char	buf[NAME_LEN + 1];
 			row_merge_dup_t	dup = {
@@ -4607,12 +5222,18 @@ row_merge_build_indexes(
 						      pct_cost);
 			}
 
+			/* Duplicates are reported via the shared
+			TABLE::record[0], so unique indexes are
+			merged by this thread only. */
 			error = row_merge_sort(
 					trx, &dup, &merge_files[k],
 					block, &tmpfd, true,
 					pct_progress, pct_cost,
 					crypt_block, new_table->space_id,
-					stage);
+					stage,
+					parallel_build
+					|| dict_index_is_unique(sort_idx)
+					? NULL : workers);
 
 			pct_progress += pct_cost;
 
@@ -4721,6 +5342,13 @@ row_merge_build_indexes(
 		error = DB_TOO_MANY_CONCURRENT_TRXS;
 		trx->error_state = error;);
 
+	if (workers) {
+		/* On error, some index builds may still be running. */
+		row_merge_workers_wait(workers);
+		row_merge_workers_free(workers);
+		ut_free(builder);
+	}
+
 	if (fts_psort_initiated) {
 		/* Clean up FTS psort related resource */
 		row_fts_psort_info_destroy(psort_info, merge_info);
@@ -4787,3 +5415,379 @@ row_merge_build_indexes(
 	DBUG_EXECUTE_IF("ib_index_crash_after_bulk_load", DBUG_SUICIDE(););
 	DBUG_RETURN(error);
 }
+
+/** Add an index entry to a sort buffer.
+@param[in,out]	buf	sort buffer
+@param[in]	entry	index entry
+@return whether the entry fit in the buffer */
+static
+bool
+row_merge_buf_add_entry(
+	row_merge_buf_t*	buf,
+	const dtuple_t*		entry)
+{
+	const ulint	n_fields = dict_index_get_n_fields(buf->index);
+	ulint		extra_size;
+
+	ut_ad(dtuple_get_n_fields(entry) == n_fields);
+
+	if (buf->n_tuples >= buf->max_tuples) {
+		return(false);
+	}
+
+	ulint	size = rec_get_converted_size_temp(
+		buf->index, entry->fields, n_fields, &extra_size);
+
+	/* See row_merge_buf_encode() for the encoding of extra_size. */
+	size += 1 + ((extra_size + 1) >= 0x80);
+
+	ut_ad(size < srv_sort_buf_size);
+
+	/* Reserve bytes for the end marker of row_merge_block_t. */
+	if (buf->total_size + size >= srv_sort_buf_size) {
+		return(false);
+	}
+
+	mtuple_t*	tuple = &buf->tuples[buf->n_tuples++];
+
+	tuple->fields = static_cast<dfield_t*>(
+		mem_heap_dup(buf->heap, entry->fields,
+			     n_fields * sizeof *tuple->fields));
+
+	for (ulint i = 0; i < n_fields; i++) {
+		dfield_dup(&tuple->fields[i], buf->heap);
+	}
+
+	buf->total_size += size;
+
+	return(true);
+}
+
+/** Sort the buffered entries of an index.
+@param[in]	bulk	buffered inserts
+@param[in,out]	buf	sort buffer
+@param[in,out]	trx	transaction
+@return DB_SUCCESS or DB_DUPLICATE_KEY */
+static
+dberr_t
+row_merge_bulk_sort(
+	const row_merge_bulk_t*	bulk,
+	row_merge_buf_t*	buf,
+	trx_t*			trx)
+{
+	if (!dict_index_is_unique(buf->index)) {
+		row_merge_buf_sort(buf, NULL);
+		return(DB_SUCCESS);
+	}
+
+	row_merge_dup_t	dup = { buf->index, bulk->mysql_table, NULL, 0 };
+
+	row_merge_buf_sort(buf, &dup);
+
+	if (dup.n_dup) {
+		trx->error_info = buf->index;
+		return(DB_DUPLICATE_KEY);
+	}
+
+	return(DB_SUCCESS);
+}
+
+/** Write the buffered entries of an index to a sorted run in a file,
+and empty the buffer.
+@param[in,out]	bulk	buffered inserts
+@param[in]	i	position of the index in table->indexes
+@param[in,out]	trx	transaction
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_merge_bulk_spill(
+	row_merge_bulk_t*	bulk,
+	ulint			i,
+	trx_t*			trx)
+{
+	row_merge_buf_t*	buf = bulk->bufs[i];
+	merge_file_t*		file = &bulk->files[i];
+
+	if (!buf->n_tuples) {
+		return(DB_SUCCESS);
+	}
+
+	dberr_t	err = row_merge_bulk_sort(bulk, buf, trx);
+
+	if (err != DB_SUCCESS) {
+		return(err);
+	}
+
+	if (!bulk->block) {
+		ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+
+		bulk->block = alloc.allocate_large(3 * srv_sort_buf_size,
+						   &bulk->block_pfx);
+		if (!bulk->block) {
+			return(DB_OUT_OF_MEMORY);
+		}
+	}
+
+	if (!row_merge_file_create_if_needed(
+		    file, &bulk->tmpfd, 0, thd_innodb_tmpdir(trx->mysql_thd))) {
+		return(DB_OUT_OF_MEMORY);
+	}
+
+	row_merge_buf_write(buf, file, bulk->block);
+
+	if (!row_merge_write(file->fd, file->offset++, bulk->block, NULL,
+			     buf->index->table->space_id)) {
+		return(DB_TEMP_FILE_WRITE_FAIL);
+	}
+
+	MEM_UNDEFINED(&bulk->block[0], srv_sort_buf_size);
+
+	file->n_rec += buf->n_tuples;
+	bulk->bufs[i] = row_merge_buf_empty(buf);
+
+	return(DB_SUCCESS);
+}
+
+/** Write the off-page columns of a clustered index entry to the BLOB
+file. The BLOB pointer of each column is replaced with the offset
+and the length of the data in the file.
+@see row_merge_bulk_read_blobs()
+@param[in,out]	bulk	buffered inserts
+@param[in]	big_rec	off-page columns
+@param[in,out]	entry	clustered index entry
+@param[in]	trx	transaction
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_merge_bulk_write_blobs(
+	row_merge_bulk_t*	bulk,
+	const big_rec_t*	big_rec,
+	dtuple_t*		entry,
+	const trx_t*		trx)
+{
+	merge_file_t*	file = &bulk->blob_file;
+
+	if (file->fd == OS_FILE_CLOSED) {
+		file->fd = row_merge_file_create_low(
+			thd_innodb_tmpdir(trx->mysql_thd));
+
+		if (file->fd == OS_FILE_CLOSED) {
+			return(DB_OUT_OF_MEMORY);
+		}
+
+		MONITOR_ATOMIC_INC(MONITOR_ALTER_TABLE_SORT_FILES);
+	}
+
+	for (ulint i = 0; i < big_rec->n_fields; i++) {
+		const big_rec_field_t&	f = big_rec->fields[i];
+		dfield_t*	field = dtuple_get_nth_field(entry, f.field_no);
+
+		ut_ad(dfield_is_ext(field));
+
+		if (os_file_write(IORequestWrite, "(bulk)", file->fd, f.data,
+				  file->offset, f.len) != DB_SUCCESS) {
+			return(DB_TEMP_FILE_WRITE_FAIL);
+		}
+
+		byte*	ref = static_cast<byte*>(dfield_get_data(field))
+			+ dfield_get_len(field) - BTR_EXTERN_FIELD_REF_SIZE;
+
+		mach_write_to_8(ref, file->offset);
+		mach_write_to_8(ref + 8, f.len);
+		file->offset += f.len;
+		file->n_rec++;
+	}
+
+	return(DB_SUCCESS);
+}
+
+/** Create a buffer for the inserts of a statement into an empty table.
+@param[in]	table		table
+@param[in]	mysql_table	MySQL table, for reporting duplicates
+@param[in]	roll_ptr	DB_ROLL_PTR of the TRX_UNDO_EMPTY record
+@param[in]	undo_no		undo number of the TRX_UNDO_EMPTY record
+@return the buffer */
+row_merge_bulk_t*
+row_merge_bulk_create(
+	dict_table_t*	table,
+	TABLE*		mysql_table,
+	roll_ptr_t	roll_ptr,
+	undo_no_t	undo_no)
+{
+	row_merge_bulk_t*	bulk = UT_NEW_NOKEY(row_merge_bulk_t());
+
+	bulk->mysql_table = mysql_table;
+	bulk->tmpfd = OS_FILE_CLOSED;
+	bulk->blob_file.fd = OS_FILE_CLOSED;
+	bulk->blob_file.offset = 0;
+	bulk->blob_file.n_rec = 0;
+	bulk->block = NULL;
+	bulk->roll_ptr = roll_ptr;
+	bulk->undo_no = undo_no;
+	bulk->autoinc = 0;
+
+	for (dict_index_t* index = dict_table_get_first_index(table);
+	     index != NULL; index = dict_table_get_next_index(index)) {
+		merge_file_t	file;
+
+		file.fd = OS_FILE_CLOSED;
+		file.offset = 0;
+		file.n_rec = 0;
+
+		bulk->bufs.push_back(row_merge_buf_create(index));
+		bulk->files.push_back(file);
+	}
+
+	return(bulk);
+}
+
+/** Buffer an index entry of an inserted row.
+@param[in,out]	bulk	buffered inserts
+@param[in]	i	position of the index in table->indexes
+@param[in,out]	entry	index entry; restored before returning
+@param[in,out]	trx	transaction
+@return DB_SUCCESS or error code */
+dberr_t
+row_merge_bulk_add(
+	row_merge_bulk_t*	bulk,
+	ulint			i,
+	dtuple_t*		entry,
+	trx_t*			trx)
+{
+	dict_index_t*	index = bulk->bufs[i]->index;
+	big_rec_t*	big_rec = NULL;
+	dberr_t		err = DB_SUCCESS;
+
+	ut_ad(!dtuple_get_n_ext(entry));
+
+	if (dict_index_is_clust(index)
+	    && page_zip_rec_needs_ext(rec_get_converted_size(index, entry, 0),
+				      index->table->not_redundant(),
+				      dtuple_get_n_fields(entry),
+				      index->table->space->zip_size())) {
+		/* Move the longest columns to the BLOB file, like
+		btr_cur_pessimistic_insert() would store them
+		off-page, so that the record fits in the sort buffer. */
+		ulint	n_ext = 0;
+
+		big_rec = dtuple_convert_big_rec(index, NULL, entry, &n_ext);
+
+		if (big_rec == NULL) {
+			return(DB_TOO_BIG_RECORD);
+		}
+
+		err = row_merge_bulk_write_blobs(bulk, big_rec, entry, trx);
+	}
+
+	if (err == DB_SUCCESS
+	    && !row_merge_buf_add_entry(bulk->bufs[i], entry)) {
+		err = row_merge_bulk_spill(bulk, i, trx);
+
+		if (err == DB_SUCCESS
+		    && !row_merge_buf_add_entry(bulk->bufs[i], entry)) {
+			/* An empty buffer should have enough
+			room for at least one record. */
+			ut_error;
+		}
+	}
+
+	if (big_rec != NULL) {
+		dtuple_convert_back_big_rec(index, entry, big_rec);
+	}
+
+	return(err);
+}
+
+/** Build the indexes of the table from the buffered inserts.
+@param[in,out]	bulk	buffered inserts
+@param[in,out]	trx	transaction
+@return DB_SUCCESS or error code */
+dberr_t
+row_merge_bulk_apply(
+	row_merge_bulk_t*	bulk,
+	trx_t*			trx)
+{
+	dberr_t	err = DB_SUCCESS;
+
+	for (ulint i = 0; i < bulk->bufs.size(); i++) {
+		dict_index_t*	index = bulk->bufs[i]->index;
+		merge_file_t*	file = &bulk->files[i];
+		const ulint	space_id = index->table->space_id;
+		BtrBulk		btr_bulk(index, trx);
+
+		if (file->fd == OS_FILE_CLOSED) {
+			/* All the entries fit in the sort buffer. */
+			err = row_merge_bulk_sort(bulk, bulk->bufs[i], trx);
+
+			if (err == DB_SUCCESS) {
+				err = row_merge_insert_index_tuples(
+					index, NULL, OS_FILE_CLOSED, NULL,
+					bulk->bufs[i], &btr_bulk, 0, 0, 0,
+					NULL, space_id, NULL,
+					&bulk->blob_file);
+			}
+		} else {
+			err = row_merge_bulk_spill(bulk, i, trx);
+
+			if (err == DB_SUCCESS) {
+				row_merge_dup_t	dup = {
+					index, bulk->mysql_table, NULL, 0 };
+
+				err = row_merge_sort(
+					trx, &dup, file, bulk->block,
+					&bulk->tmpfd, false, 0, 0, NULL,
+					space_id);
+
+				if (err == DB_DUPLICATE_KEY) {
+					trx->error_info = index;
+				}
+			}
+
+			if (err == DB_SUCCESS) {
+				err = row_merge_insert_index_tuples(
+					index, NULL, file->fd, bulk->block,
+					NULL, &btr_bulk, file->n_rec, 0, 0,
+					NULL, space_id, NULL,
+					&bulk->blob_file);
+			}
+
+			/* Close the temporary file to free up space. */
+			row_merge_file_destroy(file);
+		}
+
+		err = btr_bulk.finish(err);
+
+		if (err != DB_SUCCESS) {
+			break;
+		}
+
+		if (dict_index_is_clust(index) && bulk->autoinc
+		    && index->table->persistent_autoinc) {
+			btr_write_autoinc(index, bulk->autoinc);
+		}
+	}
+
+	return(err);
+}
+
+/** Free the buffered inserts.
+@param[in,out]	bulk	buffered inserts */
+void
+row_merge_bulk_free(
+	row_merge_bulk_t*	bulk)
+{
+	for (ulint i = 0; i < bulk->bufs.size(); i++) {
+		row_merge_buf_free(bulk->bufs[i]);
+		row_merge_file_destroy(&bulk->files[i]);
+	}
+
+	row_merge_file_destroy(&bulk->blob_file);
+	row_merge_file_destroy_low(bulk->tmpfd);
+
+	if (bulk->block) {
+		ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+		alloc.deallocate_large(bulk->block, &bulk->block_pfx);
+	}
+
+	UT_DELETE(bulk);
+}
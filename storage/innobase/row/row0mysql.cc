@@ -959,6 +959,7 @@ row_create_prebuilt(
 	prebuilt->fts_doc_id = 0;
 
 	prebuilt->mysql_row_len = mysql_row_len;
+	prebuilt->fetch_cache_size = MYSQL_FETCH_CACHE_SIZE;
 
 	prebuilt->fts_doc_id_in_read_set = 0;
 	prebuilt->blob_heap = NULL;
@@ -1010,26 +1011,7 @@ row_prebuilt_free(
 		mem_heap_free(prebuilt->old_vers_heap);
 	}
 
-	if (prebuilt->fetch_cache[0] != NULL) {
-		byte*	base = prebuilt->fetch_cache[0] - 4;
-		byte*	ptr = base;
-
-		for (ulint i = 0; i < MYSQL_FETCH_CACHE_SIZE; i++) {
-			ulint	magic1 = mach_read_from_4(ptr);
-			ut_a(magic1 == ROW_PREBUILT_FETCH_MAGIC_N);
-			ptr += 4;
-
-			byte*	row = ptr;
-			ut_a(row == prebuilt->fetch_cache[i]);
-			ptr += prebuilt->mysql_row_len;
-
-			ulint	magic2 = mach_read_from_4(ptr);
-			ut_a(magic2 == ROW_PREBUILT_FETCH_MAGIC_N);
-			ptr += 4;
-		}
-
-		ut_free(base);
-	}
+	row_sel_prefetch_cache_free(prebuilt);
 
 	if (prebuilt->rtr_info) {
 		rtr_clean_rtr_info(prebuilt->rtr_info, true);
@@ -1401,10 +1383,21 @@ row_insert_for_mysql(
           node->vers_update_end(prebuilt, ins_mode == ROW_INS_HISTORICAL);
         }
 
-	savept = trx_savept_take(trx);
-
 	thr = que_fork_get_first_thr(prebuilt->ins_graph);
 
+	if (prebuilt->bulk_insert) {
+		/* Only the first row of the statement may start buffering.
+		Any undo log record must precede the savepoint, so that an
+		error in this row will not roll back the TRX_UNDO_EMPTY. */
+		prebuilt->bulk_insert = false;
+
+		if (!prebuilt->ignore_dup_key) {
+			row_ins_bulk_start(node, thr, prebuilt->m_mysql_table);
+		}
+	}
+
+	savept = trx_savept_take(trx);
+
 	if (prebuilt->sql_stat_start) {
 		node->state = INS_NODE_SET_IX_LOCK;
 		prebuilt->sql_stat_start = FALSE;
@@ -1442,6 +1435,9 @@ row_insert_for_mysql(
 			goto run_again;
 		}
 
+		/* The statement will be rolled back. */
+		row_ins_bulk_discard(node);
+
 		trx->op_info = "";
 
 		if (blob_heap != NULL) {
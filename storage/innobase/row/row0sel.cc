@@ -3752,8 +3752,63 @@ row_sel_dequeue_cached_row_for_mysql(
 	}
 }
 
+/** Copy rows that an ongoing scan has already prefetched.
+@param[out]	buf		buffer for the rows in MySQL format
+@param[in]	stride		distance of consecutive rows in buf
+@param[in]	max_rows	maximum number of rows to copy
+@param[in,out]	prebuilt	prebuilt struct for the table handle
+@return number of rows copied to buf */
+ulint
+row_sel_dequeue_cached_rows(
+	byte*		buf,
+	ulint		stride,
+	ulint		max_rows,
+	row_prebuilt_t*	prebuilt)
+{
+	ulint	n = 0;
+
+	ut_ad(stride >= prebuilt->mysql_row_len);
+
+	for (; n < max_rows && prebuilt->n_fetch_cached > 0; n++) {
+		row_sel_dequeue_cached_row_for_mysql(buf, prebuilt);
+		buf += stride;
+	}
+
+	prebuilt->n_rows_fetched += n;
+
+	return(n);
+}
+
+/** Free the cache of prefetched MySQL rows of a table handle.
+@param[in,out]	prebuilt	prebuilt struct */
+void row_sel_prefetch_cache_free(row_prebuilt_t* prebuilt)
+{
+	if (prebuilt->fetch_cache == NULL) {
+		return;
+	}
+
+	const byte*	ptr = prebuilt->fetch_cache[0] - 4;
+
+	for (ulint i = 0; i < prebuilt->fetch_cache_alloc; i++) {
+		ulint	magic1 = mach_read_from_4(ptr);
+		ut_a(magic1 == ROW_PREBUILT_FETCH_MAGIC_N);
+		ptr += 4;
+
+		ut_a(ptr == prebuilt->fetch_cache[i]);
+		ptr += prebuilt->mysql_row_len;
+
+		ulint	magic2 = mach_read_from_4(ptr);
+		ut_a(magic2 == ROW_PREBUILT_FETCH_MAGIC_N);
+		ptr += 4;
+	}
+
+	ut_free(prebuilt->fetch_cache);
+	prebuilt->fetch_cache = NULL;
+	prebuilt->fetch_cache_alloc = 0;
+}
+
 /********************************************************************//**
-Initialise the prefetch cache. */
+Initialise the prefetch cache for prebuilt->fetch_cache_size rows. */
 UNIV_INLINE
 void
 row_sel_prefetch_cache_init(
@@ -3764,11 +3819,20 @@ row_sel_prefetch_cache_init(
 	ulint	sz;
 	byte*	ptr;
 
-	/* Reserve space for the magic number. */
-	sz = UT_ARR_SIZE(prebuilt->fetch_cache) * (prebuilt->mysql_row_len + 8);
-	ptr = static_cast<byte*>(ut_malloc_nokey(sz));
+	ut_ad(prebuilt->fetch_cache == NULL);
+	ut_ad(prebuilt->fetch_cache_size >= MYSQL_FETCH_CACHE_SIZE);
+	ut_ad(prebuilt->fetch_cache_size <= MYSQL_FETCH_CACHE_MAX_SIZE);
 
-	for (i = 0; i < UT_ARR_SIZE(prebuilt->fetch_cache); i++) {
+	const ulint	n = prebuilt->fetch_cache_size;
+
+	/* The array of pointers is followed by the rows.
+	Reserve space for the magic numbers. */
+	sz = n * (sizeof(byte*) + prebuilt->mysql_row_len + 8);
+	prebuilt->fetch_cache = static_cast<byte**>(ut_malloc_nokey(sz));
+	prebuilt->fetch_cache_alloc = n;
+	ptr = reinterpret_cast<byte*>(prebuilt->fetch_cache + n);
+
+	for (i = 0; i < n; i++) {
 
 		/* A user has reported memory corruption in these
 		buffers in Linux. Put magic numbers there to help
@@ -3795,12 +3859,14 @@ row_sel_fetch_last_buf(
 	row_prebuilt_t*	prebuilt)	/*!< in/out: prebuilt struct */
 {
 	ut_ad(!prebuilt->templ_contains_blob);
-	ut_ad(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+	ut_ad(prebuilt->n_fetch_cached < prebuilt->fetch_cache_size);
 
-	if (prebuilt->fetch_cache[0] == NULL) {
-		/* Allocate memory for the fetch cache */
+	if (prebuilt->fetch_cache_alloc < prebuilt->fetch_cache_size) {
+		/* Allocate memory for the fetch cache, or replace
+		a smaller one */
 		ut_ad(prebuilt->n_fetch_cached == 0);
 
+		row_sel_prefetch_cache_free(prebuilt);
 		row_sel_prefetch_cache_init(prebuilt);
 	}
 
@@ -3811,6 +3877,33 @@ row_sel_fetch_last_buf(
 	return(prebuilt->fetch_cache[prebuilt->n_fetch_cached]);
 }
 
+/** Adapt the number of rows that are cached in a batch to the length
+of the current scan. Each time a batch has been consumed and the scan
+continues, the batch size is doubled, until the rows of a batch would
+exceed innodb_fetch_cache_size.
+@param[in,out]	prebuilt	prebuilt struct with an empty fetch cache */
+static void row_sel_prefetch_cache_adapt(row_prebuilt_t* prebuilt)
+{
+	ut_ad(prebuilt->n_fetch_cached == 0);
+
+	ulint	size = prebuilt->fetch_cache_size;
+
+	if (prebuilt->n_rows_fetched <= size
+	    || size >= MYSQL_FETCH_CACHE_MAX_SIZE) {
+		return;
+	}
+
+	ulint	max_size = srv_fetch_cache_size
+		/ (prebuilt->mysql_row_len + 8);
+
+	if (max_size > size) {
+		prebuilt->fetch_cache_size = std::min<ulint>(
+			std::min(2 * size, max_size),
+			MYSQL_FETCH_CACHE_MAX_SIZE);
+		MONITOR_INC(MONITOR_FETCH_CACHE_RESIZES);
+	}
+}
+
 /********************************************************************//**
 Pushes a row for MySQL to the fetch cache. */
 UNIV_INLINE
@@ -4302,6 +4395,7 @@ row_search_mvcc(
 		prebuilt->n_rows_fetched = 0;
 		prebuilt->n_fetch_cached = 0;
 		prebuilt->fetch_cache_first = 0;
+		prebuilt->fetch_cache_size = MYSQL_FETCH_CACHE_SIZE;
 
 		if (prebuilt->sel_graph == NULL) {
 			/* Build a dummy select query graph */
@@ -4326,6 +4420,7 @@ row_search_mvcc(
 			prebuilt->n_rows_fetched = 0;
 			prebuilt->n_fetch_cached = 0;
 			prebuilt->fetch_cache_first = 0;
+			prebuilt->fetch_cache_size = MYSQL_FETCH_CACHE_SIZE;
 
 		} else if (UNIV_LIKELY(prebuilt->n_fetch_cached > 0)) {
 			row_sel_dequeue_cached_row_for_mysql(buf, prebuilt);
@@ -4336,7 +4431,8 @@ row_search_mvcc(
 		}
 
 		if (prebuilt->fetch_cache_first > 0
-		    && prebuilt->fetch_cache_first < MYSQL_FETCH_CACHE_SIZE) {
+		    && prebuilt->fetch_cache_first
+		    < prebuilt->fetch_cache_size) {
 early_not_found:
 			/* The previous returned row was popped from the fetch
 			cache, but the cache was not full at the time of the
@@ -4352,6 +4448,8 @@ row_search_mvcc(
 			prebuilt->n_rows_fetched = 500000000;
 		}
 
+		row_sel_prefetch_cache_adapt(prebuilt);
+
 		mode = pcur->search_mode;
 	}
 
@@ -5407,7 +5505,7 @@ row_search_mvcc(
 		not cache rows because there the cursor is a scrollable
 		cursor. */
 
-		ut_a(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+		ut_a(prebuilt->n_fetch_cached < prebuilt->fetch_cache_size);
 
 		/* We only convert from InnoDB row format to MySQL row
 		format when ICP is disabled. */
@@ -5459,7 +5557,7 @@ row_search_mvcc(
 			row_sel_enqueue_cache_row_for_mysql(buf, prebuilt);
 		}
 
-		if (prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE) {
+		if (prebuilt->n_fetch_cached < prebuilt->fetch_cache_size) {
 			goto next_rec;
 		}
 
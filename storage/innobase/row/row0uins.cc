@@ -384,6 +384,7 @@ static bool row_undo_ins_parse_undo_rec(undo_node_t* node, bool dict_locked)
 		goto close_table;
 	case TRX_UNDO_INSERT_METADATA:
 	case TRX_UNDO_INSERT_REC:
+	case TRX_UNDO_EMPTY:
 		break;
 	case TRX_UNDO_RENAME_TABLE:
 		dict_table_t* table = node->table;
@@ -415,6 +416,10 @@ static bool row_undo_ins_parse_undo_rec(undo_node_t* node, bool dict_locked)
 		dict_table_close(node->table, dict_locked, FALSE);
 		node->table = NULL;
 		return false;
+	} else if (node->rec_type == TRX_UNDO_EMPTY) {
+		/* row_undo_ins() will empty all the indexes */
+		ut_ad(!node->table->is_temporary());
+		node->ref = NULL;
 	} else {
 		ut_ad(!node->table->skip_alter_undo);
 		clust_index = dict_table_get_first_index(node->table);
@@ -589,6 +594,24 @@ row_undo_ins(
 		log_free_check();
 		ut_ad(!node->table->is_temporary());
 		err = row_undo_ins_remove_clust_rec(node);
+		break;
+
+	case TRX_UNDO_EMPTY:
+		/* The table was empty before the bulk insert.
+		@see row_ins_bulk_start() */
+		for (dict_index_t* index = node->index; index;
+		     index = dict_table_get_next_index(index)) {
+			if (index->page != FIL_NULL) {
+				log_free_check();
+				btr_clear_index(index);
+			}
+		}
+
+		if (node->table->stat_initialized) {
+			node->table->stat_n_rows = 0;
+		}
+
+		err = DB_SUCCESS;
 	}
 
 	dict_table_close(node->table, dict_locked, FALSE);
@@ -1264,6 +1264,11 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OLVD_SYSTEM_ROW_UPDATED},
 
+	{"fetch_cache_resizes", "dml",
+	 "Number of times an index scan enlarged its row prefetch cache",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FETCH_CACHE_RESIZES},
+
 	/* ========== Counters for DDL operations ========== */
 	{"module_ddl", "ddl", "Statistics for DDLs",
 	 MONITOR_MODULE,
@@ -1587,7 +1592,7 @@ srv_mon_process_existing_counter(
 	case MONITOR_OVLD_BUF_POOL_PAGE_MISC:
 		value = buf_pool.get_n_pages()
 			- UT_LIST_GET_LEN(buf_pool.LRU)
-			- UT_LIST_GET_LEN(buf_pool.free);
+			- buf_pool.free_len();
 		break;
 
 	/* innodb_buffer_pool_pages_data */
@@ -1614,7 +1619,7 @@ srv_mon_process_existing_counter(
 
 	/* innodb_buffer_pool_pages_free */
 	case MONITOR_OVLD_BUF_POOL_PAGES_FREE:
-		value = UT_LIST_GET_LEN(buf_pool.free);
+		value = buf_pool.free_len();
 		break;
 
 	/* innodb_pages_created, the number of pages created */
@@ -134,6 +134,9 @@ my_bool	high_level_read_only;
 
 /** Sort buffer size in index creation */
 ulong	srv_sort_buf_size;
+/** innodb_fetch_cache_size; maximum size of the cache of prefetched rows
+of an index scan, in bytes */
+ulong	srv_fetch_cache_size;
 /** Maximum modification log file size for online index creation */
 unsigned long long	srv_online_max_size;
 
@@ -142,6 +145,10 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 my_bool	srv_use_native_aio;
+#ifdef __linux__
+/** innodb_linux_aio; @see srv_linux_aio_t */
+ulong	srv_linux_aio_method;
+#endif
 my_bool	srv_numa_interleave;
 /** copy of innodb_use_atomic_writes; @see innodb_init_params() */
 my_bool	srv_use_atomic_writes;
@@ -205,6 +212,8 @@ const ulint	srv_buf_pool_min_size	= 5 * 1024 * 1024;
 const ulint	srv_buf_pool_def_size	= 128 * 1024 * 1024;
 /** Requested buffer pool chunk size */
 ulong	srv_buf_pool_chunk_unit;
+/** innodb_buffer_pool_free_shards */
+ulong	srv_buf_pool_free_shards;
 /** innodb_lru_scan_depth; number of blocks scanned in LRU flush batch */
 ulong	srv_LRU_scan_depth;
 /** innodb_flush_neighbors; whether or not to flush neighbors of a block */
@@ -231,6 +240,10 @@ ulong	srv_idle_flush_pct;
 ulong	srv_n_read_io_threads;
 /** innodb_write_io_threads */
 ulong	srv_n_write_io_threads;
+/** innodb_recovery_threads */
+ulong	srv_n_recovery_threads;
+/** innodb_page_cleaners */
+ulong	srv_n_page_cleaners;
 
 /** innodb_random_read_ahead */
 my_bool	srv_random_read_ahead;
@@ -248,6 +261,9 @@ ulong	srv_file_flush_method;
 
 /** copy of innodb_open_files; @see innodb_init_params() */
 ulint	srv_max_n_open_files;
+/** innodb_lazy_tablespace_open: whether to defer opening
+file-per-table tablespaces until they are first accessed */
+my_bool	srv_lazy_tablespace_open;
 
 /** innodb_io_capacity */
 ulong	srv_io_capacity;
@@ -315,6 +331,9 @@ ibool	srv_innodb_status;
 prefix index queries to skip cluster index lookup when possible */
 my_bool	srv_prefix_index_cluster_optimization;
 
+/** innodb_read_view_csn: whether read views are commit sequence numbers */
+my_bool	srv_read_view_csn;
+
 /** innodb_stats_transient_sample_pages;
 When estimating number of different key values in an index, sample
 this many index pages, there are 2 ways to calculate statistics:
@@ -1142,8 +1161,7 @@ srv_export_innodb_status(void)
 	export_vars.innodb_buffer_pool_bytes_dirty =
 		buf_pool.stat.flush_list_bytes;
 
-	export_vars.innodb_buffer_pool_pages_free =
-		UT_LIST_GET_LEN(buf_pool.free);
+	export_vars.innodb_buffer_pool_pages_free = buf_pool.free_len();
 
 #ifdef UNIV_DEBUG
 	export_vars.innodb_buffer_pool_pages_latched =
@@ -1154,7 +1172,7 @@ srv_export_innodb_status(void)
 	export_vars.innodb_buffer_pool_pages_misc =
 		buf_pool.get_n_pages()
 		- UT_LIST_GET_LEN(buf_pool.LRU)
-		- UT_LIST_GET_LEN(buf_pool.free);
+		- buf_pool.free_len();
 
 	export_vars.innodb_max_trx_id = trx_sys.get_max_trx_id();
 	export_vars.innodb_history_list_length = trx_sys.rseg_history_len;
@@ -1862,6 +1880,10 @@ void srv_master_callback(void*)
 
 	srv_main_thread_op_info = "";
 	MONITOR_INC(MONITOR_MASTER_THREAD_SLEEP);
+	if (trx_sys.csn.enabled()) {
+		srv_main_thread_op_info = "advancing commit sequence limits";
+		trx_sys.update_csn_limits();
+	}
 	if (srv_check_activity(&old_activity_count)) {
 		srv_master_do_active_tasks();
 	} else {
@@ -382,7 +382,8 @@ trx_undo_page_report_insert(
 	trx_t*		trx,		/*!< in: transaction */
 	dict_index_t*	index,		/*!< in: clustered index */
 	const dtuple_t*	clust_entry,	/*!< in: index entry which will be
-					inserted to the clustered index */
+					inserted to the clustered index,
+					or NULL for TRX_UNDO_EMPTY */
 	mtr_t*		mtr)		/*!< in: mtr */
 {
 	ut_ad(index->is_primary());
@@ -414,6 +415,11 @@ trx_undo_page_report_insert(
 	/*----------------------------------------*/
 	/* Store then the fields required to uniquely determine the record
 	to be inserted in the clustered index */
+	if (UNIV_UNLIKELY(!clust_entry)) {
+		undo_block->frame[first_free + 2] = TRX_UNDO_EMPTY;
+		goto done;
+	}
+
 	if (UNIV_UNLIKELY(clust_entry->info_bits != 0)) {
 		ut_ad(clust_entry->is_metadata());
 		ut_ad(index->is_instant());
@@ -488,7 +494,7 @@ trx_undo_rec_get_pars(
 	type_cmpl &= ~TRX_UNDO_UPD_EXTERN;
 	*type = type_cmpl & (TRX_UNDO_CMPL_INFO_MULT - 1);
 	ut_ad(*type >= TRX_UNDO_RENAME_TABLE);
-	ut_ad(*type <= TRX_UNDO_DEL_MARK_REC);
+	ut_ad(*type <= TRX_UNDO_EMPTY);
 	*cmpl_info = type_cmpl / TRX_UNDO_CMPL_INFO_MULT;
 
 	*undo_no = mach_read_next_much_compressed(&ptr);
@@ -1952,7 +1958,9 @@ trx_undo_report_row_operation(
 					may contain a clustered index
 					record tuple that also contains
 					virtual columns of the table;
-					otherwise, NULL */
+					otherwise, NULL; NULL together
+					with rec==NULL writes a
+					TRX_UNDO_EMPTY record */
 	const upd_t*	update,		/*!< in: in the case of an update,
 					the update vector, otherwise NULL */
 	ulint		cmpl_info,	/*!< in: compiler info on secondary
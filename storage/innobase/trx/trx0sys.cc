@@ -40,6 +40,7 @@ Created 3/26/1996 Heikki Tuuri
 #include "log0log.h"
 #include "log0recv.h"
 #include "os0file.h"
+#include "sync0sync.h"
 
 /** The transaction system */
 trx_sys_t		trx_sys;
@@ -198,6 +199,166 @@ trx_sysf_create(
 	ut_a(rblock->page.id() == page_id_t(0, FSP_FIRST_RSEG_PAGE_NO));
 }
 
+/** Create the data structures if innodb_read_view_csn=ON. */
+void trx_csn_t::create()
+{
+  ut_ad(!m_slots);
+  if (!srv_read_view_csn)
+    return;
+  m_slots= static_cast<slot_t*>(ut_zalloc_nokey(N_SLOTS * sizeof *m_slots));
+  /* A read view with m_csn=0 would not be a CSN snapshot. */
+  m_allocated= 1;
+  m_published= 1;
+  m_reuse_limit= 0;
+  m_up_limit_id= 0;
+  m_overflow_min= TRX_ID_MAX;
+}
+
+/** Free the data structures. */
+void trx_csn_t::close()
+{
+  if (!m_slots)
+    return;
+  ut_free(m_slots);
+  m_slots= nullptr;
+  m_overflow.clear();
+}
+
+/** Register a read-write transaction as active.
+@param id  transaction identifier
+@return where commit() will write the CSN of the transaction */
+std::atomic<trx_id_t> *trx_csn_t::register_rw(trx_id_t id)
+{
+  ut_ad(enabled());
+  ut_ad(id);
+  slot_t &s= slot(id);
+  trx_id_t old_id= s.id.load(std::memory_order_acquire);
+
+  /* The slot may be reused if the CSN of its previous transaction
+  is visible to all read views. */
+  if (old_id != LOCKED &&
+      s.csn.load(std::memory_order_acquire) <=
+      m_reuse_limit.load(std::memory_order_acquire) &&
+      s.id.compare_exchange_strong(old_id, LOCKED, std::memory_order_acquire,
+                                   std::memory_order_relaxed))
+  {
+    /* A concurrent visible() that observes ACTIVE will also observe
+    that the slot no longer belongs to old_id. */
+    s.csn.store(ACTIVE, std::memory_order_release);
+    s.id.store(id, std::memory_order_release);
+    return &s.csn;
+  }
+
+  m_overflow_latch.write_lock();
+  std::atomic<trx_id_t> &csn= m_overflow.emplace(
+    std::piecewise_construct, std::forward_as_tuple(id),
+    std::forward_as_tuple(trx_id_t{ACTIVE})).first->second;
+  if (id < m_overflow_min.load(std::memory_order_relaxed))
+    m_overflow_min.store(id, std::memory_order_release);
+  m_overflow_latch.write_unlock();
+  return &csn;
+}
+
+/** Assign the next CSN to a transaction, making it visible to
+new read views.
+@param entry  the return value of register_rw(), or nullptr if the
+transaction is visible to all read views already */
+void trx_csn_t::commit(std::atomic<trx_id_t> *entry)
+{
+  ut_ad(enabled());
+  /* The entry cannot be reused or evicted before its CSN has been
+  published, so it can be written without any latch. Between the
+  allocation and the publication, nothing will wait. */
+  const trx_id_t csn= m_allocated.fetch_add(1, std::memory_order_relaxed) + 1;
+
+  if (entry)
+    entry->store(csn, std::memory_order_release);
+
+  /* Publish the CSN after all preceding ones, so that snapshot() never
+  covers a CSN whose transaction is not yet marked committed. */
+  for (ulint i= 0;
+       m_published.load(std::memory_order_acquire) != csn - 1; i++)
+  {
+    if (i < 64)
+      ut_delay(1);
+    else
+      os_thread_yield();
+  }
+  m_published.store(csn, std::memory_order_release);
+}
+
+/** Determine whether a read view sees a transaction.
+@param id   transaction identifier
+@param csn  CSN of the read view
+@return whether the transaction was committed at or before csn */
+bool trx_csn_t::visible(trx_id_t id, trx_id_t csn) const
+{
+  ut_ad(enabled());
+  const slot_t &s= slot(id);
+  if (s.id.load(std::memory_order_acquire) == id)
+  {
+    const trx_id_t c= s.csn.load(std::memory_order_acquire);
+    if (s.id.load(std::memory_order_relaxed) == id)
+      return c <= csn;
+    /* The slot was reused, so the CSN is at most m_reuse_limit. */
+    return true;
+  }
+
+  if (id >= m_overflow_min.load(std::memory_order_acquire))
+  {
+    m_overflow_latch.read_lock();
+    auto it= m_overflow.find(id);
+    const bool found= it != m_overflow.end();
+    const trx_id_t c= found ? it->second.load(std::memory_order_acquire) : 0;
+    m_overflow_latch.read_unlock();
+    if (found)
+      return c <= csn;
+  }
+
+  /* The entry was evicted because the CSN was visible to all read
+  views, or the transaction was committed before startup. */
+  return true;
+}
+
+/** Advance the limits after the oldest view has been cloned.
+@param up_limit_id  smallest transaction identifier that was active
+when the view was created
+@param oldest_csn   smallest CSN of any open read view, or of a read
+view that will be created */
+void trx_csn_t::purge_update(trx_id_t up_limit_id, trx_id_t oldest_csn)
+{
+  ut_ad(enabled());
+  /* The purge coordinator and the master task may both call this. */
+  for (trx_id_t old= m_up_limit_id.load(std::memory_order_relaxed);
+       up_limit_id > old &&
+       !m_up_limit_id.compare_exchange_weak(old, up_limit_id,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed); )
+    ;
+  for (trx_id_t old= m_reuse_limit.load(std::memory_order_relaxed);
+       oldest_csn > old &&
+       !m_reuse_limit.compare_exchange_weak(old, oldest_csn,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed); )
+    ;
+
+  if (m_overflow_min.load(std::memory_order_acquire) == TRX_ID_MAX)
+    return;
+
+  m_overflow_latch.write_lock();
+  for (auto it= m_overflow.begin(); it != m_overflow.end(); )
+  {
+    if (it->second.load(std::memory_order_acquire) <= oldest_csn)
+      it= m_overflow.erase(it);
+    else
+      ++it;
+  }
+  m_overflow_min.store(m_overflow.empty()
+                       ? TRX_ID_MAX : m_overflow.begin()->first,
+                       std::memory_order_release);
+  m_overflow_latch.write_unlock();
+}
+
 /** Create the instance */
 void
 trx_sys_t::create()
@@ -209,6 +370,7 @@ trx_sys_t::create()
 	rseg_history_len= 0;
 
 	rw_trx_hash.init();
+	csn.create();
 }
 
 /*****************************************************************//**
@@ -306,6 +468,7 @@ trx_sys_t::close()
 	}
 
 	rw_trx_hash.destroy();
+	csn.close();
 
 	/* There can't be any active transactions. */
 
@@ -181,6 +181,7 @@ struct TrxFactory {
 		new(&trx->read_view) ReadView();
 
 		trx->rw_trx_hash_pins = 0;
+		trx->csn_entry = NULL;
 		trx_init(trx);
 
 		trx->dict_operation_lock_mode = 0;
@@ -565,6 +566,8 @@ trx_resurrect_table_locks(
 {
 	mtr_t			mtr;
 	table_id_set		tables;
+	/* tables with a TRX_UNDO_EMPTY record, to be locked exclusively */
+	table_id_set		empty_tables;
 
 	ut_ad(trx_state_eq(trx, TRX_STATE_ACTIVE) ||
 	      trx_state_eq(trx, TRX_STATE_PREPARED));
@@ -600,6 +603,9 @@ trx_resurrect_table_locks(
 			undo_rec, &type, &cmpl_info,
 			&updated_extern, &undo_no, &table_id);
 		tables.insert(table_id);
+		if (type == TRX_UNDO_EMPTY) {
+			empty_tables.insert(table_id);
+		}
 
 		undo_rec = trx_undo_get_prev_rec(
 			block, page_offset(undo_rec), undo->hdr_page_no,
@@ -625,11 +631,14 @@ trx_resurrect_table_locks(
 					trx_mod_tables_t::value_type(table,
 								     0));
 			}
-			lock_table_ix_resurrect(table, trx);
+			const bool empty = empty_tables.count(*i) != 0;
+			lock_table_resurrect(table, trx,
+					     empty ? LOCK_X : LOCK_IX);
 
 			DBUG_LOG("ib_trx",
 				 "resurrect " << ib::hex(trx->id)
-				 << " IX lock on " << table->name);
+				 << (empty ? " X" : " IX") << " lock on "
+				 << table->name);
 
 			dict_table_close(table, FALSE, FALSE);
 		}
@@ -704,6 +713,8 @@ static void trx_resurrect(trx_undo_t *undo, trx_rseg_t *rseg,
       trx->table_id= undo->table_id;
   }
 
+  if (trx_sys.csn.enabled())
+    trx->csn_entry= trx_sys.csn.register_rw(trx->id);
   trx_sys.rw_trx_hash.insert(trx);
   trx_sys.rw_trx_hash.put_pins(trx);
   trx_resurrect_table_locks(trx, undo);
@@ -1267,10 +1278,10 @@ trx_update_mod_tables_timestamp(
 		/* recheck while holding the mutex that blocks
 		table->acquire() */
 		mutex_enter(&dict_sys.mutex);
-		mutex_enter(&lock_sys.mutex);
+		lock_mutex_enter();
 		const bool do_evict = !table->get_ref_count()
 			&& !UT_LIST_GET_LEN(table->locks);
-		mutex_exit(&lock_sys.mutex);
+		lock_mutex_exit();
 		if (do_evict) {
 			dict_sys.remove(table, true);
 		}
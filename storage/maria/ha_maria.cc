@@ -2513,6 +2513,13 @@ int ha_maria::rnd_next(uchar *buf)
 }
 
 
+int ha_maria::rnd_next_batch(uchar *buf, uint max_rows, uint *rows)
+{
+  register_handler(file);
+  return maria_scan_batch(file, buf, table->s->reclength, max_rows, rows);
+}
+
+
 int ha_maria::remember_rnd_pos()
 {
   register_handler(file);
@@ -110,6 +110,7 @@ class __attribute__((visibility("default"))) ha_maria :public handler
   int rnd_init(bool scan) override final;
   int rnd_end(void) override final;
   int rnd_next(uchar * buf) override final;
+  int rnd_next_batch(uchar *buf, uint max_rows, uint *rows) override final;
   int rnd_pos(uchar * buf, uchar * pos) override final;
   int remember_rnd_pos() override final;
   int restart_rnd_next(uchar * buf) override final;
@@ -55,6 +55,49 @@ int maria_scan(MARIA_HA *info, uchar *record)
 }
 
 
+/*
+  Read the next rows of a scan
+
+  SYNOPSIS
+    maria_scan_batch()
+    info		Maria handler
+    buf			Read the rows here, one after another
+    reclength		Length of a row in buf
+    max_rows		Max number of rows to read
+    rows	  OUT	Number of rows read
+
+  NOTES
+    The batch ends early at a deleted record; HA_ERR_RECORD_DELETED is
+    only returned when no rows were read. Rows read before an error are
+    returned in buf and *rows together with the error.
+
+  RETURN
+    0  			   ok
+    HA_ERR_END_OF_FILE     End of file
+    HA_ERR_RECORD_DELETED  Record was deleted (can only happen for static rec)
+    #			   Error code
+*/
+
+int maria_scan_batch(MARIA_HA *info, uchar *buf, uint reclength,
+                     uint max_rows, uint *rows)
+{
+  int error= 0;
+  DBUG_ENTER("maria_scan_batch");
+
+  for (*rows= 0; *rows < max_rows; (*rows)++, buf+= reclength)
+  {
+    info->update&= (HA_STATE_CHANGED | HA_STATE_ROW_CHANGED);
+    if ((error= (*info->s->scan)(info, buf, info->cur_row.nextpos, 1)))
+    {
+      if (error == HA_ERR_RECORD_DELETED && *rows)
+        error= 0;
+      break;
+    }
+  }
+  DBUG_RETURN(error);
+}
+
+
 void maria_scan_end(MARIA_HA *info)
 {
   (*info->s->scan_end)(info);
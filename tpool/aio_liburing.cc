@@ -0,0 +1,389 @@
+/* Copyright(C) 2021 MariaDB Corporation.
+
+This program is free software; you can redistribute itand /or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02111 - 1301 USA*/
+
+#include "tpool_structs.h"
+#include "tpool.h"
+
+#include <liburing.h>
+#include <sys/resource.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+
+/*
+  Linux AIO implementation, based on io_uring.
+  Needs liburing.h and -luring at the compile time.
+
+  Submission is batched: the thread that finds no other submitter
+  active becomes the submitter, and keeps moving requests from the
+  pending queue into the submission ring with one io_uring_enter()
+  per batch, until the queue is empty. Other threads only append
+  to the queue.
+
+  Files passed to bind() are put into the registered file table,
+  and the buffers passed to register_buffers() are registered with
+  the ring, so that the kernel does not need to look up the file
+  and pin the pages for each request.
+
+  There is a single thread, that collects the completions in batches,
+  and forwards io completion callback the worker threadpool.
+*/
+namespace tpool
+{
+
+class aio_uring : public aio
+{
+  /** Upper bound of the registered file table size */
+  static constexpr unsigned MAX_REGISTERED_FILES = 4096;
+  /** Maximum number of completions to reap at once */
+  static constexpr unsigned MAX_REAP = 64;
+
+  thread_pool* m_pool;
+  io_uring m_ring;
+
+  /** Protects m_queue and m_submitting */
+  std::mutex m_queue_mutex;
+  /** Requests waiting to be put into the submission ring */
+  std::vector<aiocb*> m_queue;
+  /** Whether some thread is currently the submitter */
+  bool m_submitting;
+
+  /** Protects m_files, m_free_slots and m_buffers, and is held
+  from preparing submission queue entries until they are submitted */
+  std::mutex m_reg_mutex;
+  /** Registered file descriptors and their slots in the file table */
+  std::unordered_map<int, unsigned> m_files;
+  /** Free slots in the registered file table */
+  std::vector<unsigned> m_free_slots;
+  /** Registered buffers, sorted by address */
+  std::vector<iovec> m_buffers;
+
+  std::thread m_thread;
+
+  aio_uring(thread_pool* pool) : m_pool(pool), m_submitting()
+  {
+  }
+
+  bool init(int max_io)
+  {
+    if (int ret = io_uring_queue_init(max_io, &m_ring, 0))
+    {
+      fprintf(stderr, "io_uring_queue_init(%d) returned %d\n", max_io, ret);
+      return false;
+    }
+
+    /* IORING_OP_READ and IORING_OP_WRITE need Linux 5.6 */
+    if (io_uring_probe* probe = io_uring_get_probe_ring(&m_ring))
+    {
+      bool supported = io_uring_opcode_supported(probe, IORING_OP_READ) &&
+        io_uring_opcode_supported(probe, IORING_OP_WRITE);
+      io_uring_free_probe(probe);
+      if (!supported)
+      {
+        io_uring_queue_exit(&m_ring);
+        return false;
+      }
+    }
+
+    /* The registered file table is optional; without it the plain
+    file descriptors are used. */
+    unsigned n_files = MAX_REGISTERED_FILES;
+    rlimit rl;
+    if (!getrlimit(RLIMIT_NOFILE, &rl) && rl.rlim_cur < n_files)
+      n_files = unsigned(rl.rlim_cur / 2);
+    if (n_files)
+    {
+      std::vector<int> fds(n_files, -1);
+      if (!io_uring_register_files(&m_ring, fds.data(), n_files))
+      {
+        m_free_slots.reserve(n_files);
+        for (unsigned i = n_files; i--; )
+          m_free_slots.push_back(i);
+      }
+    }
+
+    m_queue.reserve(max_io);
+    m_thread = std::thread(thread_routine, this);
+    return true;
+  }
+
+  static void thread_routine(aio_uring* aio)
+  {
+    for (;;)
+    {
+      io_uring_cqe* cqe;
+      int ret = io_uring_wait_cqe(&aio->m_ring, &cqe);
+      if (ret)
+      {
+        if (ret == -EINTR || ret == -EAGAIN)
+          continue;
+        fprintf(stderr, "io_uring_wait_cqe() returned %d\n", ret);
+        abort();
+      }
+
+      io_uring_cqe* cqes[MAX_REAP];
+      unsigned n = io_uring_peek_batch_cqe(&aio->m_ring, cqes, MAX_REAP);
+      bool shutdown = false;
+
+      for (unsigned i = 0; i < n; i++)
+      {
+        aiocb* iocb = static_cast<aiocb*>(io_uring_cqe_get_data(cqes[i]));
+        if (!iocb)
+        {
+          /* The NOP submitted by the destructor */
+          shutdown = true;
+          continue;
+        }
+
+        int res = cqes[i]->res;
+        if (res < 0)
+        {
+          iocb->m_err = -res;
+          iocb->m_ret_len = 0;
+        }
+        else
+        {
+          iocb->m_ret_len = res;
+          iocb->m_err = 0;
+        }
+
+        iocb->m_internal_task.m_func = iocb->m_callback;
+        iocb->m_internal_task.m_arg = iocb;
+        iocb->m_internal_task.m_group = iocb->m_group;
+        aio->m_pool->submit_task(&iocb->m_internal_task);
+      }
+
+      io_uring_cq_advance(&aio->m_ring, n);
+
+      if (shutdown)
+        break;
+    }
+  }
+
+  /** Fill a submission queue entry.
+  Caller must hold m_reg_mutex. */
+  void prepare(io_uring_sqe* sqe, aiocb* cb)
+  {
+    int fd = cb->m_fh;
+    bool fixed_file = false;
+    auto f = m_files.find(fd);
+    if (f != m_files.end())
+    {
+      fd = int(f->second);
+      fixed_file = true;
+    }
+
+    const char* buf = static_cast<const char*>(cb->m_buffer);
+    auto b = std::upper_bound(m_buffers.begin(), m_buffers.end(), buf,
+                              [](const char* p, const iovec& v)
+                              { return p < static_cast<const char*>(v.iov_base); });
+    int buf_index = -1;
+    if (b != m_buffers.begin())
+    {
+      --b;
+      if (buf + cb->m_len <= static_cast<const char*>(b->iov_base) + b->iov_len)
+        buf_index = int(b - m_buffers.begin());
+    }
+
+    if (cb->m_opcode == aio_opcode::AIO_PREAD)
+    {
+      if (buf_index >= 0)
+        io_uring_prep_read_fixed(sqe, fd, cb->m_buffer, cb->m_len,
+                                 cb->m_offset, buf_index);
+      else
+        io_uring_prep_read(sqe, fd, cb->m_buffer, cb->m_len, cb->m_offset);
+    }
+    else
+    {
+      if (buf_index >= 0)
+        io_uring_prep_write_fixed(sqe, fd, cb->m_buffer, cb->m_len,
+                                  cb->m_offset, buf_index);
+      else
+        io_uring_prep_write(sqe, fd, cb->m_buffer, cb->m_len, cb->m_offset);
+    }
+
+    if (fixed_file)
+      sqe->flags |= IOSQE_FIXED_FILE;
+    io_uring_sqe_set_data(sqe, cb);
+  }
+
+  /** Submit everything that is in the submission ring. */
+  void flush()
+  {
+    while (io_uring_sq_ready(&m_ring))
+    {
+      int ret = io_uring_submit(&m_ring);
+      if (ret >= 0)
+        continue;
+      switch (ret)
+      {
+      case -EAGAIN:
+      case -EBUSY:
+        /* The completion thread will make room */
+        usleep(1000);
+        /* fall through */
+      case -EINTR:
+        continue;
+      default:
+        fprintf(stderr, "io_uring_submit() returned %d\n", ret);
+        abort();
+      }
+    }
+  }
+
+public:
+  static aio_uring* create(thread_pool* pool, int max_io)
+  {
+    aio_uring* aio = new aio_uring(pool);
+    if (aio->init(max_io))
+      return aio;
+    delete aio;
+    return nullptr;
+  }
+
+  ~aio_uring()
+  {
+    if (!m_thread.joinable())
+      return;
+    /* No IO can be submitted concurrently with the destruction.
+    Wake up the completion thread with a NOP that carries no aiocb */
+    io_uring_sqe* sqe;
+    while (!(sqe = io_uring_get_sqe(&m_ring)))
+      flush();
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    flush();
+    m_thread.join();
+    io_uring_queue_exit(&m_ring);
+  }
+
+  // Inherited via aio
+  virtual int submit_io(aiocb* cb) override
+  {
+    std::vector<aiocb*> batch;
+    {
+      std::lock_guard<std::mutex> lk(m_queue_mutex);
+      m_queue.push_back(cb);
+      if (m_submitting)
+        return 0;
+      m_submitting = true;
+    }
+
+    for (;;)
+    {
+      {
+        std::lock_guard<std::mutex> lk(m_queue_mutex);
+        if (m_queue.empty())
+        {
+          m_submitting = false;
+          return 0;
+        }
+        batch.swap(m_queue);
+      }
+
+      {
+        /* Keep m_reg_mutex until the kernel has consumed the entries,
+        so that unbind() or unregister_buffers() cannot remove a file
+        or buffer that a prepared entry refers to by index. */
+        std::lock_guard<std::mutex> lk(m_reg_mutex);
+        for (aiocb* req : batch)
+        {
+          io_uring_sqe* sqe;
+          while (!(sqe = io_uring_get_sqe(&m_ring)))
+            flush();
+          prepare(sqe, req);
+        }
+        flush();
+      }
+      batch.clear();
+    }
+  }
+
+  // Inherited via aio
+  virtual int bind(native_file_handle& fd) override
+  {
+    std::lock_guard<std::mutex> lk(m_reg_mutex);
+    if (m_free_slots.empty() || m_files.count(fd))
+      return 0;
+    unsigned slot = m_free_slots.back();
+    int f = fd;
+    if (io_uring_register_files_update(&m_ring, slot, &f, 1) == 1)
+    {
+      m_free_slots.pop_back();
+      m_files.emplace(fd, slot);
+    }
+    return 0;
+  }
+
+  virtual int unbind(const native_file_handle& fd) override
+  {
+    std::lock_guard<std::mutex> lk(m_reg_mutex);
+    auto f = m_files.find(fd);
+    if (f == m_files.end())
+      return 0;
+    int none = -1;
+    io_uring_register_files_update(&m_ring, f->second, &none, 1);
+    m_free_slots.push_back(f->second);
+    m_files.erase(f);
+    return 0;
+  }
+
+  virtual int register_buffers(const aio_buffer* bufs, size_t n) override
+  {
+    std::vector<iovec> iov(n);
+    for (size_t i = 0; i < n; i++)
+      iov[i] = iovec{bufs[i].m_ptr, bufs[i].m_len};
+    std::sort(iov.begin(), iov.end(), [](const iovec& a, const iovec& b)
+              { return a.iov_base < b.iov_base; });
+
+    std::lock_guard<std::mutex> lk(m_reg_mutex);
+    if (!m_buffers.empty())
+    {
+      io_uring_unregister_buffers(&m_ring);
+      m_buffers.clear();
+    }
+    /* This fails if the memory cannot be locked (RLIMIT_MEMLOCK) or
+    too many or too large buffers are passed. */
+    if (io_uring_register_buffers(&m_ring, iov.data(), unsigned(n)))
+      return -1;
+    m_buffers.swap(iov);
+    return 0;
+  }
+
+  virtual void unregister_buffers() override
+  {
+    std::lock_guard<std::mutex> lk(m_reg_mutex);
+    if (m_buffers.empty())
+      return;
+    io_uring_unregister_buffers(&m_ring);
+    m_buffers.clear();
+  }
+};
+
+aio* create_uring_aio(thread_pool* pool, int max_io)
+{
+  return aio_uring::create(pool, max_io);
+}
+
+}
@@ -26,6 +26,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02111 - 1301 USA*/
 /*
   Linux AIO implementation, based on native AIO.
   Needs libaio.h and -laio at the compile time.
+  The io_uring implementation is in aio_liburing.cc.
 
   submit_io() is used to submit async IO.
 
@@ -135,7 +136,7 @@ class aio_linux : public aio
   }
 };
 
-aio* create_linux_aio(thread_pool* pool, int max_io)
+static aio* create_libaio(thread_pool* pool, int max_io)
 {
   io_context_t ctx;
   memset(&ctx, 0, sizeof(ctx));
@@ -147,10 +148,27 @@ aio* create_linux_aio(thread_pool* pool, int max_io)
   }
   return new aio_linux(ctx, pool);
 }
-#else
-aio* create_linux_aio(thread_pool* pool, int max_aio)
+#endif
+
+#ifdef HAVE_URING
+extern aio* create_uring_aio(thread_pool* pool, int max_io);
+#endif
+
+/**
+  Create the native AIO handler.
+  With OS_IO_DEFAULT, io_uring is preferred and libaio is the fallback.
+*/
+aio* create_linux_aio(thread_pool* pool, int max_io, aio_implementation impl)
 {
+#ifdef HAVE_URING
+  if (impl != aio_implementation::OS_IO_LIBAIO)
+    if (aio* uring_aio = create_uring_aio(pool, max_io))
+      return uring_aio;
+#endif
+#ifdef LINUX_NATIVE_AIO
+  if (impl != aio_implementation::OS_IO_URING)
+    return create_libaio(pool, max_io);
+#endif
   return nullptr;
 }
-#endif
 }
@@ -149,6 +149,13 @@ struct aiocb
 };
 
 
+/** Memory range that is going to be used as an IO buffer */
+struct aio_buffer
+{
+  void *m_ptr;
+  size_t m_len;
+};
+
 /**
  AIO interface
 */
@@ -160,13 +167,33 @@ class aio
     On completion, cb->m_callback is executed.
   */
   virtual int submit_io(aiocb *cb)= 0;
-  /** "Bind" file to AIO handler (used on Windows only) */
+  /** "Bind" file to AIO handler (Windows completion port, io_uring
+  registered file table) */
   virtual int bind(native_file_handle &fd)= 0;
-  /** "Unind" file to AIO handler (used on Windows only) */
+  /** "Unbind" file from AIO handler */
   virtual int unbind(const native_file_handle &fd)= 0;
+  /**
+    Register long-lived IO buffers, replacing any earlier registration.
+    Only io_uring makes use of this.
+    @return 0 if the buffers were registered
+  */
+  virtual int register_buffers(const aio_buffer *, size_t) { return -1; }
+  /** Forget the buffers of register_buffers() */
+  virtual void unregister_buffers() {}
   virtual ~aio(){};
 };
 
+/** Native asynchronous IO interface to use */
+enum class aio_implementation
+{
+  /** io_uring if available, otherwise libaio (Linux) */
+  OS_IO_DEFAULT,
+  /** Linux io_uring */
+  OS_IO_URING,
+  /** Linux libaio */
+  OS_IO_LIBAIO
+};
+
 class timer
 {
 public:
@@ -196,7 +223,7 @@ class thread_pool
 protected:
   /* AIO handler */
   std::unique_ptr<aio> m_aio;
-  virtual aio *create_native_aio(int max_io)= 0;
+  virtual aio *create_native_aio(int max_io, aio_implementation impl)= 0;
 
   /**
     Functions to be called at worker thread start/end
@@ -216,11 +243,21 @@ class thread_pool
     m_worker_init_callback= init;
     m_worker_destroy_callback= destroy;
   }
-  int configure_aio(bool use_native_aio, int max_io)
+  /**
+    Set up asynchronous IO.
+    @param use_native_aio whether to use the native interface
+    @param max_io         maximum number of pending requests
+    @param impl           native interface to use
+    @return 0 on success
+    @retval -1 if the native interface could not be initialized;
+    the caller may retry with another impl or with use_native_aio=false
+  */
+  int configure_aio(bool use_native_aio, int max_io,
+                    aio_implementation impl= aio_implementation::OS_IO_DEFAULT)
   {
     if (use_native_aio)
-      m_aio.reset(create_native_aio(max_io));
-    if (!m_aio)
+      m_aio.reset(create_native_aio(max_io, impl));
+    else
       m_aio.reset(create_simulated_aio(this));
     return !m_aio ? -1 : 0;
   }
@@ -228,8 +265,11 @@ class thread_pool
   {
     m_aio.reset();
   }
-  int bind(native_file_handle &fd) { return m_aio->bind(fd); }
+  int bind(native_file_handle &fd) { return m_aio ? m_aio->bind(fd) : 0; }
   void unbind(const native_file_handle &fd) { if (m_aio) m_aio->unbind(fd); }
+  int register_buffers(const aio_buffer *bufs, size_t n)
+  { return m_aio ? m_aio->register_buffers(bufs, n) : -1; }
+  void unregister_buffers() { if (m_aio) m_aio->unregister_buffers(); }
   int submit_io(aiocb *cb) { return m_aio->submit_io(cb); }
   virtual void wait_begin() {};
   virtual void wait_end() {};
@@ -38,7 +38,8 @@ namespace tpool
 {
 
 #ifdef __linux__
-  extern aio* create_linux_aio(thread_pool* tp, int max_io);
+  extern aio* create_linux_aio(thread_pool* tp, int max_io,
+                               aio_implementation impl);
 #endif
 #ifdef _WIN32
   extern aio* create_win_aio(thread_pool* tp, int max_io);
@@ -263,12 +264,12 @@ class thread_pool_generic : public thread_pool
   void wait_begin() override;
   void wait_end() override;
   void submit_task(task *task) override;
-  virtual aio *create_native_aio(int max_io) override
+  virtual aio *create_native_aio(int max_io, aio_implementation impl) override
   {
 #ifdef _WIN32
     return create_win_aio(this, max_io);
 #elif defined(__linux__)
-    return create_linux_aio(this,max_io);
+    return create_linux_aio(this, max_io, impl);
 #else
     return nullptr;
 #endif
@@ -0,0 +1,87 @@
+/* Copyright (c) 2021, MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <my_rnd.h>
+#include "tap.h"
+
+#define N 20000
+
+static struct my_rnd_struct rnd;
+static uchar seen[N];
+
+/*
+  Fill keys of the given length, with only the last `varying` bytes
+  random (out of `values` possible values), and check that radixsort
+  orders them as memcmp() does.
+*/
+static my_bool test_sort(size_t size, size_t varying, uint values)
+{
+  uchar *keys= (uchar*) malloc(N * size);
+  uchar **ptrs= (uchar**) malloc(N * sizeof(uchar*));
+  uchar **buffer= (uchar**) malloc(N * sizeof(uchar*));
+  my_bool res= 1;
+  uint i;
+  size_t j;
+
+  for (i= 0; i < N; i++)
+  {
+    uchar *key= keys + i * size;
+    memset(key, 'a', size - varying);
+    for (j= size - varying; j < size; j++)
+      key[j]= (uchar) ((uint) (my_rnd(&rnd) * values) % values);
+    ptrs[i]= key;
+  }
+
+  radixsort_for_str_ptr(ptrs, N, size, buffer);
+
+  for (i= 1; i < N; i++)
+    res&= memcmp(ptrs[i - 1], ptrs[i], size) <= 0;
+
+  /* Every key must still be there exactly once */
+  memset(seen, 0, sizeof(seen));
+  for (i= 0; i < N; i++)
+  {
+    size_t pos= (size_t) (ptrs[i] - keys) / size;
+    res&= !seen[pos];
+    seen[pos]= 1;
+  }
+
+  free(buffer);
+  free(ptrs);
+  free(keys);
+  return res;
+}
+
+
+int main(int argc __attribute__((unused)), char *argv[])
+{
+  MY_INIT(argv[0]);
+  plan(7);
+
+  my_rnd_init(&rnd, 1234567, 7654321);
+
+  ok(test_sort(4, 4, 256), "LSD, random keys");
+  ok(test_sort(8, 2, 256), "LSD, constant high bytes");
+  ok(test_sort(5, 5, 3), "LSD, many duplicates");
+  ok(test_sort(20, 20, 256), "MSD, random keys");
+  ok(test_sort(20, 3, 256), "MSD, long common prefix");
+  ok(test_sort(64, 64, 2), "MSD, many duplicates");
+  ok(test_sort(128, 1, 1), "MSD, all keys equal");
+
+  my_end(0);
+  return exit_status();
+}